@@ -28,6 +28,8 @@
 #ifndef HIPSYCL_COMMON_FILESYSTEM_HPP
 #define HIPSYCL_COMMON_FILESYSTEM_HPP
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -47,6 +49,28 @@ join_path(const std::string &base,
 std::vector<std::string> list_regular_files(const std::string &directory);
 std::vector<std::string> list_regular_files(const std::string &directory,
                                             const std::string &extension);
+
+/// Read-only view of the content of a file. The file is memory-mapped
+/// where supported, and read into memory otherwise.
+class mapped_file {
+public:
+  /// \return the mapped file, or nullptr if the file could not be opened.
+  static std::shared_ptr<mapped_file> open(const std::string& filename);
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  ~mapped_file();
+
+  const char* data() const { return _data; }
+  std::size_t size() const { return _size; }
+private:
+  mapped_file() = default;
+
+  const char* _data = nullptr;
+  std::size_t _size = 0;
+  bool _is_mapped = false;
+  std::vector<char> _buffer;
+};
 }
 
 }
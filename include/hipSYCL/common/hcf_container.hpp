@@ -29,7 +29,12 @@
 #define HIPSYCL_HCF_CONTAINER_HPP
 
 #include "debug.hpp"
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -44,32 +49,94 @@ namespace hipsycl {
 namespace common {
 
 class hcf_container {
+  struct binary_tables;
 public:
-  struct node {
-    std::vector<std::pair<std::string, std::string>> key_value_pairs;
-    std::vector<node> subnodes;
+  // Nodes parsed from the binary form are bound to the binary tables and
+  // decoded one level at a time: A node decodes its key-value pairs and the
+  // names of its subnodes the first time they are accessed, and looks them
+  // up by the key hashes stored in the binary form. Decoding is thread-safe,
+  // modifying a node is not.
+  class node {
+  public:
     std::string node_id;
 
-    const node* get_subnode(const std::string& name) const {
-      for(int i = 0; i < subnodes.size(); ++i) {
-        if(subnodes[i].node_id == name)
-          return &(subnodes[i]);
+    node() = default;
+
+    node(const node& other) {
+      *this = other;
+    }
+
+    node(node&& other) noexcept {
+      *this = std::move(other);
+    }
+
+    node& operator=(const node& other) {
+      if(this != &other) {
+        node_id = other.node_id;
+        _tables = other._tables;
+        _binary_index = other._binary_index;
+        // A copy of a node that has not been decoded yet decodes itself
+        // on demand.
+        bool is_decoded = other.is_decoded();
+        if(is_decoded) {
+          _key_value_pairs = other._key_value_pairs;
+          _subnodes = other._subnodes;
+        } else {
+          _key_value_pairs.clear();
+          _subnodes.clear();
+        }
+        _is_decoded.store(is_decoded, std::memory_order_relaxed);
       }
-      return nullptr;
+      return *this;
     }
 
-    node* get_subnode(const std::string& name) {
-      for(int i = 0; i < subnodes.size(); ++i) {
-        if(subnodes[i].node_id == name)
-          return &(subnodes[i]);
+    node& operator=(node&& other) noexcept {
+      if(this != &other) {
+        bool is_decoded = other.is_decoded();
+        node_id = std::move(other.node_id);
+        _tables = std::move(other._tables);
+        _binary_index = other._binary_index;
+        _key_value_pairs = std::move(other._key_value_pairs);
+        _subnodes = std::move(other._subnodes);
+        _is_decoded.store(is_decoded, std::memory_order_relaxed);
       }
-      return nullptr;
+      return *this;
+    }
+
+    const std::vector<std::pair<std::string, std::string>> &
+    get_key_value_pairs() const {
+      ensure_decoded();
+      return _key_value_pairs;
+    }
+
+    const std::vector<node>& get_children() const {
+      ensure_decoded();
+      return _subnodes;
+    }
+
+    const node* get_subnode(const std::string& name) const {
+      std::size_t pos = find_subnode(name);
+      return pos < _subnodes.size() ? &(_subnodes[pos]) : nullptr;
+    }
+
+    node* get_subnode(const std::string& name) {
+      std::size_t pos = find_subnode(name);
+      return pos < _subnodes.size() ? &(_subnodes[pos]) : nullptr;
     }
 
     const std::string* get_value(const std::string& key) const {
-      for(int i = 0; i < key_value_pairs.size(); ++i) {
-        if(key_value_pairs[i].first == key) {
-          return &(key_value_pairs[i].second);
+      ensure_decoded();
+      if(_tables) {
+        std::size_t pos = _tables->find_entry(
+            _binary_index, key, [&](std::size_t i) {
+              return _key_value_pairs[i].first == key;
+            });
+        return pos < _key_value_pairs.size() ? &(_key_value_pairs[pos].second)
+                                             : nullptr;
+      }
+      for(int i = 0; i < _key_value_pairs.size(); ++i) {
+        if(_key_value_pairs[i].first == key) {
+          return &(_key_value_pairs[i].second);
         }
       }
       return nullptr;
@@ -85,7 +152,7 @@ public:
 
     std::vector<std::string> get_subnodes() const {
       std::vector<std::string> result;
-      for(const auto& s : subnodes) {
+      for(const auto& s : get_children()) {
         result.push_back(s.node_id);
       }
       return result;
@@ -100,22 +167,22 @@ public:
     }
 
     node* add_subnode(const std::string& unique_name) {
-      for(int i = 0; i < subnodes.size(); ++i) {
-        if(subnodes[i].node_id == unique_name) {
-          HIPSYCL_DEBUG_ERROR << "hcf: Subnode already exists with name "
-                              << unique_name << "\n";
-          return nullptr;
-        }
+      if(has_subnode(unique_name)) {
+        HIPSYCL_DEBUG_ERROR << "hcf: Subnode already exists with name "
+                            << unique_name << "\n";
+        return nullptr;
       }
+      detach_from_binary();
 
       node new_node;
       new_node.node_id = unique_name;
-      subnodes.push_back(new_node);
-      return &subnodes.back();
+      _subnodes.push_back(std::move(new_node));
+      return &_subnodes.back();
     }
 
     void set(const std::string& key, const std::string& value) {
-      key_value_pairs.push_back(std::make_pair(key, value));
+      detach_from_binary();
+      _key_value_pairs.push_back(std::make_pair(key, value));
     }
 
     // Note: This is a convenience feature. It just creates additional subnodes for list entries.
@@ -136,24 +203,84 @@ public:
         return {};
       return get_subnode(key)->get_subnodes();
     }
+
+  private:
+    friend class hcf_container;
+
+    bool is_decoded() const {
+      return !_tables || _is_decoded.load(std::memory_order_acquire);
+    }
+
+    void ensure_decoded() const {
+      if(is_decoded())
+        return;
+      std::lock_guard<std::mutex> lock{_tables->decode_mutex};
+      if(_is_decoded.load(std::memory_order_relaxed))
+        return;
+      if(!_tables->decode(_binary_index, _tables, _key_value_pairs,
+                             _subnodes)) {
+        _key_value_pairs.clear();
+        _subnodes.clear();
+      }
+      _is_decoded.store(true, std::memory_order_release);
+    }
+
+    std::size_t find_subnode(const std::string& name) const {
+      ensure_decoded();
+      if(_tables)
+        return _tables->find_subnode(_binary_index, name, [&](std::size_t i) {
+          return _subnodes[i].node_id == name;
+        });
+      for(std::size_t i = 0; i < _subnodes.size(); ++i) {
+        if(_subnodes[i].node_id == name)
+          return i;
+      }
+      return _subnodes.size();
+    }
+
+    // The binary lookup tables only describe the node as it was parsed,
+    // so it falls back to linear lookups once it is modified.
+    void detach_from_binary() {
+      ensure_decoded();
+      _tables.reset();
+    }
+
+    mutable std::vector<std::pair<std::string, std::string>> _key_value_pairs;
+    mutable std::vector<node> _subnodes;
+    std::shared_ptr<const binary_tables> _tables;
+    std::uint64_t _binary_index = 0;
+    mutable std::atomic<bool> _is_decoded{false};
   };
 
   hcf_container() {
     _root_node.node_id = "root";
   }
 
+  // Parses HCF data in either the text or the binary format. Binary
+  // attachments are copied into the container.
   hcf_container(const std::string& container) {
-    std::string appendix_id {_binary_appendix_id};
-
-    std::size_t appendix_begin = container.find(appendix_id);
-    if(appendix_begin != std::string::npos) {
-      _binary_appendix = container.substr(appendix_begin + appendix_id.length());
+    if(!parse_any(container.data(), container.size(), true))
+      return;
+    if(_external_appendix) {
+      _binary_appendix.assign(_external_appendix, _external_appendix_size);
+      _external_appendix = nullptr;
+      _external_appendix_size = 0;
     }
+  }
 
-    std::string parseable_data = container;
-    parseable_data.erase(appendix_begin);
+  // Parses HCF data in either the text or the binary format. Only the node
+  // tree is copied; binary attachments are referenced in place, so the data
+  // must outlive the container and all its copies - e.g. because it is
+  // embedded in the binary, or because keep_alive owns a file mapping.
+  hcf_container(const char *data, std::size_t size,
+                std::shared_ptr<const void> keep_alive = nullptr)
+      : _keep_alive{std::move(keep_alive)} {
+    parse_any(data, size, false);
+  }
 
-    parse(parseable_data);
+  static bool is_binary_format(const char* data, std::size_t size) {
+    return size >= sizeof(_binary_magic) &&
+           std::memcmp(data, _binary_magic, sizeof(_binary_magic)) == 0;
   }
 
   const node* root_node() const {
@@ -165,6 +292,20 @@ public:
   }
 
   bool get_binary_attachment(const node* n, std::string& out) const {
+    const char* data = nullptr;
+    std::size_t size = 0;
+    if(!get_binary_attachment(n, data, size))
+      return false;
+
+    out.assign(data, size);
+    return true;
+  }
+
+  // Like get_binary_attachment() above, but does not copy the attachment.
+  // The returned pointer remains valid as long as the container (or the
+  // data it references) is alive and no further content is attached.
+  bool get_binary_attachment(const node *n, const char *&data_out,
+                             std::size_t &size_out) const {
     std::size_t start = 0;
     std::size_t size = 0;
 
@@ -200,12 +341,13 @@ public:
     start = std::stoull(*start_entry);
     size = std::stoull(*size_entry);
 
-    if(start + size > _binary_appendix.size()) {
+    if(start > get_appendix_size() || size > get_appendix_size() - start) {
       HIPSYCL_DEBUG_ERROR << "hcf: Binary content address is out-of-bounds\n";
       return false;
     }
 
-    out = _binary_appendix.substr(start, size);
+    data_out = get_appendix_data() + start;
+    size_out = size;
 
     return true;
   }
@@ -216,6 +358,14 @@ public:
     if(!binary_node)
       return false;
 
+    if(_external_appendix) {
+      // Appending requires owning the data
+      _binary_appendix.assign(_external_appendix, _external_appendix_size);
+      _external_appendix = nullptr;
+      _external_appendix_size = 0;
+      _keep_alive.reset();
+    }
+
     std::size_t start = _binary_appendix.size();
     std::size_t length = binary_content.size();
 
@@ -227,20 +377,381 @@ public:
     return true;
   }
 
+  // Serializes into the text format
   std::string serialize() const {
     std::stringstream sstr;
     serialize_node(_root_node, sstr);
     sstr << _binary_appendix_id;
 
-    return sstr.str() + _binary_appendix;
+    return sstr.str() + std::string{get_appendix_data(), get_appendix_size()};
+  }
+
+  // Serializes into the binary format. All integers are stored as
+  // 64-bit little endian values:
+  //
+  // header:   magic[8] version num-nodes num-entries string-table-size
+  //           appendix-offset appendix-size
+  // nodes:    num-nodes x (name-offset name-size first-entry num-entries
+  //                        first-child num-children first-lookup)
+  // entries:  num-entries x (key-offset key-size value-offset value-size)
+  // lookups:  (num-nodes - 1 + num-entries) x (key-hash position)
+  // strings:  string-table-size bytes
+  // appendix: appendix-size bytes, starting at appendix-offset which is
+  //           aligned to binary_appendix_alignment.
+  //
+  // Node 0 is the root node, and the children of each node are stored
+  // contiguously in breadth-first order, so that the node table can be
+  // decoded without any text processing. Starting at first-lookup, each
+  // node has one lookup record per child and then one per entry, each
+  // sorted by the hash of the child name or entry key.
+  std::string serialize_binary() const {
+    std::vector<const node*> nodes {&_root_node};
+    std::vector<std::uint64_t> first_child(1, 0);
+    for(std::size_t i = 0; i < nodes.size(); ++i) {
+      first_child[i] = nodes.size();
+      for(const auto& s : nodes[i]->get_children()) {
+        nodes.push_back(&s);
+        first_child.push_back(0);
+      }
+    }
+
+    std::string strings;
+    std::string node_table;
+    std::string entry_table;
+    std::string lookup_table;
+    std::uint64_t num_entries = 0;
+    std::uint64_t num_lookups = 0;
+    auto add_string = [&](const std::string& str, std::string& table) {
+      write_u64(table, strings.size());
+      write_u64(table, str.size());
+      strings += str;
+    };
+    // Equal hashes keep their original order, so that lookups
+    // find the first of several entries with the same key.
+    auto add_lookups = [&](const std::vector<std::uint64_t>& hashes) {
+      std::vector<std::uint64_t> order(hashes.size());
+      for(std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+      std::stable_sort(order.begin(), order.end(),
+                       [&](std::uint64_t a, std::uint64_t b) {
+                         return hashes[a] < hashes[b];
+                       });
+      for(std::uint64_t pos : order) {
+        write_u64(lookup_table, hashes[pos]);
+        write_u64(lookup_table, pos);
+      }
+      num_lookups += hashes.size();
+    };
+
+    for(std::size_t i = 0; i < nodes.size(); ++i) {
+      const node* n = nodes[i];
+      const auto& key_value_pairs = n->get_key_value_pairs();
+      const auto& subnodes = n->get_children();
+      add_string(n->node_id, node_table);
+      write_u64(node_table, num_entries);
+      write_u64(node_table, key_value_pairs.size());
+      write_u64(node_table, first_child[i]);
+      write_u64(node_table, subnodes.size());
+      write_u64(node_table, num_lookups);
+
+      std::vector<std::uint64_t> hashes;
+      for(const auto& s : subnodes)
+        hashes.push_back(hash_key(s.node_id));
+      add_lookups(hashes);
+
+      hashes.clear();
+      for(const auto& kv : key_value_pairs) {
+        add_string(kv.first, entry_table);
+        add_string(kv.second, entry_table);
+        hashes.push_back(hash_key(kv.first));
+        ++num_entries;
+      }
+      add_lookups(hashes);
+    }
+
+    std::uint64_t header_size = sizeof(_binary_magic) + 6 * sizeof(std::uint64_t);
+    std::uint64_t appendix_offset = header_size + node_table.size() +
+                                    entry_table.size() + lookup_table.size() +
+                                    strings.size();
+    appendix_offset = (appendix_offset + binary_appendix_alignment - 1) /
+                      binary_appendix_alignment * binary_appendix_alignment;
+
+    std::string result{_binary_magic, sizeof(_binary_magic)};
+    write_u64(result, _binary_version);
+    write_u64(result, nodes.size());
+    write_u64(result, num_entries);
+    write_u64(result, strings.size());
+    write_u64(result, appendix_offset);
+    write_u64(result, get_appendix_size());
+    result += node_table;
+    result += entry_table;
+    result += lookup_table;
+    result += strings;
+    result.resize(appendix_offset, '\0');
+    result.append(get_appendix_data(), get_appendix_size());
+    return result;
   }
+
+  static constexpr std::size_t binary_appendix_alignment = 64;
 private:
+  static constexpr std::uint64_t node_record_size = 7 * sizeof(std::uint64_t);
+  static constexpr std::uint64_t entry_record_size = 4 * sizeof(std::uint64_t);
+  static constexpr std::uint64_t lookup_record_size = 2 * sizeof(std::uint64_t);
+
+  // The tables of a parsed binary HCF, shared by all nodes bound to them.
+  // The tables are validated when they are parsed, except for the strings
+  // which are checked when a node is decoded.
+  struct binary_tables {
+    // Only used if the tables are copied out of the parsed data
+    std::string owned_data;
+    std::shared_ptr<const void> keep_alive;
+    const char* nodes = nullptr;
+    const char* entries = nullptr;
+    const char* lookups = nullptr;
+    const char* strings = nullptr;
+    std::uint64_t strings_size = 0;
+    mutable std::mutex decode_mutex;
+
+    bool get_string(const char* record, std::string& out) const {
+      std::uint64_t offset = read_u64(record);
+      std::uint64_t length = read_u64(record + 8);
+      if(offset > strings_size || length > strings_size - offset)
+        return false;
+      out.assign(strings + offset, length);
+      return true;
+    }
+
+    // Decodes the key-value pairs and the (not yet decoded) subnodes
+    // of node idx, which are bound to self.
+    bool decode(std::uint64_t idx,
+                const std::shared_ptr<const binary_tables> &self,
+                std::vector<std::pair<std::string, std::string>> &kv_out,
+                std::vector<node> &subnodes_out) const {
+      const char* record = nodes + idx * node_record_size;
+      std::uint64_t first_entry = read_u64(record + 16);
+      std::uint64_t entry_count = read_u64(record + 24);
+      std::uint64_t first_child = read_u64(record + 32);
+      std::uint64_t child_count = read_u64(record + 40);
+
+      kv_out.resize(entry_count);
+      for(std::uint64_t i = 0; i < entry_count; ++i) {
+        const char* entry = entries + (first_entry + i) * entry_record_size;
+        if(!get_string(entry, kv_out[i].first) ||
+           !get_string(entry + 16, kv_out[i].second)) {
+          HIPSYCL_DEBUG_ERROR << "hcf: Binary HCF string is out-of-bounds\n";
+          return false;
+        }
+      }
+      subnodes_out.resize(child_count);
+      for(std::uint64_t i = 0; i < child_count; ++i) {
+        node& child = subnodes_out[i];
+        if(!get_string(nodes + (first_child + i) * node_record_size,
+                       child.node_id)) {
+          HIPSYCL_DEBUG_ERROR << "hcf: Binary HCF string is out-of-bounds\n";
+          return false;
+        }
+        child._tables = self;
+        child._binary_index = first_child + i;
+      }
+      return true;
+    }
+
+    template<class Matcher>
+    std::size_t find_subnode(std::uint64_t idx, const std::string &name,
+                             Matcher &&matches) const {
+      const char* record = nodes + idx * node_record_size;
+      return find(read_u64(record + 48), read_u64(record + 40), name, matches);
+    }
+
+    template<class Matcher>
+    std::size_t find_entry(std::uint64_t idx, const std::string &key,
+                           Matcher &&matches) const {
+      const char* record = nodes + idx * node_record_size;
+      return find(read_u64(record + 48) + read_u64(record + 40),
+                  read_u64(record + 24), key, matches);
+    }
+
+    // Returns the smallest position among the count lookup records
+    // starting at first whose hash matches and for which matches()
+    // confirms the name, or count if there is none.
+    template<class Matcher>
+    std::size_t find(std::uint64_t first, std::uint64_t count,
+                     const std::string &name, Matcher &&matches) const {
+      std::uint64_t hash = hash_key(name);
+      std::uint64_t begin = first;
+      std::uint64_t end = first + count;
+      while(begin < end) {
+        std::uint64_t mid = begin + (end - begin) / 2;
+        if(read_u64(lookups + mid * lookup_record_size) < hash)
+          begin = mid + 1;
+        else
+          end = mid;
+      }
+      for(std::uint64_t i = begin; i < first + count; ++i) {
+        const char* lookup = lookups + i * lookup_record_size;
+        if(read_u64(lookup) != hash)
+          break;
+        std::uint64_t pos = read_u64(lookup + 8);
+        if(pos < count && matches(pos))
+          return pos;
+      }
+      return count;
+    }
+  };
+
+  // FNV-1a
+  static std::uint64_t hash_key(const std::string& key) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for(char c : key) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  const char* get_appendix_data() const {
+    return _external_appendix ? _external_appendix : _binary_appendix.data();
+  }
+
+  std::size_t get_appendix_size() const {
+    return _external_appendix ? _external_appendix_size
+                              : _binary_appendix.size();
+  }
+
+  static void write_u64(std::string& out, std::uint64_t value) {
+    for(int i = 0; i < 8; ++i)
+      out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+
+  static std::uint64_t read_u64(const char* data) {
+    std::uint64_t result = 0;
+    for(int i = 0; i < 8; ++i)
+      result |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[i]))
+                << (8 * i);
+    return result;
+  }
+
+  bool parse_any(const char* data, std::size_t size, bool copy_tables) {
+    _root_node.node_id = "root";
+    if(is_binary_format(data, size))
+      return parse_binary(data, size, copy_tables);
+
+    std::string appendix_id {_binary_appendix_id};
+    const char* appendix_begin = std::search(
+        data, data + size, appendix_id.begin(), appendix_id.end());
+
+    if(appendix_begin != data + size) {
+      _external_appendix = appendix_begin + appendix_id.length();
+      _external_appendix_size = (data + size) - _external_appendix;
+    }
+
+    return parse(std::string{data, appendix_begin});
+  }
+
+  bool parse_binary(const char* data, std::size_t size, bool copy_tables) {
+    const std::size_t header_size =
+        sizeof(_binary_magic) + 6 * sizeof(std::uint64_t);
+    if(size < header_size) {
+      HIPSYCL_DEBUG_ERROR << "hcf: Binary HCF is truncated\n";
+      return false;
+    }
+    const char* header = data + sizeof(_binary_magic);
+    std::uint64_t version = read_u64(header);
+    std::uint64_t num_nodes = read_u64(header + 8);
+    std::uint64_t num_entries = read_u64(header + 16);
+    std::uint64_t strings_size = read_u64(header + 24);
+    std::uint64_t appendix_offset = read_u64(header + 32);
+    std::uint64_t appendix_size = read_u64(header + 40);
+
+    if(version != _binary_version) {
+      HIPSYCL_DEBUG_ERROR << "hcf: Unsupported binary HCF version " << version
+                          << "\n";
+      return false;
+    }
+
+    // Guard against overflow in the size computations below
+    if(num_nodes == 0 || num_nodes > size || num_entries > size ||
+       strings_size > size || appendix_offset > size ||
+       appendix_size > size - appendix_offset) {
+      HIPSYCL_DEBUG_ERROR << "hcf: Binary HCF header is corrupted\n";
+      return false;
+    }
+    // The tables must fit between the header and the appendix. Check this
+    // on sizes before forming any pointers into the tables. The counts are
+    // bounded by size above, so the products cannot overflow for any data
+    // that fits into memory.
+    const std::uint64_t num_lookups = num_nodes - 1 + num_entries;
+    const std::uint64_t nodes_size = num_nodes * node_record_size;
+    const std::uint64_t entries_size = num_entries * entry_record_size;
+    const std::uint64_t lookups_size = num_lookups * lookup_record_size;
+    if(appendix_offset < header_size ||
+       nodes_size > appendix_offset - header_size ||
+       entries_size > appendix_offset - header_size - nodes_size ||
+       lookups_size >
+           appendix_offset - header_size - nodes_size - entries_size ||
+       strings_size > appendix_offset - header_size - nodes_size -
+                          entries_size - lookups_size) {
+      HIPSYCL_DEBUG_ERROR << "hcf: Binary HCF tables are out-of-bounds\n";
+      return false;
+    }
+
+    auto tables = std::make_shared<binary_tables>();
+    const char* table_data = data;
+    if(copy_tables) {
+      tables->owned_data.assign(data, appendix_offset);
+      table_data = tables->owned_data.data();
+    } else {
+      tables->keep_alive = _keep_alive;
+    }
+    tables->nodes = table_data + header_size;
+    tables->entries = tables->nodes + nodes_size;
+    tables->lookups = tables->entries + entries_size;
+    tables->strings = tables->lookups + lookups_size;
+    tables->strings_size = strings_size;
+
+    // Check the tree structure up front, so that decoding nodes on demand
+    // only needs to check strings. This only reads the node table: The
+    // children of the nodes must partition the node table in order, with
+    // each node stored after its parent, and the same applies to the
+    // lookup records.
+    std::uint64_t next_child = 1;
+    std::uint64_t next_lookup = 0;
+    for(std::uint64_t idx = 0; idx < num_nodes; ++idx) {
+      const char* record = tables->nodes + idx * node_record_size;
+      std::uint64_t first_entry = read_u64(record + 16);
+      std::uint64_t entry_count = read_u64(record + 24);
+      std::uint64_t first_child = read_u64(record + 32);
+      std::uint64_t child_count = read_u64(record + 40);
+      std::uint64_t first_lookup = read_u64(record + 48);
+      if(first_entry > num_entries || entry_count > num_entries - first_entry ||
+         first_child != next_child || child_count > num_nodes - next_child ||
+         (child_count > 0 && first_child <= idx) ||
+         first_lookup != next_lookup ||
+         entry_count > num_lookups - next_lookup ||
+         child_count > num_lookups - next_lookup - entry_count) {
+        HIPSYCL_DEBUG_ERROR << "hcf: Binary HCF node table is corrupted\n";
+        return false;
+      }
+      next_child += child_count;
+      next_lookup += child_count + entry_count;
+    }
+    if(next_child != num_nodes || next_lookup != num_lookups) {
+      HIPSYCL_DEBUG_ERROR << "hcf: Binary HCF node table is corrupted\n";
+      return false;
+    }
+
+    _root_node._tables = std::move(tables);
+    _root_node._binary_index = 0;
+    _external_appendix = data + appendix_offset;
+    _external_appendix_size = appendix_size;
+    return true;
+  }
 
   void serialize_node(const node& n, std::ostream& out) const {
-    for(const auto& p : n.key_value_pairs){
+    for(const auto& p : n.get_key_value_pairs()){
       out << p.first << "=" << p.second << "\n";
     }
-    for(const auto& s : n.subnodes) {
+    for(const auto& s : n.get_children()) {
       out << _node_start_id << s.node_id << "\n";
       serialize_node(s, out);
       out << _node_end_id  << s.node_id << "\n";
@@ -321,13 +832,13 @@ private:
         if(!parse_node_interior(lines, i+1, i+num_node_lines, new_node))
           return false;
 
-        current_node.subnodes.push_back(new_node);
+        current_node._subnodes.push_back(std::move(new_node));
         i += num_node_lines;
       } else if(current.find("=") != std::string::npos) {
         std::size_t pos = current.find("=");
         std::string key = current.substr(0, pos);
         std::string value = current.substr(pos+1);
-        current_node.key_value_pairs.push_back(std::make_pair(key, value));
+        current_node._key_value_pairs.push_back(std::make_pair(key, value));
       } else if(current.find(_node_end_id) == 0) {
         HIPSYCL_DEBUG_ERROR << "hcf: Syntax error: Unexpected node end: " << current
                           << "\n";
@@ -365,9 +876,16 @@ private:
   static constexpr char _node_start_id [] = "{.";
   static constexpr char _node_end_id [] = "}.";
   static constexpr char _binary_marker [] = "__binary";
+  static constexpr char _binary_magic [8] = {'\x7f', 'H', 'C', 'F',
+                                             'B', 'I', 'N', '\0'};
+  static constexpr std::uint64_t _binary_version = 2;
 
   node _root_node;
+  // Owned binary appendix; only used if _external_appendix is null.
   std::string _binary_appendix;
+  const char* _external_appendix = nullptr;
+  std::size_t _external_appendix_size = 0;
+  std::shared_ptr<const void> _keep_alive;
 };
 
 }
@@ -0,0 +1,128 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_STABLE_FAST_HASH_HPP
+#define HIPSYCL_STABLE_FAST_HASH_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace hipsycl {
+namespace common {
+
+// 128-bit hash built on 64x64->128 bit multiplications, processing
+// 16 bytes per step. Results do not depend on the platform, so they can be
+// used for persistent keys.
+// Unlike stable_running_hash, each invocation of operator() is treated as a
+// separate message: h(a); h(b) is not the same as hashing the concatenation
+// of a and b.
+class stable_fast_hash {
+  static constexpr uint64_t k0 = 0xa0761d6478bd642fULL;
+  static constexpr uint64_t k1 = 0xe7037ed1a0b428dbULL;
+  static constexpr uint64_t k2 = 0x8ebc6af09c88c6e3ULL;
+  static constexpr uint64_t k3 = 0x589965cc75374cc3ULL;
+
+  uint64_t _s0;
+  uint64_t _s1;
+
+  // Multiplies a and b and folds the upper half of the product into the
+  // lower one.
+  static uint64_t mum(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+    uint64_t a_lo = a & 0xffffffffULL, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xffffffffULL, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + lo_hi;
+    uint64_t upper = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    uint64_t lower = (cross << 32) | (lo_lo & 0xffffffffULL);
+    return lower ^ upper;
+#endif
+  }
+
+  static uint64_t read64(const unsigned char *p) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+#else
+    uint64_t v = 0;
+    for(int i = 0; i < 8; ++i)
+      v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return v;
+#endif
+  }
+
+  void mix_block(uint64_t a, uint64_t b) {
+    uint64_t m0 = mum(a ^ _s0, b ^ k0);
+    uint64_t m1 = mum(b ^ _s1, a ^ k1);
+    _s0 = m0 ^ (_s1 + k2);
+    _s1 = m1 ^ (_s0 + k3);
+  }
+
+public:
+  using hash_type = std::array<uint64_t, 2>;
+
+  stable_fast_hash() : _s0{k0}, _s1{k1} {}
+
+  void operator()(const void *data, std::size_t size) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    // Mixing in the size separates consecutive messages
+    mix_block(size, ~static_cast<uint64_t>(size));
+
+    for(; size >= 16; size -= 16, p += 16)
+      mix_block(read64(p), read64(p + 8));
+
+    if(size > 0) {
+      unsigned char tail[16] = {};
+      std::memcpy(tail, p, size);
+      mix_block(read64(tail), read64(tail + 8));
+    }
+  }
+
+  void operator()(uint64_t value) {
+    mix_block(value, k2);
+  }
+
+  hash_type get_current_hash() const {
+    uint64_t h0 = mum(_s0 ^ k2, _s1 ^ k3);
+    uint64_t h1 = mum(_s1 ^ k0, h0 ^ k1);
+    return hash_type{h0, h1};
+  }
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_BARRIER_FREE_KERNEL_MARKER_PASS_HPP
+#define HIPSYCL_BARRIER_FREE_KERNEL_MARKER_PASS_HPP
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Pass.h"
+
+namespace hipsycl {
+namespace compiler {
+
+// Resolves the barrier-free queries that omp_kernel_launcher emits for
+// nd_range kernels when fibers are used (i.e. without accelerated CPU support):
+// Functions annotated with hipsycl_barrier_free_nd_kernel_query contain a
+// (guarded) invocation of the kernel. If the call graph reachable from there
+// contains no barrier (and thus no group collective), the query is replaced
+// with a constant true, otherwise with a constant false.
+struct BarrierFreeKernelMarkerPassLegacy : public llvm::ModulePass {
+  static char ID;
+
+  BarrierFreeKernelMarkerPassLegacy() : llvm::ModulePass(ID) {}
+
+  llvm::StringRef getPassName() const override {
+    return "hipSYCL barrier-free nd_range kernel marker pass";
+  }
+
+  bool runOnModule(llvm::Module &M) override;
+};
+
+#if !defined(_WIN32) && LLVM_VERSION_MAJOR >= 11
+class BarrierFreeKernelMarkerPass
+    : public llvm::PassInfoMixin<BarrierFreeKernelMarkerPass> {
+public:
+  explicit BarrierFreeKernelMarkerPass() {}
+
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &AM);
+  static bool isRequired() { return true; }
+};
+#endif // !_WIN32 && LLVM_VERSION_MAJOR >= 11
+
+} // namespace compiler
+} // namespace hipsycl
+
+#endif
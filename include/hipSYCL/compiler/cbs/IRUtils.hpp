@@ -55,6 +55,13 @@ static constexpr const char LocalIdGlobalNameZ[] = "__hipsycl_local_id_z";
 static const std::array<const char *, 3> LocalIdGlobalNames{LocalIdGlobalNameX, LocalIdGlobalNameY,
                                                             LocalIdGlobalNameZ};
 
+// Function attributes that identify nd-range kernels that were not produced by the
+// clang plugin (e.g. kernels generated by the SSCP host backend) and thus carry no
+// string annotations or mangled iterate_nd_range_omp names.
+static constexpr const char NDKernelAttribute[] = "hipsycl-nd-kernel";
+static constexpr const char NDKernelDimAttribute[] = "hipsycl-nd-kernel-dim";
+static constexpr const char NDKernelLocalSizeArgAttribute[] = "hipsycl-nd-kernel-local-size-arg";
+
 class SplitterAnnotationInfo;
 
 namespace utils {
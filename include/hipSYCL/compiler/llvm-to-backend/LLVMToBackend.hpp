@@ -106,6 +106,26 @@ public:
     return Errors;
   }
 
+  const std::vector<std::string>& getOutliningEntrypoints() const {
+    return OutliningEntrypoints;
+  }
+
+  // Returns all build flags, options and tool arguments that were
+  // set so far in textual form, followed by the target properties that
+  // the backend selected by default. Together with getCompilerIdentifier(),
+  // this describes everything that influences the translation apart from the
+  // input IR and S2 IR constants, e.g. for use as key in JIT caches.
+  std::vector<std::string> getBuildConfiguration() const {
+    std::vector<std::string> Result = BuildConfiguration;
+    for(const auto& T : getTargetConfiguration())
+      Result.push_back("target:" + T);
+    return Result;
+  }
+
+  // Identifies the compiler (hipSYCL and LLVM version) that was used to
+  // build the LLVMToBackend infrastructure.
+  static std::string getCompilerIdentifier();
+
   // Returns IR that caused the error in case an error occurs
   const std::string& getFailedIR() const {
     return ErroringCode;
@@ -174,6 +194,9 @@ protected:
                                        const std::vector<std::string> &Args) {
     return false;
   }
+  // Target properties that the generated code depends on, but that are
+  // not necessarily set by build options, e.g. the detected host CPU.
+  virtual std::vector<std::string> getTargetConfiguration() const { return {}; }
 
   // Link against bitcode contained in file or string. If ForcedTriple/ForcedDataLayout are non-empty,
   // sets triple and data layout in contained bitcode to the provided values.
@@ -205,6 +228,7 @@ private:
   int S2IRConstantBackendId;
   std::vector<std::string> OutliningEntrypoints;
   std::vector<std::string> Errors;
+  std::vector<std::string> BuildConfiguration;
   std::unordered_map<std::string, std::function<void(llvm::Module &)>> S2IRConstantApplicators;
   ExternalSymbolResolver SymbolResolver;
   bool HasExternalSymbolResolver = false;
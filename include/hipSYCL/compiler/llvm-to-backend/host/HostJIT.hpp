@@ -0,0 +1,64 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_LLVM_TO_HOST_JIT_HPP
+#define HIPSYCL_LLVM_TO_HOST_JIT_HPP
+
+#include <memory>
+#include <string>
+
+namespace hipsycl {
+namespace compiler {
+namespace host {
+
+/// Loads native object files produced by LLVMToHost into the current process
+/// using ORC. Unresolved symbols (e.g. libm functions) are looked up in
+/// the process. Symbols remain valid until the HostJITModule is destroyed.
+class HostJITModule {
+public:
+  ~HostJITModule();
+
+  /// \return nullptr on failure, in which case \c ErrorOut is set.
+  static std::unique_ptr<HostJITModule> load(const std::string &ObjectFile,
+                                             std::string &ErrorOut);
+
+  /// \return nullptr if the symbol could not be found, in which
+  /// case \c ErrorOut is set.
+  void *getSymbol(const std::string &Name, std::string &ErrorOut) const;
+
+private:
+  struct Impl;
+  HostJITModule(std::unique_ptr<Impl> I);
+
+  std::unique_ptr<Impl> JITImpl;
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_LLVM_TO_HOST_KERNEL_ABI_HPP
+#define HIPSYCL_LLVM_TO_HOST_KERNEL_ABI_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace hipsycl {
+namespace compiler {
+namespace host {
+
+// For each kernel, LLVMToHost emits an entrypoint which executes one work group.
+// All work items of the group are executed by the calling thread in loops
+// formed by the CBS pipeline.
+//
+// * Args points to an array of pointers to the kernel arguments
+//   (the same convention as cuLaunchKernel).
+// * LocalSize, GroupId and NumGroups point to arrays of three elements
+//   each. The dimension with index 2 is the fastest moving one, i.e. the
+//   order matches SYCL ids and is flipped compared to SSCP x/y/z.
+// * LocalMemory points to a buffer of at least
+//   getLocalMemSizeSymbolName() + dynamic local memory bytes, aligned to
+//   LocalMemoryAlignment. It must not be shared between concurrently
+//   executing groups.
+using KernelEntrypoint = void (*)(void **Args, const std::size_t *LocalSize,
+                                  const std::size_t *GroupId,
+                                  const std::size_t *NumGroups,
+                                  void *LocalMemory);
+
+constexpr std::size_t LocalMemoryAlignment = 64;
+
+inline std::string getEntrypointName(const std::string &KernelName) {
+  return "__hipsycl_sscp_host_entry_" + KernelName;
+}
+
+// Name of a global std::size_t holding the amount of statically allocated
+// local memory that precedes the dynamic local memory in the LocalMemory buffer.
+inline std::string getLocalMemSizeSymbolName(const std::string &KernelName) {
+  return "__hipsycl_sscp_host_local_mem_size_" + KernelName;
+}
+
+}
+}
+}
+
+#endif
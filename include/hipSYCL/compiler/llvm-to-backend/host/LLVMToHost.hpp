@@ -0,0 +1,77 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_LLVM_TO_HOST_HPP
+#define HIPSYCL_LLVM_TO_HOST_HPP
+
+
+#include "../LLVMToBackend.hpp"
+
+#include <memory>
+#include <vector>
+#include <string>
+
+namespace llvm {
+class TargetMachine;
+}
+
+namespace hipsycl {
+namespace compiler {
+
+class LLVMToHostTranslator : public LLVMToBackendTranslator{
+public:
+  LLVMToHostTranslator(const std::vector<std::string>& KernelNames);
+
+  virtual ~LLVMToHostTranslator();
+
+  virtual bool prepareBackendFlavor(llvm::Module& M) override {return true;}
+  virtual bool toBackendFlavor(llvm::Module &M, PassHandler& PH) override;
+  virtual bool translateToBackendFormat(llvm::Module &FlavoredModule, std::string &out) override;
+  virtual bool optimizeFlavoredIR(llvm::Module& M, PassHandler& PH) override;
+protected:
+  virtual bool applyBuildOption(const std::string &Option, const std::string &Value) override;
+  virtual std::vector<std::string> getTargetConfiguration() const override;
+  virtual bool isKernelAfterFlavoring(llvm::Function& F) override;
+  virtual AddressSpaceMap getAddressSpaceMap() const override;
+private:
+  bool initializeTargetMachine();
+  // Returns the CPU and features that code is generated for
+  void getEffectiveTarget(std::string &CPU, std::string &Features) const;
+  bool createEntrypoint(llvm::Module& M, llvm::Function& Kernel);
+  bool lowerGroupGeometry(llvm::Module& M, llvm::Function& Entrypoint);
+  bool lowerLocalMemory(llvm::Module& M);
+
+  std::vector<std::string> KernelNames;
+  std::vector<std::string> EntrypointNames;
+  std::unique_ptr<llvm::TargetMachine> TM;
+  std::string TargetCPU;
+};
+
+}
+}
+
+#endif
@@ -33,9 +33,12 @@
 #include "hipSYCL/sycl/libkernel/backend.hpp"
 #include "hipSYCL/sycl/libkernel/host/host_backend.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <chrono>
 #include <cstdint>
@@ -45,13 +48,39 @@ namespace hipsycl {
 namespace glue {
 namespace detail {
 
-template<class T>
-inline T random_number() {
-  thread_local std::random_device rd;
-  thread_local std::mt19937 gen{rd()};
-  thread_local std::uniform_int_distribution<T> distribution{0};
+// Random per-process salt that makes ids hard to confuse with other data
+// when scanning kernel blobs for embedded pointers. If multiple copies
+// of this function exist (e.g. across shared libraries without symbol
+// interposition), each has its own salt and counter, so ids remain unique.
+inline uint64_t get_unique_id_salt() {
+  static const uint64_t salt = []() {
+    std::random_device rd;
+    uint64_t time_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now().time_since_epoch())
+            .count();
+    uint64_t result = ((static_cast<uint64_t>(rd()) << 32) | rd()) ^ time_ns;
+    // Ids with all components zero denote unbound ids
+    return result == 0 ? 1 : result;
+  }();
+  return salt;
+}
+
+constexpr uint64_t unique_id_counter_block_size = 1024;
+
+// Returns a process-wide unique counter value. Threads reserve blocks
+// of values, so the shared counter is only touched rarely.
+inline uint64_t get_unique_id_counter() {
+  static std::atomic<uint64_t> next_block{0};
 
-  return distribution(gen);
+  thread_local uint64_t next = 0;
+  thread_local uint64_t block_end = 0;
+  if(next == block_end) {
+    next = next_block.fetch_add(unique_id_counter_block_size,
+                                std::memory_order_relaxed);
+    block_end = next + unique_id_counter_block_size;
+  }
+  return next++;
 }
 
 }
@@ -69,21 +98,8 @@ struct unique_id {
   HIPSYCL_UNIVERSAL_TARGET
   unique_id() {
     __hipsycl_if_target_host(
-      uint64_t ns =
-          std::chrono::duration_cast<std::chrono::nanoseconds>(
-              std::chrono::high_resolution_clock::now().time_since_epoch())
-              .count();
-
-      uint64_t random_number = detail::random_number<uint64_t>();
-
-      char* ns_bytes = reinterpret_cast<char*>(&ns);
-      char* rnd_bytes = reinterpret_cast<char*>(&random_number);
-
-      for(int i = 0; i < sizeof(uint64_t); ++i) {
-        char *id_bytes = reinterpret_cast<char*>(&id[0]);
-        id_bytes[2 * i    ] = ns_bytes[i];
-        id_bytes[2 * i + 1] = rnd_bytes[i];
-      }
+      id[0] = detail::get_unique_id_salt();
+      id[1] = detail::get_unique_id_counter();
     );
   }
 
@@ -165,6 +181,44 @@ private:
   void* _ptrs [2];
 };
 
+// Offsets at which embedded pointers have been found within a kernel
+// blob type. Embedded pointers are members of the accessors captured by
+// a kernel, so they are located at the same offsets in every instance
+// of the type. This allows patching them without scanning the blob
+// once a kernel has been launched.
+class embedded_pointer_offset_table {
+public:
+  using offset_list = std::vector<std::size_t>;
+
+  std::shared_ptr<const offset_list> get() const {
+    return std::atomic_load_explicit(&_offsets, std::memory_order_acquire);
+  }
+
+  void add(const offset_list& new_offsets) {
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    auto offsets = std::make_shared<offset_list>();
+    if(auto current = get())
+      *offsets = *current;
+    for(std::size_t offset : new_offsets) {
+      if(std::find(offsets->begin(), offsets->end(), offset) == offsets->end())
+        offsets->push_back(offset);
+    }
+    std::atomic_store_explicit(
+        &_offsets, std::shared_ptr<const offset_list>{std::move(offsets)},
+        std::memory_order_release);
+  }
+
+  template<class Blob>
+  static embedded_pointer_offset_table& get_table() {
+    static embedded_pointer_offset_table table;
+    return table;
+  }
+private:
+  std::mutex _mutex;
+  std::shared_ptr<const offset_list> _offsets;
+};
+
 struct kernel_blob {
   template <class Blob>
   static bool initialize_embedded_pointer(Blob &b, const unique_id &pointer_id,
@@ -173,11 +227,29 @@ struct kernel_blob {
     char* blob_ptr = reinterpret_cast<char*>(&b);
     bool found = false;
 
+    embedded_pointer_offset_table &table =
+        embedded_pointer_offset_table::get_table<Blob>();
+
+    if(auto known_offsets = table.get()) {
+      for(std::size_t offset : *known_offsets) {
+        char* chunk_ptr = blob_ptr + offset;
+        if(std::memcmp(chunk_ptr, &pointer_id, sizeof(unique_id)) == 0) {
+          set_embedded_pointer(chunk_ptr, ptr);
+          found = true;
+        }
+      }
+    }
+    if(found)
+      return true;
+
+    // Pointer has not been seen at any known offset, e.g. because
+    // this is the first launch of the kernel - we need to scan the blob.
+    embedded_pointer_offset_table::offset_list new_offsets;
     // TODO: We could try to optimize this by only
     // looking at offsets that are properly aligned
     // if we are sure there are no cases where this
     // might go wrong
-    for(int i = 0; i + sizeof(unique_id) <= sizeof(Blob);) {
+    for(std::size_t i = 0; i + sizeof(unique_id) <= sizeof(Blob);) {
     
       char* chunk_ptr = blob_ptr + i;
 
@@ -185,10 +257,8 @@ struct kernel_blob {
         HIPSYCL_DEBUG_INFO << "Identified embedded pointer with uid "
                           << pointer_id << " in kernel blob, setting to "
                           << ptr << std::endl;
-        // Zero out detected embedded pointer
-        std::memset(chunk_ptr, 0, sizeof(unique_id));
-        // Set first 8 bytes of embedded pointer to ptr
-        std::memcpy(chunk_ptr, &ptr, sizeof(void*));
+        set_embedded_pointer(chunk_ptr, ptr);
+        new_offsets.push_back(i);
         
         found = true;
         // we cannot stop after having found an embedded pointer
@@ -203,8 +273,19 @@ struct kernel_blob {
     
     }
 
+    if(found)
+      table.add(new_offsets);
+
     return found;
   }
+
+private:
+  static void set_embedded_pointer(char* chunk_ptr, void* ptr) {
+    // Zero out detected embedded pointer
+    std::memset(chunk_ptr, 0, sizeof(unique_id));
+    // Set first 8 bytes of embedded pointer to ptr
+    std::memcpy(chunk_ptr, &ptr, sizeof(void*));
+  }
 };
 
 } // glue
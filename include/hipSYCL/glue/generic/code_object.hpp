@@ -47,8 +47,7 @@
   public:                                                                      \
     __hipsycl_hcf_registration##hcf_obj() {                             \
       this->_id = ::hipsycl::rt::hcf_cache::get().register_hcf_object(         \
-          ::hipsycl::common::hcf_container{std::string{                        \
-              reinterpret_cast<const char *>(hcf_string), hcf_size}});         \
+          hcf_obj, reinterpret_cast<const char *>(hcf_string), hcf_size);      \
     }                                                                          \
     ~__hipsycl_hcf_registration##hcf_obj() {                            \
       ::hipsycl::rt::hcf_cache::get().unregister_hcf_object(this->_id);        \
@@ -37,7 +37,7 @@
 #include <vector>
 #include <functional>
 #include <cassert>
-#include "hipSYCL/common/stable_running_hash.hpp"
+#include "hipSYCL/common/stable_fast_hash.hpp"
 
 namespace hipsycl {
 namespace glue {
@@ -51,7 +51,14 @@ class kernel_configuration {
     std::type_index _type;
     std::array<int8_t, buffer_size> _value;
     std::size_t _data_size;
+    std::array<uint64_t, 2> _hash;
     
+    void update_hash() {
+      common::stable_fast_hash h;
+      h(_name.data(), _name.size());
+      h(_value.data(), _data_size);
+      _hash = h.get_current_hash();
+    }
 
     template<class T>
     void store(const T& val) {
@@ -68,6 +75,20 @@ class kernel_configuration {
     configuration_entry(const std::string& name, const T& val)
     : _name{name}, _type{typeid(T)}, _data_size{sizeof(T)} {
       store<T>(val);
+      update_hash();
+    }
+
+    // Returns whether the value has changed
+    template<class T>
+    bool set_value(const T& val) {
+      auto old_value = _value;
+      store<T>(val);
+      if(_type == typeid(T) && old_value == _value)
+        return false;
+      _type = typeid(T);
+      _data_size = sizeof(T);
+      update_hash();
+      return true;
     }
 
     template<class T>
@@ -95,36 +116,36 @@ class kernel_configuration {
     const std::string& get_name() const {
       return _name;
     }
+
+    const std::array<uint64_t, 2>& get_hash() const {
+      return _hash;
+    }
   };
 public:
   using id_type = std::array<uint64_t, 2>;
 
+  // The id is maintained incrementally: Since it is the XOR of the hashes
+  // of all entries, changing an entry only requires replacing its
+  // contribution. Setting an entry to its current value does not
+  // rehash anything.
   template<class T>
   void set(const std::string& config_parameter_name, const T& value) {
-    configuration_entry entry{config_parameter_name, value};
     for(int i = 0; i < _configurations.size(); ++i) {
       if(_configurations[i].get_name() == config_parameter_name) {
-        _configurations[i] = entry;
+        id_type old_hash = _configurations[i].get_hash();
+        if(_configurations[i].set_value(value)) {
+          toggle_entry_hash(old_hash);
+          toggle_entry_hash(_configurations[i].get_hash());
+        }
         return;
       }
     }
-    _configurations.push_back(entry);
+    _configurations.push_back(configuration_entry{config_parameter_name, value});
+    toggle_entry_hash(_configurations.back().get_hash());
   }
 
   id_type generate_id() const {
-    id_type result {};
-
-    for(const auto& entry : _configurations) {
-      common::stable_running_hash h;
-      h(entry.get_name().data(), entry.get_name().size());
-      h(entry.get_data_buffer(), entry.get_data_size());
-
-      auto entry_hash = h.get_current_hash();
-
-      result[entry_hash % result.size()] ^= entry_hash;
-    }
-
-    return result;
+    return _id;
   }
 
   const std::vector<configuration_entry>& entries() const {
@@ -132,6 +153,13 @@ public:
   }
 
   std::vector<configuration_entry> _configurations;
+private:
+  void toggle_entry_hash(const id_type& entry_hash) {
+    for(std::size_t i = 0; i < _id.size(); ++i)
+      _id[i] ^= entry_hash[i];
+  }
+
+  id_type _id {};
 };
 
 }
@@ -35,8 +35,10 @@
 #include "hipSYCL/compiler/llvm-to-backend/LLVMToBackend.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/persistent_kernel_cache.hpp"
 #include "hipSYCL/glue/kernel_configuration.hpp"
 #include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 #include <cstddef>
 #include <vector>
 #include <atomic>
@@ -134,6 +136,9 @@ using symbol_list_t = compiler::LLVMToBackendTranslator::SymbolListType;
 class runtime_linker {
   
 public:
+  // Name of the images that imported symbols are resolved from
+  static constexpr char linked_image_name[] = "llvm-ir.global";
+
   using resolver = compiler::LLVMToBackendTranslator::ExternalSymbolResolver;
   using llvm_module_id = resolver::LLVMModuleId;
 
@@ -162,7 +167,7 @@ private:
             const rt::hcf_cache::symbol_resolver_list &images) {
       for (const auto &img : images) {
         // Always attempt to link with global LLVM IR for now
-        if (img.image_node->node_id == "llvm-ir.global") {
+        if (img.image_node->node_id == linked_image_name) {
           _image_node_to_hcf_map[img.image_node] = img.hcf_id;
           ir_modules_to_link.push_back(
               reinterpret_cast<llvm_module_id>(img.image_node));
@@ -257,6 +262,49 @@ inline rt::result compile(compiler::LLVMToBackendTranslator *translator,
 }
 
 
+// Generates the key under which the result of compiling the given
+// HCF image with the given translator and configuration is stored in the
+// persistent kernel cache. Should be called after all build options
+// have been applied to the translator.
+inline std::string
+generate_persistent_cache_key(compiler::LLVMToBackendTranslator *translator,
+                              const common::hcf_container *hcf,
+                              const std::string &image_name,
+                              const glue::kernel_configuration &config) {
+  std::string key = compiler::LLVMToBackendTranslator::getCompilerIdentifier();
+  
+  const std::string* hcf_object_id = hcf->root_node()->get_value("object-id");
+  key += "\nhcf-object:" + (hcf_object_id ? *hcf_object_id : std::string{});
+  key += "\nimage:" + image_name;
+  key += "\nbackend:" + std::to_string(translator->getBackendId());
+  for(const auto& kernel_name : translator->getOutliningEntrypoints())
+    key += "\nkernel:" + kernel_name;
+  for(const auto& build_config : translator->getBuildConfiguration())
+    key += "\n" + build_config;
+
+  // Code linked in from other HCF objects (e.g. shared libraries) affects
+  // the result as well, so key on the objects that runtime_linker would
+  // link in for the imports.
+  auto images_node = hcf->root_node()->get_subnode("images");
+  if(images_node && images_node->has_subnode(image_name)) {
+    symbol_list_t imported_symbol_names =
+        images_node->get_subnode(image_name)->get_as_list("imported-symbols");
+    if(!imported_symbol_names.empty()) {
+      for(const auto& symbol_name : imported_symbol_names)
+        key += "\nimport:" + symbol_name;
+      auto providers = rt::hcf_cache::get().get_symbol_providers(
+          imported_symbol_names, runtime_linker::linked_image_name);
+      for(auto id : providers)
+        key += "\nimport-provider:" + std::to_string(id);
+    }
+  }
+  
+  auto config_id = config.generate_id();
+  key += "\nconfiguration:" + std::to_string(config_id[0]) + "-" +
+         std::to_string(config_id[1]);
+  return key;
+}
+
 inline rt::result compile(compiler::LLVMToBackendTranslator* translator,
                           const common::hcf_container* hcf,
                           const std::string& image_name,
@@ -264,6 +312,7 @@ inline rt::result compile(compiler::LLVMToBackendTranslator* translator,
                           std::string &output) {
   assert(hcf);
   assert(hcf->root_node());
+  rt::trace_scope trace{"jit", "compile"};
 
 
   auto images_node = hcf->root_node()->get_subnode("images");
@@ -288,19 +337,31 @@ inline rt::result compile(compiler::LLVMToBackendTranslator* translator,
         rt::error_info{"jit::compile: Image " + image_name +
                        " was defined in HCF without data"});
   }
-  std::string source;
-  if(!hcf->get_binary_attachment(target_image_node, source)) {
-    return rt::make_error(
-        __hipsycl_here(),
-        rt::error_info{
-            "jit::compile: Could not extract binary data for HCF image " +
-            image_name});
-  }
+  auto jit_compiler = [&](std::string& compiled_output) -> rt::result {
+    std::string source;
+    if(!hcf->get_binary_attachment(target_image_node, source)) {
+      return rt::make_error(
+          __hipsycl_here(),
+          rt::error_info{
+              "jit::compile: Could not extract binary data for HCF image " +
+              image_name});
+    }
+
+    symbol_list_t imported_symbol_names =
+        target_image_node->get_as_list("imported-symbols");
 
-  symbol_list_t imported_symbol_names =
-      target_image_node->get_as_list("imported-symbols");
+    return compile(translator, source, config, imported_symbol_names,
+                   compiled_output);
+  };
+
+  rt::persistent_kernel_cache& disk_cache = rt::persistent_kernel_cache::get();
+  if(disk_cache.is_enabled()) {
+    std::string key =
+        generate_persistent_cache_key(translator, hcf, image_name, config);
+    return disk_cache.get_or_compile(key, output, jit_compiler);
+  }
 
-  return compile(translator, source, config, imported_symbol_names, output);
+  return jit_compiler(output);
 }
 
 inline rt::result compile(compiler::LLVMToBackendTranslator* translator,
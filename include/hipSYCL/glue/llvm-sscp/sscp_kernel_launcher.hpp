@@ -47,6 +47,8 @@
 #include "ir_constants.hpp"
 
 #include <array>
+#include <atomic>
+#include <memory>
 
 
 template <typename KernelType>
@@ -84,19 +86,16 @@ namespace glue {
 
 namespace sscp {
 
-static std::string get_local_hcf_object() {
-  return std::string{
-      reinterpret_cast<const char *>(__hipsycl_local_sscp_hcf_content),
-      __hipsycl_local_sscp_hcf_object_size};
-}
-
 // TODO: Maybe this can be unified with the HIPSYCL_STATIC_HCF_REGISTRATION
 // macro. We cannot use this macro directly because it expects
 // the object id to be constexpr, which it is not for the SSCP case.
 struct static_hcf_registration {
-  static_hcf_registration(const std::string& hcf_data) {
-    this->_hcf_object = rt::hcf_cache::get().register_hcf_object(
-        common::hcf_container{hcf_data});
+  // The HCF data is embedded in the binary, so it only needs to be
+  // parsed once the runtime actually looks up one of its kernels.
+  static_hcf_registration(rt::hcf_object_id id, const char *hcf_data,
+                          std::size_t hcf_size) {
+    this->_hcf_object =
+        rt::hcf_cache::get().register_hcf_object(id, hcf_data, hcf_size);
   }
 
   ~static_hcf_registration() {
@@ -105,8 +104,10 @@ struct static_hcf_registration {
 private:
   rt::hcf_object_id _hcf_object;
 };
-static static_hcf_registration
-    __hipsycl_register_sscp_hcf_object{get_local_hcf_object()};
+static static_hcf_registration __hipsycl_register_sscp_hcf_object{
+    __hipsycl_local_sscp_hcf_object_id,
+    reinterpret_cast<const char *>(__hipsycl_local_sscp_hcf_content),
+    __hipsycl_local_sscp_hcf_object_size};
 
 
 }
@@ -395,13 +396,37 @@ private:
     std::array<const void*, 1> args{&k};
     std::size_t arg_size = sizeof(k);
 
-    std::string kernel_name = generate_kernel(k);
+    // Kernels are resolved once per kernel type, so that launches
+    // do not need to look them up by name. Only successful resolutions
+    // are cached, failed ones are retried by the next launch.
+    // The resolved id lives until the end of the program.
+    static std::atomic<const rt::sscp_kernel_id*> resolved_kernel{nullptr};
+    const rt::sscp_kernel_id *kernel_id =
+        resolved_kernel.load(std::memory_order_acquire);
+    if(!kernel_id) {
+      auto id = std::make_unique<rt::sscp_kernel_id>();
+      rt::result resolve_err = rt::resolve_sscp_kernel(
+          __hipsycl_local_sscp_hcf_object_id, op->get_global_kernel_name(),
+          generate_kernel(k), *id);
+      if(!resolve_err.is_success()) {
+        rt::register_error(resolve_err);
+        return;
+      }
+      // Another thread may have resolved the kernel concurrently
+      const rt::sscp_kernel_id *expected = nullptr;
+      if (resolved_kernel.compare_exchange_strong(expected, id.get(),
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_acquire))
+        kernel_id = id.release();
+      else
+        kernel_id = expected;
+    }
 
     assert(_configuration);
     auto err = invoker->submit_kernel(
-        *op, __hipsycl_local_sscp_hcf_object_id, num_groups, group_size,
-        local_mem_size, const_cast<void **>(args.data()), &arg_size,
-        args.size(), kernel_name, *_configuration);
+        *op, *kernel_id, num_groups, group_size, local_mem_size,
+        const_cast<void **>(args.data()), &arg_size, args.size(),
+        *_configuration);
 
     if(!err.is_success()) {
       rt::register_error(err);
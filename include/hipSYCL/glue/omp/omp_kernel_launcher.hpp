@@ -144,19 +144,22 @@ void reducible_parallel_invocation(Function kernel,
   std::apply(finalize_all, sequential_reducers);
 }
 
+// Iterations are always distributed statically, such that the same
+// thread processes the same part of the range across kernel launches. This
+// is relied upon by the NUMA first-touch placement of omp_allocator.
 template <int Dim, class Function>
 void iterate_range_omp_for(sycl::range<Dim> r, Function f) noexcept {
 
   if constexpr (Dim == 1) {
 #ifdef _OPENMP
-    #pragma omp for
+    #pragma omp for schedule(static)
 #endif
     for (std::size_t i = 0; i < r.get(0); ++i) {
       f(sycl::id<Dim>{i});
     }
   } else if constexpr (Dim == 2) {
 #ifdef _OPENMP
-    #pragma omp for collapse(2)
+    #pragma omp for collapse(2) schedule(static)
 #endif
     for (std::size_t i = 0; i < r.get(0); ++i) {
       for (std::size_t j = 0; j < r.get(1); ++j) {
@@ -165,7 +168,7 @@ void iterate_range_omp_for(sycl::range<Dim> r, Function f) noexcept {
     }
   } else if constexpr (Dim == 3) {
 #ifdef _OPENMP
-    #pragma omp for collapse(3)
+    #pragma omp for collapse(3) schedule(static)
 #endif
     for (std::size_t i = 0; i < r.get(0); ++i) {
       for (std::size_t j = 0; j < r.get(1); ++j) {
@@ -186,7 +189,7 @@ void iterate_range_omp_for(sycl::id<Dim> offset, sycl::range<Dim> r,
 
   if constexpr (Dim == 1) {
 #ifdef _OPENMP
-  #pragma omp for
+  #pragma omp for schedule(static)
 #endif
     for (std::size_t i = min_i; i < max_i; ++i) {
       f(sycl::id<Dim>{i});
@@ -195,7 +198,7 @@ void iterate_range_omp_for(sycl::id<Dim> offset, sycl::range<Dim> r,
     const std::size_t min_j = offset.get(1);
     const std::size_t max_j = offset.get(1) + r.get(1);
 #ifdef _OPENMP
-  #pragma omp for collapse(2)
+  #pragma omp for collapse(2) schedule(static)
 #endif
     for (std::size_t i = min_i; i < max_i; ++i) {
       for (std::size_t j = min_j; j < max_j; ++j) {
@@ -208,7 +211,7 @@ void iterate_range_omp_for(sycl::id<Dim> offset, sycl::range<Dim> r,
     const std::size_t max_j = offset.get(1) + r.get(1);
     const std::size_t max_k = offset.get(2) + r.get(2);
 #ifdef _OPENMP
-  #pragma omp for collapse(3)
+  #pragma omp for collapse(3) schedule(static)
 #endif
     for (std::size_t i = min_i; i < max_i; ++i) {
       for (std::size_t j = min_j; j < max_j; ++j) {
@@ -253,6 +256,23 @@ inline void iterate_nd_range_omp(Function f, const sycl::id<Dim> &&group_id, con
 }
 #endif
 
+#if defined(HIPSYCL_HAS_FIBERS) && !defined(__HIPSYCL_USE_ACCELERATED_CPU__)
+// Resolved by the hipSYCL clang plugin: If no barrier (or group collective)
+// is reachable from the kernel invocation below, the body is replaced
+// with "return true". The kernel is never actually invoked here,
+// the call only exists such that the plugin can inspect the call graph.
+// Without the plugin, we conservatively assume that barriers are needed.
+template <int Dim, class Function, class... Reducers>
+HIPSYCL_BARRIER_FREE_ND_KERNEL_QUERY __attribute__((noinline))
+bool is_barrier_free_nd_kernel(bool invoke, const Function &f,
+                               const sycl::nd_item<Dim> *item,
+                               Reducers &...reducers) noexcept {
+  if(invoke)
+    f(*item, reducers...);
+  return false;
+}
+#endif
+
 template<class Function>
 inline
 void single_task_kernel(Function f) noexcept
@@ -322,30 +342,53 @@ inline void parallel_for_ndrange_kernel(
         num_local_mem_bytes, &group_shared_memory_ptr, barrier_impl, reducers...);
     });
 #elif defined(HIPSYCL_HAS_FIBERS)
-    host::static_range_decomposition<Dim> group_decomposition{
-        num_groups, get_num_threads()};
+    if (is_barrier_free_nd_kernel<Dim>(false, f, nullptr, reducers...)) {
+      // No barriers - no need for fibers, we can just run all work items
+      // of a group as a flat loop.
+      std::function<void()> barrier_impl = [] () noexcept {
+        assert(false && "barrier in kernel that was classified as barrier-free");
+        std::terminate();
+      };
+
+      iterate_range_omp_for(num_groups, [&](sycl::id<Dim> group_id) {
+        host::iterate_range(local_size, [&](sycl::id<Dim> local_id) {
+          sycl::nd_item<Dim> this_item{&offset,
+                                       group_id,
+                                       local_id,
+                                       local_size,
+                                       num_groups,
+                                       &barrier_impl,
+                                       &group_shared_memory_ptr};
+
+          f(this_item, reducers...);
+        });
+      });
+    } else {
+      host::static_range_decomposition<Dim> group_decomposition{
+          num_groups, get_num_threads()};
 
-    host::collective_execution_engine<Dim> engine{num_groups, local_size,
-                                                  offset, group_decomposition,
-                                                  get_my_thread_id()};
+      host::collective_execution_engine<Dim> engine{num_groups, local_size,
+                                                    offset, group_decomposition,
+                                                    get_my_thread_id()};
 
-    std::function<void()> barrier_impl = [&]() { engine.barrier(); };
+      std::function<void()> barrier_impl = [&]() { engine.barrier(); };
 
-    engine.run_kernel([&](sycl::id<Dim> local_id, sycl::id<Dim> group_id) {
+      engine.run_kernel([&](sycl::id<Dim> local_id, sycl::id<Dim> group_id) {
 
-      auto linear_group_id =
-          sycl::detail::linear_id<Dim>::get(group_id, num_groups);
+        auto linear_group_id =
+            sycl::detail::linear_id<Dim>::get(group_id, num_groups);
 
-      sycl::nd_item<Dim> this_item{&offset,
-                                    group_id,
-                                    local_id,
-                                    local_size,
-                                    num_groups,
-                                    &barrier_impl,
-                                    &group_shared_memory_ptr};
+        sycl::nd_item<Dim> this_item{&offset,
+                                      group_id,
+                                      local_id,
+                                      local_size,
+                                      num_groups,
+                                      &barrier_impl,
+                                      &group_shared_memory_ptr};
 
-      f(this_item, reducers...);
-    });
+        f(this_item, reducers...);
+      });
+    }
 #endif
 
     sycl::detail::host_local_memory::release();
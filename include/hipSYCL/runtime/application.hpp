@@ -28,7 +28,12 @@
 #ifndef HIPSYCL_APPLICATION_HPP
 #define HIPSYCL_APPLICATION_HPP
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "backend.hpp"
 #include "device_id.hpp"
@@ -64,6 +69,48 @@ private:
   std::shared_ptr<runtime> _rt;
 };
 
+// Hands out runtime pointers, but keeps the runtime alive for
+// idle_timeout after the last pointer has been released. If the runtime is
+// requested again within that time, it is reused instead of relaunched.
+// Used by application::get_runtime_pointer() if HIPSYCL_RUNTIME_IDLE_TIMEOUT
+// is set. The manager must outlive all pointers that it has handed out.
+class runtime_lifetime_manager {
+public:
+  runtime_lifetime_manager(std::chrono::nanoseconds idle_timeout);
+  ~runtime_lifetime_manager();
+
+  std::shared_ptr<runtime> get_runtime_pointer();
+
+  // Stops the idle timer and shuts down the runtime if it is idle.
+  // Runtimes still in use are shut down as soon as they are released.
+  void shutdown();
+
+  bool is_runtime_alive() const;
+  std::size_t get_num_runtime_launches() const;
+private:
+  void on_released(std::size_t generation);
+  void destroy_runtime(std::unique_lock<std::mutex> &lock);
+  void reap_idle_runtime();
+
+  std::chrono::nanoseconds _idle_timeout;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _state_changed;
+
+  std::unique_ptr<runtime> _rt;
+  // All pointers handed out to users share this control block;
+  // its deleter marks the runtime as idle.
+  std::weak_ptr<runtime> _users;
+  std::size_t _generation = 0;
+  std::size_t _num_launches = 0;
+  bool _is_idle = false;
+  bool _is_being_destroyed = false;
+  bool _is_shut_down = false;
+  std::chrono::steady_clock::time_point _idle_since;
+
+  std::thread _reaper;
+};
+
 class runtime_keep_alive_token {
 public:
   runtime_keep_alive_token();
@@ -28,7 +28,10 @@
 #ifndef HIPSYCL_RUNTIME_BACKEND_HPP
 #define HIPSYCL_RUNTIME_BACKEND_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -76,13 +79,26 @@ public:
   create_inorder_executor(device_id dev, int priority) = 0;
 };
 
+struct backend_startup_info
+{
+  std::string name;
+  bool is_initialized;
+  // Only meaningful if is_initialized is true
+  bool creation_failed;
+  std::uint64_t initialization_time_ns;
+};
+
+// Backends are created lazily: get() only initializes the backend that
+// is requested, while for_each_backend() initializes all backends that
+// have not yet been created concurrently.
 class backend_manager
 {
 public:
-  using backend_list_type =
-      std::vector<std::unique_ptr<backend>>;
-
   backend_manager();
+  // Additional plugin search paths are mainly useful to load
+  // plugins that are not part of the installation, e.g. for testing.
+  explicit backend_manager(
+      const std::vector<std::string> &additional_plugin_search_paths);
   ~backend_manager();
   
   backend* get(backend_id) const;
@@ -92,14 +108,33 @@ public:
   template<class F>
   void for_each_backend(F f)
   {
-    for(auto& b : _backends){
-      f(b.get());
+    initialize_all_backends();
+    for(auto& slot : _backends){
+      if(slot->instance)
+        f(slot->instance.get());
     }
   }
 
+  // Returns information about all discovered backend plugins,
+  // including the time it took to create the backend.
+  std::vector<backend_startup_info> get_startup_info() const;
+
 private:
+  struct backend_slot {
+    std::size_t loader_index;
+    std::string name;
+    std::once_flag init_flag;
+    std::atomic<bool> is_initialized{false};
+    std::unique_ptr<backend> instance;
+    std::uint64_t initialization_time_ns = 0;
+  };
+
+  void initialize_backend(backend_slot& slot) const;
+  void initialize_all_backends() const;
+  backend* find_initialized(backend_id id) const;
+
   backend_loader _loader;
-  backend_list_type _backends;
+  std::vector<std::unique_ptr<backend_slot>> _backends;
 
   std::unique_ptr<hw_model> _hw_model;
 };
@@ -33,6 +33,8 @@
 #include <vector>
 #include <utility>
 
+#include "device_id.hpp"
+
 namespace hipsycl::rt {
 class backend;
 }
@@ -53,11 +55,17 @@ const char* hipsycl_backend_plugin_get_name();
 namespace hipsycl {
 namespace rt {
 
+// Maps the name of a backend plugin to the id of the backend that it
+// provides without loading the backend. Returns false for unknown plugins.
+bool get_backend_id_from_plugin_name(const std::string &name,
+                                     backend_id &out);
+
 class backend_loader {
 public:
   ~backend_loader();
 
-  void query_backends();
+  void query_backends(
+      const std::vector<std::string> &additional_search_paths = {});
   
   std::size_t get_num_backends() const;
   std::string get_backend_name(std::size_t index) const;
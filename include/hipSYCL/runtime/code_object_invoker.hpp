@@ -51,16 +51,73 @@ public:
   virtual ~multipass_code_object_invoker(){}
 };
 
+/// Identifies an SSCP kernel in the kernel_cache and the hcf_cache.
+/// Kernel launchers obtain it once per kernel using resolve_sscp_kernel(),
+/// so that launches do not need to look up kernels by name.
+struct sscp_kernel_id {
+  hcf_object_id hcf_object;
+  kernel_cache::kernel_name_index_t kernel_index;
+  const hcf_kernel_info *kernel_info;
+  /// The name of the kernel in the HCF object
+  std::string kernel_name;
+};
+
+/// Looks up the ids of the kernel \c kernel_name from the given HCF object,
+/// which is registered in the kernel_cache as \c global_kernel_name.
+inline result resolve_sscp_kernel(hcf_object_id hcf_object,
+                                  const std::string &global_kernel_name,
+                                  const std::string &kernel_name,
+                                  sscp_kernel_id &out) {
+  const kernel_cache::kernel_name_index_t *kidx =
+      kernel_cache::get().get_global_kernel_index(global_kernel_name);
+  if(!kidx) {
+    return make_error(__hipsycl_here(),
+                      error_info{"Could not obtain kernel index for kernel " +
+                                 global_kernel_name});
+  }
+
+  const hcf_kernel_info *kernel_info =
+      hcf_cache::get().get_kernel_info(hcf_object, kernel_name);
+  if(!kernel_info) {
+    return make_error(__hipsycl_here(),
+                      error_info{"Could not obtain hcf kernel info for kernel " +
+                                 global_kernel_name});
+  }
+
+  out = sscp_kernel_id{hcf_object, *kidx, kernel_info, kernel_name};
+  return make_success();
+}
+
 class sscp_code_object_invoker {
 public:
   virtual result submit_kernel(const kernel_operation& op,
-                               hcf_object_id hcf_object,
+                               const sscp_kernel_id &kernel_id,
                                const rt::range<3> &num_groups,
                                const rt::range<3> &group_size,
                                unsigned local_mem_size, void **args,
                                std::size_t *arg_sizes, std::size_t num_args,
-                               const std::string &kernel_name,
                                const glue::kernel_configuration& config) = 0;
+
+  /// Compiles the code object containing the specified kernel if it
+  /// is not yet in the kernel cache, without launching the kernel.
+  /// This can be called from any thread, e.g. to warm up the kernel cache
+  /// in the background using jit_compilation_service::warm_up().
+  /// \param global_kernel_name The name under which the kernel is registered
+  /// in the kernel_cache, as returned by kernel_operation::get_global_kernel_name()
+  /// \param local_mem_size Dynamic local memory size that the kernel will be
+  /// launched with. Some backends need to know this at compile time.
+  virtual result prepare_kernel(hcf_object_id hcf_object,
+                                const std::string &global_kernel_name,
+                                const std::string &kernel_name,
+                                unsigned local_mem_size,
+                                const glue::kernel_configuration &config) {
+    return make_error(__hipsycl_here(),
+                      error_info{"sscp_code_object_invoker: Ahead-of-launch "
+                                 "kernel preparation is not supported by "
+                                 "this backend",
+                                 error_type::feature_not_supported});
+  }
+
   virtual ~sscp_code_object_invoker(){}
 };
 
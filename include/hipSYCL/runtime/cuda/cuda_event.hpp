@@ -32,6 +32,7 @@
 
 // Note: CUevent_st* == cudaEvent_t 
 struct CUevent_st;
+struct CUstream_st;
 
 namespace hipsycl {
 namespace rt {
@@ -44,12 +45,16 @@ public:
   /// \param evt cuda event; must have been properly initialized and recorded.
   /// \param pool the pool managing the event. If not null, the destructor will return the event
   /// to the pool.
-  cuda_node_event(device_id dev, CUevent_st* evt, cuda_event_pool* pool = nullptr);
+  /// \param stream the stream on which the event was recorded. If not null,
+  /// completion notifications are delivered by host functions on this stream.
+  cuda_node_event(device_id dev, CUevent_st* evt, cuda_event_pool* pool = nullptr,
+                  CUstream_st* stream = nullptr);
 
   ~cuda_node_event();
 
   virtual bool is_complete() const override;
   virtual void wait() override;
+  virtual bool notify_on_completion(std::function<void()> callback) override;
 
   backend_event_type get_event() const;
   device_id get_device() const;
@@ -59,6 +64,7 @@ private:
   device_id _dev;
   backend_event_type _evt;
   cuda_event_pool* _pool;
+  CUstream_st* _stream;
 };
 
 }
@@ -33,8 +33,9 @@
 #include "operations.hpp"
 #include "hints.hpp"
 
-#include <mutex>
+#include <atomic>
 #include <memory>
+#include <vector>
 
 namespace hipsycl {
 namespace rt {
@@ -48,11 +49,14 @@ class runtime;
 /// Note: At any given time, there can only exist one dag_builder, otherwise
 /// calculated dependencies may be incorrect!
 ///
-/// Thread safety: Safe
+/// Thread safety: Safe. Command groups are only serialized with other
+/// command groups accessing the same data regions, and are appended to
+/// the current DAG without taking a lock.
 class dag_builder
 {
 public:
   dag_builder(runtime* rt);
+  ~dag_builder();
 
   dag_node_ptr add_kernel(std::unique_ptr<operation> op,
                           const requirements_list& requirements,
@@ -74,10 +78,24 @@ public:
                                const requirements_list &requirements,
                                const execution_hints &hints = {});
 
+  /// Not thread-safe with respect to other invocations of
+  /// finish_and_reset(), which must be serialized by the caller.
   dag finish_and_reset();
 
   std::size_t get_current_dag_size() const;
 private:
+  // Entry of the lock-free stack of nodes added since the last
+  // finish_and_reset()
+  struct pending_node {
+    dag_node_ptr node;
+    // Nodes only reference their requirements weakly, so the
+    // DAG needs to keep them alive until it is flushed.
+    std::vector<dag_node_ptr> memory_requirements;
+    pending_node* next;
+  };
+
+  void append_to_current_dag(dag_node_ptr node);
+
   bool is_conflicting_access(const memory_requirement *mem_req,
                              const data_user &user) const;
 
@@ -88,8 +106,8 @@ private:
                                 const requirements_list& requirements,
                                 const execution_hints& hints = {});
 
-  mutable std::mutex _mutex;
-  dag _current_dag;
+  std::atomic<pending_node*> _pending_nodes;
+  std::atomic<std::size_t> _current_dag_size;
   runtime* _rt;
 };
 
@@ -28,6 +28,8 @@
 #ifndef HIPSYCL_DAG_MANAGER_HPP
 #define HIPSYCL_DAG_MANAGER_HPP
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
 
 #include "dag.hpp"
@@ -36,6 +38,7 @@
 #include "dag_unbound_scheduler.hpp"
 #include "dag_submitted_ops.hpp"
 #include "generic/async_worker.hpp"
+#include "settings.hpp"
 
 
 namespace hipsycl {
@@ -43,6 +46,14 @@ namespace rt {
 
 class runtime;
 
+// Whether nodes should be flushed to the scheduler right after a
+// submission under the given policy. executors_idle means that no flush
+// is in progress and all submitted nodes have completed, submission_gap
+// is the time since the previous submission.
+bool is_flush_due(dag_flush_policy policy, std::size_t num_cached_nodes,
+                  std::size_t max_cached_nodes, bool executors_idle,
+                  std::chrono::steady_clock::duration submission_gap);
+
 class dag_manager
 {
   friend class dag_build_guard;
@@ -64,6 +75,13 @@ public:
   void register_submitted_ops(dag_node_ptr);
 private:
   void trigger_flush_opportunity();
+  // Whether no flush is in progress and all submitted nodes have completed
+  bool is_idle() const;
+  void flush_if_idle();
+  void schedule_flush();
+  // Runs in the worker thread: Takes all nodes from the builder and
+  // submits them to the scheduler
+  void process_flush();
 
   dag_builder* builder() const;
 
@@ -74,8 +92,12 @@ private:
   dag_unbound_scheduler _unbound_scheduler;
   dag_submitted_ops _submitted_ops;
 
-  // Should only be used for flush_async()
-  std::mutex _flush_mutex;
+  // Whether a flush has been handed to the worker thread that has not yet
+  // taken the nodes from the builder
+  std::atomic<bool> _flush_scheduled{false};
+
+  std::atomic<std::size_t> _num_pending_flushes{0};
+  std::atomic<std::chrono::steady_clock::rep> _last_submission{0};
 
   runtime* _rt;
 };
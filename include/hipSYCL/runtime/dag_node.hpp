@@ -109,6 +109,11 @@ public:
   // for is_known_complete().
   void wait() const;
 
+  // Marks the node and all its requirements as known to be complete.
+  // Must only be invoked once the node's event has completed, e.g.
+  // from a completion callback of the event.
+  void mark_known_complete() const;
+
   std::shared_ptr<dag_node_event> get_event() const;
 
   void for_each_nonvirtual_requirement(std::function<void(dag_node_ptr)>
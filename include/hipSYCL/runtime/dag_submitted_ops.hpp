@@ -29,6 +29,9 @@
 #ifndef HIPSYCL_DAG_SUBMITTED_OPS_HPP
 #define HIPSYCL_DAG_SUBMITTED_OPS_HPP
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -42,8 +45,13 @@ namespace rt {
 class dag_submitted_ops
 {
 public:
+  dag_submitted_ops() = default;
+  ~dag_submitted_ops();
+
   // Asynchronously waits on the nodes to complete, and, once complete,
   // removes them (and other completed) nodes from the submitted list.
+  // Nodes are tracked using completion callbacks of their events where
+  // supported, and are otherwise waited for on an updater thread.
   //
   // All nodes in the provided argument vector must have been registered
   // previously with update_with_submission()
@@ -57,11 +65,31 @@ public:
   std::vector<dag_node_ptr> get_group(std::size_t node_group);
 
   bool contains_node(dag_node_ptr node) const;
+
+  // Returns whether any registered node is not yet known to be complete
+  bool has_pending_ops() const;
+  // Sets a callback that is invoked whenever all registered nodes have
+  // completed and were unregistered. Once set_idle_callback() returns,
+  // a previously set callback is not invoked anymore.
+  void set_idle_callback(std::function<void()> callback);
 private:
   void purge_known_completed();
+  void schedule_purge();
 
   std::vector<dag_node_ptr> _ops;
   mutable std::mutex _lock;
+
+  std::atomic<bool> _is_purge_scheduled{false};
+  std::mutex _callback_lock;
+  std::condition_variable _callbacks_completed;
+  std::size_t _num_pending_callbacks = 0;
+  // References to nodes from completion callbacks that are
+  // released on the updater thread
+  std::vector<dag_node_ptr> _callback_released_nodes;
+
+  std::mutex _idle_callback_lock;
+  std::function<void()> _idle_callback;
+
   worker_thread _updater_thread;
 };
 
@@ -34,6 +34,7 @@
 #include <utility>
 #include <algorithm>
 #include <limits>
+#include <numeric>
 
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/sycl/access.hpp"
@@ -41,6 +42,7 @@
 #include "device_id.hpp"
 #include "util.hpp"
 #include "allocator.hpp"
+#include "performance_counters.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -84,6 +86,11 @@ public:
   bool entire_range_empty(const rect& r) const
   { return entire_range_equals(r, data_state::empty); }
 
+  /// \return A store of size \c new_size where each entry takes the state
+  /// of the entry of this store at its position divided by \c factor.
+  /// Runs in time linear in the size of the new store.
+  range_store refine(range<3> factor, range<3> new_size) const;
+
 private:
   template<class Entry_selection_predicate>
   range<3> find_max_contiguous_rect_extent(
@@ -464,6 +471,8 @@ public:
     // Make sure that there isn't already an allocation on the given device
     assert(!has_allocation(d));
 
+    performance_counters::get().memory_allocated(
+        d, _num_elements.size() * _element_size);
     this->add_allocation<initial_data_state::invalid>(d, memory_context,
                                                       takes_ownership,
                                                       allocator);
@@ -486,11 +495,20 @@ public:
                                                     allocator);
   }
 
+  /// \return The offset in bytes of the given element from the start
+  /// of any allocation of this data region
+  std::size_t get_byte_offset(id<3> element) const {
+    return ((element[0] * _num_elements[1] + element[1]) * _num_elements[2] +
+            element[2]) * _element_size;
+  }
+
   /// Converts an offset into the data buffer (in element numbers) and the
   /// data length (in element numbers) into an equivalent \c page_range.
   page_range get_page_range(id<3> data_offset, range<3> data_range) const {
-    // Is thread safe without lock because it doesn't modify internal state
-    // and doesn't access mutable members.
+    // Does not lock. The page size only changes in align_pages_to(),
+    // which requires the dependency lock and that no user of the region
+    // is pending. Callers therefore need to either hold the dependency
+    // lock or act on behalf of a pending user.
     id<3> page_begin{0,0,0};
     
     for(int i = 0; i < 3; ++i)
@@ -565,23 +583,52 @@ public:
     assert(was_found);
     
     // Convert back to num elements
-    for(range_store::rect& r : out) {
-      for(int i = 0; i < 3; ++i) {
-        r.first[i] *= _page_size[i];
-        r.second[i] *= _page_size[i];
+    for(range_store::rect& r : out)
+      pages_to_elements(r);
+  }
 
-        // Clamp result range to data range. This is necessary
-        // if the number of elements is not divisible by the page
-        // size, in which case we can end up out of bounds when mapping
-        // pages back to elements.
-        r.first[i] = std::min(r.first[i], _num_elements[i]);
+  /// Partitions the given range into regions that are each valid on a
+  /// single allocation, such that the range can be assembled with one
+  /// copy per region. Allocations of \c preferred are used first.
+  /// Pages that are not valid on any allocation are not part of the
+  /// result.
+  void get_valid_sources(
+      const device_id &preferred, id<3> data_offset, range<3> data_range,
+      std::vector<std::pair<device_id, range_store::rect>> &out) const {
+    out.clear();
 
-        std::size_t max_range = _num_elements[i] - r.first[i];
-        r.second[i] = std::min(r.second[i], max_range);
+    page_range pr = get_page_range(data_offset, data_range);
 
-        assert(r.first[i]+r.second[i] <= _num_elements[i]);
+    range_store uncovered{_num_pages};
+    uncovered.add(pr);
+
+    std::vector<range_store::rect> uncovered_regions;
+    std::vector<range_store::rect> valid_regions;
+    auto take_valid_pages = [&](const auto &alloc) {
+      uncovered_regions.clear();
+      uncovered.intersections_with(pr, uncovered_regions);
+      for(const range_store::rect& r : uncovered_regions) {
+        valid_regions.clear();
+        alloc.invalid_pages.inverted_intersections_with(r, valid_regions);
+        for(const range_store::rect& valid : valid_regions) {
+          uncovered.remove(valid);
+          out.push_back(std::make_pair(alloc.dev, valid));
+        }
       }
-    }
+    };
+
+    default_allocation_selector is_preferred{preferred};
+    _allocations.select_and_handle(is_preferred, take_valid_pages);
+    _allocations.for_each_allocation_while([&](const auto &alloc) {
+      if (uncovered.entire_range_empty(pr))
+        return false;
+      if (!is_preferred(alloc))
+        take_valid_pages(alloc);
+      return true;
+    });
+
+    for(auto& source : out)
+      pages_to_elements(source.second);
   }
 
   void get_update_source_candidates(
@@ -616,6 +663,12 @@ public:
   const data_user_tracker& get_users() const
   { return _user_tracker; }
 
+  /// Serializes the dependency analysis of command groups accessing this
+  /// data region, i.e. looking up the conflicting users and registering
+  /// the new user must happen atomically.
+  std::mutex& get_dependency_lock()
+  { return _dependency_lock; }
+
   std::size_t get_element_size() const { return _element_size; }
 
   range<3> get_num_elements() const { return _num_elements; }
@@ -688,6 +741,130 @@ public:
     return found_valid_pages;
   }
 
+  /// Finds a device whose allocation holds valid data for the entire
+  /// given range. \c preferred is chosen if it qualifies.
+  /// \return whether such a device was found
+  bool find_valid_allocation(const device_id &preferred, id<3> data_offset,
+                             range<3> data_range, device_id &out) const {
+    page_range pr = get_page_range(data_offset, data_range);
+
+    bool was_found = false;
+    _allocations.for_each_allocation_while([&](const auto &alloc) {
+      if (alloc.invalid_pages.entire_range_empty(pr)) {
+        out = alloc.dev;
+        was_found = true;
+        if (default_allocation_selector{preferred}(alloc))
+          return false;
+      }
+      return true;
+    });
+
+    return was_found;
+  }
+
+  /// Attempts to grant access to a range on device \c d without scheduling
+  /// any operation. This succeeds if no conflicting user is pending and
+  /// \c d holds valid data for the range (or the access does not require
+  /// valid data). Writing accesses mark the range as current on \c d.
+  /// The check and the marking happen under the dependency lock, so that
+  /// no conflicting user can be registered in between.
+  /// \return The memory of \c d on success, a null descriptor otherwise.
+  Memory_descriptor try_direct_access(const device_id &d,
+                                      sycl::access::mode mode,
+                                      id<3> data_offset, range<3> data_range) {
+    std::lock_guard<std::mutex> lock{_dependency_lock};
+
+    const bool is_read_only = mode == sycl::access::mode::read;
+    const bool requires_valid_data =
+        mode != sycl::access::mode::discard_write &&
+        mode != sycl::access::mode::discard_read_write;
+
+    bool has_pending_conflict = false;
+    _user_tracker.for_each_user([&](const data_user &user) {
+      if (has_pending_conflict ||
+          (is_read_only && user.mode == sycl::access::mode::read))
+        return;
+      dag_node_ptr node = user.user.lock();
+      if (node && !(node->is_submitted() &&
+                    (node->is_known_complete() || node->is_complete())))
+        has_pending_conflict = true;
+    });
+    if (has_pending_conflict)
+      return Memory_descriptor{};
+
+    page_range pr = get_page_range(data_offset, data_range);
+
+    Memory_descriptor mem{};
+    _allocations.select_and_handle(default_allocation_selector{d},
+                                   [&](const auto &alloc) {
+      if (!requires_valid_data || alloc.invalid_pages.entire_range_empty(pr))
+        mem = alloc.memory;
+    });
+
+    if (mem && !is_read_only)
+      mark_range_current(d, data_offset, data_range);
+
+    return mem;
+  }
+
+  /// Upper bound for the number of pages that \c align_pages_to()
+  /// may create, since page table operations are linear in it.
+  static constexpr std::size_t max_aligned_pages = 1 << 16;
+
+  /// Refines the page size such that the given range starts and ends at
+  /// page boundaries, so that accesses inside and outside of it do not
+  /// depend on each other. The page table is not synchronized with the
+  /// scheduler, so this is only done while no user of the region is
+  /// pending. The caller must hold the dependency lock.
+  /// \return Whether the range is aligned to pages afterwards
+  bool align_pages_to(id<3> data_offset, range<3> data_range) {
+    range<3> new_page_size = _page_size;
+    for(int i = 0; i < 3; ++i) {
+      new_page_size[i] = std::gcd(new_page_size[i], data_offset[i]);
+      if(data_offset[i] + data_range[i] < _num_elements[i])
+        new_page_size[i] =
+            std::gcd(new_page_size[i], data_offset[i] + data_range[i]);
+    }
+    if(new_page_size == _page_size)
+      return true;
+
+    range<3> new_num_pages;
+    for(int i = 0; i < 3; ++i)
+      new_num_pages[i] =
+          (_num_elements[i] + new_page_size[i] - 1) / new_page_size[i];
+    if(new_num_pages.size() > max_aligned_pages)
+      return false;
+
+    bool has_pending_user = false;
+    _user_tracker.for_each_user([&](const data_user &user) {
+      dag_node_ptr node = user.user.lock();
+      if (node && !(node->is_submitted() &&
+                    (node->is_known_complete() || node->is_complete())))
+        has_pending_user = true;
+    });
+    if(has_pending_user)
+      return false;
+
+    // Since the new page size divides the old one, each old page maps
+    // to a block of new pages with the same state.
+    range<3> factor;
+    for(int i = 0; i < 3; ++i)
+      factor[i] = _page_size[i] / new_page_size[i];
+
+    _allocations.for_each_allocation_while([&](auto &alloc) {
+      alloc.invalid_pages = alloc.invalid_pages.refine(factor, new_num_pages);
+      return true;
+    });
+
+    HIPSYCL_DEBUG_INFO << "data_region: refined page table dimensions to "
+                       << new_num_pages[0] << " " << new_num_pages[1] << " "
+                       << new_num_pages[2] << std::endl;
+
+    _page_size = new_page_size;
+    _num_pages = new_num_pages;
+    return true;
+  }
+
 private:
   std::size_t _element_size;
 
@@ -724,11 +901,31 @@ private:
     assert(was_inserted);
   }
 
+  /// Converts a rect of pages into the rect of elements it covers
+  void pages_to_elements(range_store::rect& r) const {
+    for(int i = 0; i < 3; ++i) {
+      r.first[i] *= _page_size[i];
+      r.second[i] *= _page_size[i];
+
+      // Clamp result range to data range. This is necessary
+      // if the number of elements is not divisible by the page
+      // size, in which case we can end up out of bounds when mapping
+      // pages back to elements.
+      r.first[i] = std::min(r.first[i], _num_elements[i]);
+
+      std::size_t max_range = _num_elements[i] - r.first[i];
+      r.second[i] = std::min(r.second[i], max_range);
+
+      assert(r.first[i]+r.second[i] <= _num_elements[i]);
+    }
+  }
+
   range<3> _page_size;
   range<3> _num_pages;
   range<3> _num_elements;
 
   data_user_tracker _user_tracker;
+  std::mutex _dependency_lock;
 };
 
 using buffer_data_region = data_region<void*>;
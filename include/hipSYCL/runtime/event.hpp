@@ -28,6 +28,8 @@
 #ifndef HIPSYCL_DAG_NODE_EVENT_HPP
 #define HIPSYCL_DAG_NODE_EVENT_HPP
 
+#include <functional>
+
 #include "device_id.hpp"
 #include "error.hpp"
 
@@ -39,6 +41,17 @@ class dag_node_event
 public:
   virtual bool is_complete() const = 0;
   virtual void wait() = 0;
+
+  // Invokes callback once the event has completed. The callback may be
+  // invoked from a backend thread, or immediately if the event has already
+  // completed, and should therefore be short and not block. Since it may run
+  // inside a backend host callback, it must not call into the backend.
+  // Returns false if the event cannot notify about its completion; in this
+  // case, the callback is never invoked and callers need to wait or poll.
+  virtual bool notify_on_completion(std::function<void()> callback) {
+    return false;
+  }
+
   virtual ~dag_node_event() {}
 }; 
 
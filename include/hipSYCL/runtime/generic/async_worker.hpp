@@ -30,7 +30,11 @@
 
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
 #include <mutex>
 #include <functional>
 #include <queue>
@@ -83,6 +87,80 @@ private:
   std::queue<async_function> _enqueued_operations;
 };
 
+/// Orders work of multiple workers by priority. Workers announce work
+/// using acquire() and may only start once no work with a higher
+/// effective priority is waiting or running. Work of equal priority
+/// can run concurrently.
+///
+/// As for CUDA and HIP stream priorities, lower values denote higher
+/// priorities. Waiting work ages: Its effective priority increases
+/// by one level per aging interval, such that low-priority work cannot
+/// starve.
+///
+/// Arbitration is only required while queues with a non-default priority
+/// exist. Until one is registered, acquire() returns immediately without
+/// synchronizing with other workers.
+class priority_arbiter
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  class guard
+  {
+  public:
+    guard(priority_arbiter* arbiter, int priority)
+    : _arbiter{arbiter}, _priority{priority} {}
+
+    guard(const guard&) = delete;
+    guard& operator=(const guard&) = delete;
+
+    guard(guard&& other)
+    : _arbiter{other._arbiter}, _priority{other._priority} {
+      other._arbiter = nullptr;
+    }
+
+    ~guard() {
+      if(_arbiter)
+        _arbiter->release(_priority);
+    }
+  private:
+    priority_arbiter* _arbiter;
+    int _priority;
+  };
+
+  priority_arbiter(clock::duration aging_interval = std::chrono::milliseconds{10});
+
+  /// Blocks until work with the given priority may start. The work
+  /// is considered running until the returned guard is destroyed.
+  guard acquire(int priority);
+
+  /// Announces a queue with non-default priority, which enables
+  /// arbitration until it is unregistered again. Work that started
+  /// before the registration is not tracked.
+  void register_prioritized_queue();
+  void unregister_prioritized_queue();
+private:
+  struct waiting_work {
+    std::uint64_t id;
+    clock::time_point enqueue_time;
+  };
+
+  void release(int priority);
+  bool can_start(int priority, clock::time_point enqueue_time,
+                 clock::time_point now) const;
+  int get_effective_priority(int priority, clock::time_point enqueue_time,
+                             clock::time_point now) const;
+
+  std::mutex _mutex;
+  std::condition_variable _condition_wait;
+  // Ready lists of waiting work for each priority, in FIFO order
+  std::map<int, std::deque<waiting_work>> _waiting;
+  std::map<int, std::size_t> _num_running;
+  std::uint64_t _next_id = 0;
+  clock::duration _aging_interval;
+  std::atomic<std::size_t> _num_prioritized_queues{0};
+};
+
 }
 }
 
@@ -28,6 +28,7 @@
 #ifndef HIPSYCL_DAG_MULTI_EVENT_HPP
 #define HIPSYCL_DAG_MULTI_EVENT_HPP
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include "../event.hpp"
@@ -54,6 +55,37 @@ public:
       evt->wait();
   }
 
+  // Only supported if all contained events support completion callbacks.
+  virtual bool notify_on_completion(std::function<void()> callback) override {
+    struct notification_state {
+      std::atomic<std::size_t> num_pending;
+      std::atomic<bool> is_invalid{false};
+      std::function<void()> callback;
+    };
+
+    auto state = std::make_shared<notification_state>();
+    // One additional count is held until all callbacks are registered,
+    // so that the callback cannot run before we know whether registering
+    // succeeded for all events.
+    state->num_pending = _events.size() + 1;
+    state->callback = std::move(callback);
+
+    auto on_event_complete = [state]() {
+      if (state->num_pending.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+          !state->is_invalid.load(std::memory_order_acquire))
+        state->callback();
+    };
+
+    for(auto& evt : _events) {
+      if(!evt->notify_on_completion(on_event_complete)) {
+        state->is_invalid = true;
+        return false;
+      }
+    }
+    on_event_complete();
+    return true;
+  }
+
   virtual ~dag_multi_node_event() {}
 
   void add_event(std::shared_ptr<dag_node_event> evt){
@@ -31,6 +31,7 @@
 #include "../inorder_queue_event.hpp"
 
 struct ihipEvent_t;
+struct ihipStream_t;
 
 namespace hipsycl {
 namespace rt {
@@ -43,12 +44,17 @@ public:
   /// \param evt Must have been properly initialized and recorded.
   /// \param pool the pool managing the event. If not null, the destructor
   /// will return the event to the pool.
-  hip_node_event(device_id dev, backend_event_type evt, hip_event_pool* pool = nullptr);
+  /// \param stream the stream on which the event was recorded. If not null,
+  /// completion notifications are delivered by host functions on this stream.
+  hip_node_event(device_id dev, backend_event_type evt,
+                 hip_event_pool *pool = nullptr,
+                 ihipStream_t *stream = nullptr);
 
   ~hip_node_event();
 
   virtual bool is_complete() const override;
   virtual void wait() override;
+  virtual bool notify_on_completion(std::function<void()> callback) override;
 
   ihipEvent_t* get_event() const;
   device_id get_device() const;
@@ -58,6 +64,7 @@ private:
   device_id _dev;
   backend_event_type _evt;
   hip_event_pool* _pool;
+  ihipStream_t* _stream;
 };
 
 }
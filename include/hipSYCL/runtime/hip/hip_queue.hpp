@@ -70,13 +70,18 @@ public:
   virtual ~hip_sscp_code_object_invoker(){}
 
   virtual result submit_kernel(const kernel_operation& op,
-                               hcf_object_id hcf_object,
+                               const sscp_kernel_id &kernel_id,
                                const rt::range<3> &num_groups,
                                const rt::range<3> &group_size,
                                unsigned local_mem_size, void **args,
                                std::size_t *arg_sizes, std::size_t num_args,
-                               const std::string &kernel_name,
                                const glue::kernel_configuration& config) override;
+
+  virtual result prepare_kernel(hcf_object_id hcf_object,
+                                const std::string &global_kernel_name,
+                                const std::string &kernel_name,
+                                unsigned local_mem_size,
+                                const glue::kernel_configuration &config) override;
 private:
   hip_queue* _queue;
 };
@@ -111,6 +116,8 @@ public:
 
   virtual result query_status(inorder_queue_status& status) override;
 
+  virtual sscp_code_object_invoker* get_sscp_code_object_invoker() override;
+
   result submit_multipass_kernel_from_code_object(
       const kernel_operation &op, hcf_object_id hcf_object,
       const std::string &backend_kernel_name, const rt::range<3> &grid_size,
@@ -118,12 +125,18 @@ public:
       void **kernel_args, std::size_t* arg_sizes, std::size_t num_args);
 
   result submit_sscp_kernel_from_code_object(
-      const kernel_operation &op, hcf_object_id hcf_object,
-      const std::string &kernel_name, const rt::range<3> &num_groups,
-      const rt::range<3> &group_size, unsigned local_mem_size, void **args,
-      std::size_t *arg_sizes, std::size_t num_args,
+      const kernel_operation &op, const sscp_kernel_id &kernel_id,
+      const rt::range<3> &num_groups, const rt::range<3> &group_size,
+      unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+      std::size_t num_args,
       const glue::kernel_configuration &config);
 
+  /// Obtains the code object containing an SSCP kernel from the kernel
+  /// cache, compiling it if necessary. Can be called from any thread.
+  result get_sscp_code_object(const sscp_kernel_id &kernel_id,
+                              const glue::kernel_configuration &config,
+                              const code_object *&obj_out);
+
   const host_timestamped_event& get_timing_reference() const {
     return _reference_event;
   }
@@ -0,0 +1,96 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_NUMA_HPP
+#define HIPSYCL_NUMA_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+/// Describes the NUMA domains of the host system and the CPUs
+/// belonging to them. On Linux, this is obtained from sysfs;
+/// on other systems or if sysfs is unavailable, the topology
+/// degenerates to a single domain containing all CPUs.
+class numa_topology
+{
+public:
+  /// Constructs a topology consisting of a single domain
+  /// with num_cpus CPUs.
+  explicit numa_topology(std::size_t num_cpus);
+
+  /// Reads topology from sysfs_node_dir, which is expected to contain
+  /// node<N>/cpulist entries as in /sys/devices/system/node.
+  static numa_topology
+  from_sysfs(const std::string &sysfs_node_dir = "/sys/devices/system/node");
+
+  std::size_t get_num_domains() const { return _domains.size(); }
+  std::size_t get_num_cpus() const;
+
+  /// \return The operating system node id of the domain with the given index
+  int get_node_id(std::size_t domain) const { return _domains[domain].node_id; }
+  const std::vector<int> &get_cpus(std::size_t domain) const {
+    return _domains[domain].cpus;
+  }
+
+  /// \return The domain that thread \c thread of a team of \c num_threads
+  /// threads is assigned to for NUMA-aware execution. Contiguous blocks of
+  /// threads are assigned to the domains in order, so that static schedules,
+  /// which also assign contiguous ranges to threads in order, map
+  /// contiguous parts of the data to the same domain.
+  std::size_t get_domain_of_thread(std::size_t thread,
+                                   std::size_t num_threads) const {
+    return thread * _domains.size() / num_threads;
+  }
+
+  /// Binds the calling thread to the CPUs of the given domain.
+  /// \return Whether the thread was bound. This is only supported on Linux.
+  bool bind_current_thread(std::size_t domain) const;
+
+  /// Parses cpulist syntax as used by the Linux kernel, e.g. "0-3,8,10-11".
+  /// Returns false if the string is malformed.
+  static bool parse_cpu_list(const std::string &cpu_list,
+                             std::vector<int> &out);
+
+private:
+  numa_topology() = default;
+
+  struct domain {
+    int node_id;
+    std::vector<int> cpus;
+  };
+
+  std::vector<domain> _domains;
+};
+
+}
+}
+
+#endif
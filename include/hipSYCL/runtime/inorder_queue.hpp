@@ -80,6 +80,12 @@ public:
 
   virtual result query_status(inorder_queue_status& status) = 0;
 
+  /// \return The invoker used by this queue for SSCP kernels,
+  /// or nullptr if the queue does not support SSCP kernels
+  virtual sscp_code_object_invoker* get_sscp_code_object_invoker() {
+    return nullptr;
+  }
+
   virtual ~inorder_queue(){}
 };
 
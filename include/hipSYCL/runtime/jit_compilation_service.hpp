@@ -0,0 +1,164 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_JIT_COMPILATION_SERVICE_HPP
+#define HIPSYCL_JIT_COMPILATION_SERVICE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "hipSYCL/runtime/error.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Tracks the progress of a batch of compilation tasks that
+/// was submitted using jit_compilation_service::warm_up().
+class jit_warm_up_handle {
+public:
+  jit_warm_up_handle() = default;
+
+  /// \return The number of tasks in the batch
+  std::size_t get_num_tasks() const;
+  /// \return The number of tasks that have finished, including failed tasks
+  std::size_t get_num_completed() const;
+  /// \return The number of tasks that have finished with an error
+  std::size_t get_num_failed() const;
+
+  bool is_complete() const;
+  /// Blocks until all tasks of the batch have finished.
+  void wait() const;
+
+  /// \return The errors of all failed tasks. Only complete once
+  /// is_complete() returns true.
+  std::vector<result> get_errors() const;
+private:
+  friend class jit_compilation_service;
+
+  struct state {
+    std::size_t num_tasks = 0;
+    std::atomic<std::size_t> num_completed{0};
+    std::atomic<std::size_t> num_failed{0};
+    std::function<void(std::size_t, std::size_t)> progress_callback;
+
+    mutable std::mutex mutex;
+    mutable std::condition_variable completion_cv;
+    std::vector<result> errors;
+  };
+
+  explicit jit_warm_up_handle(std::shared_ptr<state> s)
+  : _state{std::move(s)} {}
+
+  std::shared_ptr<state> _state;
+};
+
+/// A pool of worker threads for JIT compilation. This allows
+/// compiling kernels in the background, e.g. to warm up the kernel cache
+/// at application startup, without blocking the threads that submit
+/// work to the runtime.
+///
+/// Worker threads are only started once the first task is submitted.
+/// Their number is controlled by the HIPSYCL_SSCP_JIT_THREADS setting.
+///
+/// Kernels are not compiled in the background implicitly, and the first
+/// launch of a kernel whose code object is not yet cached is not
+/// non-blocking: The backend compiles it while submitting the launch and
+/// waits for it. For CUDA, HIP and Level Zero, this happens on the
+/// runtime's DAG submission thread, delaying subsequent submissions. The
+/// OpenMP backend submits from the queue's worker thread, so only later
+/// operations of the same queue wait. Only kernels that were passed to
+/// warm_up() beforehand avoid this.
+class jit_compilation_service {
+public:
+  using task = std::function<result()>;
+  /// Invoked after each finished warm-up task with the number of
+  /// completed tasks and the total number of tasks of the batch.
+  /// May be invoked concurrently from multiple worker threads.
+  using progress_callback =
+      std::function<void(std::size_t num_completed, std::size_t num_tasks)>;
+
+  /// \param num_threads Number of worker threads. If 0, a default
+  /// based on the number of hardware threads is used.
+  explicit jit_compilation_service(std::size_t num_threads);
+  ~jit_compilation_service();
+
+  jit_compilation_service(const jit_compilation_service&) = delete;
+  jit_compilation_service& operator=(const jit_compilation_service&) = delete;
+
+  static jit_compilation_service& get();
+
+  /// Enqueues a task for execution on a worker thread.
+  std::shared_future<result> submit(task t);
+
+  /// Enqueues a batch of tasks, typically each compiling a kernel
+  /// by calling sscp_code_object_invoker::prepare_kernel().
+  /// Errors of individual tasks are not registered with the
+  /// asynchronous error handler, but can be queried from the returned handle.
+  jit_warm_up_handle warm_up(std::vector<task> tasks,
+                             progress_callback callback = {});
+
+  /// Blocks until all tasks submitted so far have finished.
+  void wait();
+
+  /// Finishes all pending tasks and joins the worker threads. This is
+  /// invoked when the runtime is destroyed, since tasks may use it.
+  /// Workers are started again when the next task is submitted.
+  void shutdown();
+
+  std::size_t get_num_threads() const;
+  /// \return The number of tasks that have been submitted but
+  /// not yet finished.
+  std::size_t get_num_pending_tasks() const;
+private:
+  void start_workers();
+  void work();
+
+  std::size_t _num_threads;
+  std::vector<std::thread> _workers;
+  std::queue<std::packaged_task<result()>> _tasks;
+  std::size_t _num_pending = 0;
+  bool _shutdown = false;
+
+  mutable std::mutex _mutex;
+  // Serializes concurrent shutdown() calls
+  std::mutex _shutdown_mutex;
+  std::condition_variable _task_available;
+  std::condition_variable _all_tasks_done;
+};
+
+}
+}
+
+#endif
@@ -27,14 +27,23 @@
 
 #include <string>
 #include <unordered_map>
+#include <map>
+#include <deque>
+#include <atomic>
 #include <mutex>
 #include <cassert>
+#include <cstdint>
 #include <memory>
+#include <future>
+#include <thread>
+#include <tuple>
 #include "hipSYCL/common/hcf_container.hpp"
 #include "hipSYCL/common/small_map.hpp"
+#include "hipSYCL/common/stable_fast_hash.hpp"
 #include "hipSYCL/glue/kernel_configuration.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/performance_counters.hpp"
 
 #ifndef HIPSYCL_RT_KERNEL_CACHE_HPP
 #define HIPSYCL_RT_KERNEL_CACHE_HPP
@@ -128,8 +137,10 @@ private:
 class hcf_image_info {
 public:
   hcf_image_info() = default;
+  // contained_kernels: The kernels that list this image as provider
   hcf_image_info(const common::hcf_container *hcf,
-                 const common::hcf_container::node *image_node);
+                 const common::hcf_container::node *image_node,
+                 std::vector<std::string> contained_kernels);
 
   const std::vector<std::string>& get_contained_kernels() const;
   // TODO: Maybe better return an enum of allowed formats/variants?
@@ -150,9 +161,16 @@ class hcf_cache {
 public:
   static hcf_cache& get();
 
-  const common::hcf_container* get_hcf(hcf_object_id obj) const;
+  const common::hcf_container* get_hcf(hcf_object_id obj);
   
   hcf_object_id register_hcf_object(const common::hcf_container& obj);
+  hcf_object_id register_hcf_object(common::hcf_container&& obj);
+  // Deferred registration: Only records the location of the HCF data, which
+  // is parsed when the object is first used. This keeps registration during
+  // static initialization cheap. The data must remain valid until the object
+  // is unregistered, and is referenced rather than copied after parsing.
+  hcf_object_id register_hcf_object(hcf_object_id id, const char *data,
+                                    std::size_t size);
   void unregister_hcf_object(hcf_object_id id);
 
   struct device_image_id {
@@ -163,8 +181,10 @@ public:
   using symbol_resolver_list = std::vector<device_image_id>;
   
   template<class Handler>
-  void symbol_lookup(const std::vector<std::string>& names, Handler&& h) const {
+  void symbol_lookup(const std::vector<std::string>& names, Handler&& h) {
     std::lock_guard<std::mutex> lock{_mutex};
+    // Any object might export the symbols
+    load_all_pending_objects();
 
     for(const auto& symbol_name : names) {
       HIPSYCL_DEBUG_INFO << "hcf_cache: Looking up symbol " << symbol_name
@@ -180,37 +200,73 @@ public:
     }
   }
 
+  // Returns the ids of the HCF objects, in ascending order, whose device
+  // image named image_name exports one of the given symbols, or a symbol
+  // imported by such an image in turn. These are the objects that runtime
+  // linking of an image with these imports would draw code from. Like
+  // symbol_lookup(), this parses all pending objects.
+  std::vector<hcf_object_id>
+  get_symbol_providers(const std::vector<std::string> &names,
+                       const std::string &image_name);
+
   const hcf_kernel_info *get_kernel_info(hcf_object_id obj,
-                                         const std::string &kernel_name) const;
+                                         const std::string &kernel_name);
 
   const hcf_image_info *get_image_info(hcf_object_id obj,
-                                       const std::string &image_name) const;
+                                       const std::string &image_name);
+
+  struct registration_statistics {
+    // Number of HCF objects registered (deferred or not)
+    std::size_t num_registered_objects = 0;
+    // Number of HCF objects that have been parsed and indexed
+    std::size_t num_loaded_objects = 0;
+    // Time spent in register_hcf_object(), which typically runs
+    // during static initialization
+    std::uint64_t registration_time_ns = 0;
+    // Time spent parsing and indexing deferred objects on first use
+    std::uint64_t deferred_loading_time_ns = 0;
+  };
+
+  registration_statistics get_registration_statistics() const;
 
 private:
   hcf_cache() = default;
 
+  hcf_object_id register_hcf_object_impl(common::hcf_container &&obj);
+  // These expect _mutex to be locked.
+  void load_pending_object(hcf_object_id id);
+  void load_all_pending_objects();
+
+  struct pending_hcf_object {
+    const char* data;
+    std::size_t size;
+  };
+
+  std::unordered_map<hcf_object_id, pending_hcf_object> _pending_objects;
   std::unordered_map<hcf_object_id, std::unique_ptr<common::hcf_container>>
       _hcf_objects;
   std::unordered_map<std::string, symbol_resolver_list> _exported_symbol_providers;
 
     
-  struct stable_running_pair_hash {
+  struct hcf_pair_hash {
     size_t operator()(const std::pair<hcf_object_id, std::string> &p) const
     {
-      common::stable_running_hash h;
-      h(reinterpret_cast<const void*>(&p.first), sizeof(hcf_object_id));
-      h(static_cast<const void*>(p.second.c_str()), p.second.size());
-      return h.get_current_hash();
+      common::stable_fast_hash h;
+      h(static_cast<uint64_t>(p.first));
+      h(static_cast<const void*>(p.second.data()), p.second.size());
+      return static_cast<size_t>(h.get_current_hash()[0]);
     }
   };
 
   std::unordered_map<std::pair<hcf_object_id, std::string>,
-                     std::unique_ptr<hcf_kernel_info>, stable_running_pair_hash>
+                     std::unique_ptr<hcf_kernel_info>, hcf_pair_hash>
       _hcf_kernel_info;
   std::unordered_map<std::pair<hcf_object_id, std::string>,
-                     std::unique_ptr<hcf_image_info>, stable_running_pair_hash>
+                     std::unique_ptr<hcf_image_info>, hcf_pair_hash>
       _hcf_image_info;
 
+  registration_statistics _statistics;
+
   mutable std::mutex _mutex;
 };
 
@@ -235,8 +291,18 @@ public:
     _kernel_names.push_back(name);
     kernel_name_index_t idx = _kernel_names.size() - 1;
     _kernel_index_map[name] = idx;
+    _kernel_statistics.emplace_back();
   }
 
+  struct kernel_statistics {
+    // Lookups that were served by an existing code object
+    std::uint64_t hits = 0;
+    // Lookups that required constructing a new code object
+    std::uint64_t misses = 0;
+  };
+
+  kernel_statistics get_statistics(kernel_name_index_t kernel_index) const;
+
   template<class KernelT>
   std::string get_global_kernel_name() const {
     return typeid(KernelT).name();
@@ -277,25 +343,22 @@ public:
                                 pred);
   }
 
+  // Constructors are invoked without holding the cache lock, such that
+  // lookups of other kernels can proceed while a kernel is being compiled.
+  // Concurrent requests for the same kernel and configuration wait for the
+  // construction that is already in progress instead of compiling again.
+  //
+  // Objects that have been found once are additionally indexed by
+  // (kernel index, backend, hcf object, configuration id), such that warm
+  // lookups neither take the cache lock nor compare kernel names.
   template <class Constructor, class Predicate>
   const code_object *get_or_construct_code_object(
       kernel_name_index_t kernel_index, const std::string &backend_kernel_name,
       backend_id b, Predicate &&object_selector, Constructor &&c) {
 
-    std::lock_guard<std::mutex> lock{_mutex};
-
-    return get_or_construct_code_object_impl(kernel_index, backend_kernel_name,
-                                             b, object_selector, c);
-  }
-
-  // Only to be used within a Constructor passed to get_or_construct_code_object!
-  template <class Constructor, class Predicate>
-  const code_object *recursive_get_or_construct_code_object(
-      kernel_name_index_t kernel_index, const std::string &backend_kernel_name,
-      backend_id b, Predicate &&object_selector, Constructor &&c) {
-
-    return get_or_construct_code_object_impl(kernel_index, backend_kernel_name,
-                                             b, object_selector, c);
+    return get_or_construct_code_object_impl(
+        kernel_index, backend_kernel_name, b, hcf_object_id{},
+        glue::kernel_configuration::id_type{}, object_selector, c);
   }
 
   template <class Constructor, class Predicate>
@@ -305,6 +368,20 @@ public:
                                backend_id b, hcf_object_id source_object,
                                Predicate &&object_selector, Constructor &&c) {
 
+    return get_or_construct_code_object(
+        kernel_index, backend_kernel_name, b, source_object,
+        glue::kernel_configuration::id_type{}, object_selector, c);
+  }
+
+  // Same as above, but constructions for different configurations of the
+  // same kernel may run concurrently.
+  template <class Constructor, class Predicate>
+  const code_object *get_or_construct_code_object(
+      kernel_name_index_t kernel_index, const std::string &backend_kernel_name,
+      backend_id b, hcf_object_id source_object,
+      const glue::kernel_configuration::id_type &config_id,
+      Predicate &&object_selector, Constructor &&c) {
+
     auto pred = [&](const code_object *obj) {
       if (obj->hcf_source() != source_object)
         return false;
@@ -312,11 +389,24 @@ public:
       return object_selector(obj);
     };
 
+    return get_or_construct_code_object_impl(kernel_index, backend_kernel_name,
+                                             b, source_object, config_id, pred,
+                                             c);
+  }
+
+  // Since constructors no longer run with the cache lock held, these are
+  // equivalent to get_or_construct_code_object(). A constructor may request
+  // another object for the same kernel; this is then constructed directly
+  // on the calling thread.
+  template <class Constructor, class Predicate>
+  const code_object *recursive_get_or_construct_code_object(
+      kernel_name_index_t kernel_index, const std::string &backend_kernel_name,
+      backend_id b, Predicate &&object_selector, Constructor &&c) {
+
     return get_or_construct_code_object(kernel_index, backend_kernel_name, b,
-                                        pred, c);
+                                        object_selector, c);
   }
 
-  // Only to be used within a Constructor passed to get_or_construct_code_object!
   template <class Constructor, class Predicate>
   const code_object *
   recursive_get_or_construct_code_object(kernel_name_index_t kernel_index,
@@ -324,15 +414,8 @@ public:
                                backend_id b, hcf_object_id source_object,
                                Predicate &&object_selector, Constructor &&c) {
 
-    auto pred = [&](const code_object *obj) {
-      if (obj->hcf_source() != source_object)
-        return false;
-
-      return object_selector(obj);
-    };
-
-    return recursive_get_or_construct_code_object(
-        kernel_index, backend_kernel_name, b, pred, c);
+    return get_or_construct_code_object(kernel_index, backend_kernel_name, b,
+                                        source_object, object_selector, c);
   }
 
   // Unload entire cache and release resources to prepare runtime shutdown.
@@ -390,38 +473,234 @@ private:
     return nullptr;
   }
 
+  struct code_object_key {
+    kernel_name_index_t kernel_index;
+    backend_id backend;
+    hcf_object_id hcf_object;
+    glue::kernel_configuration::id_type config_id;
+
+    std::uint64_t hash() const {
+      std::uint64_t h = mix(kernel_index);
+      h = mix(h ^ static_cast<std::uint64_t>(backend));
+      h = mix(h ^ hcf_object);
+      h = mix(h ^ config_id[0]);
+      return mix(h ^ config_id[1]);
+    }
+
+    bool operator==(const code_object_key &other) const {
+      return kernel_index == other.kernel_index && backend == other.backend &&
+             hcf_object == other.hcf_object && config_id == other.config_id;
+    }
+
+  private:
+    // splitmix64 finalizer
+    static std::uint64_t mix(std::uint64_t x) {
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+      return x ^ (x >> 31);
+    }
+  };
+
+  // Open addressing hash table that maps keys to code objects. Entries are
+  // only ever added (by writers holding the cache lock) and published by
+  // the release store of the object pointer, so readers need no locks.
+  // When the table fills up, a larger copy is published; old tables are
+  // retained as long as the cache exists since readers may still be using
+  // them.
+  struct code_object_lookup_table {
+    struct entry {
+      std::uint64_t hash;
+      code_object_key key;
+      std::atomic<const code_object *> obj{nullptr};
+    };
+
+    explicit code_object_lookup_table(std::size_t capacity)
+        : mask{capacity - 1}, entries{new entry[capacity]} {}
+
+    std::size_t mask;
+    std::size_t num_entries = 0;
+    std::unique_ptr<entry[]> entries;
+  };
+
+  template <class Predicate>
+  const code_object *lookup_code_object(const code_object_key &key,
+                                        std::uint64_t hash,
+                                        Predicate &&object_selector) const {
+    const code_object_lookup_table *table =
+        _lookup_table.load(std::memory_order_acquire);
+    if(!table)
+      return nullptr;
+    // Multiple objects may share a key (e.g. for different devices),
+    // so all matching entries until the next free slot are candidates.
+    for(std::size_t i = hash & table->mask;; i = (i + 1) & table->mask) {
+      const auto &e = table->entries[i];
+      const code_object *obj = e.obj.load(std::memory_order_acquire);
+      if(!obj)
+        return nullptr;
+      if(e.hash == hash && e.key == key && object_selector(obj))
+        return obj;
+    }
+  }
+
+  // Requires the cache lock
+  void insert_code_object(const code_object_key &key, std::uint64_t hash,
+                          const code_object *obj) {
+    code_object_lookup_table *table =
+        _lookup_table.load(std::memory_order_relaxed);
+    // Keep the load factor at most 1/2, so that probing always terminates
+    // quickly.
+    if(!table || 2 * (table->num_entries + 1) > table->mask + 1) {
+      std::size_t capacity = table ? 2 * (table->mask + 1) : 64;
+      std::unique_ptr<code_object_lookup_table> new_table{
+          new code_object_lookup_table{capacity}};
+      if(table) {
+        for(std::size_t i = 0; i <= table->mask; ++i) {
+          const auto &e = table->entries[i];
+          if(const code_object *existing =
+                 e.obj.load(std::memory_order_relaxed))
+            insert_code_object(*new_table, e.key, e.hash, existing);
+        }
+      }
+      table = new_table.get();
+      _retired_lookup_tables.push_back(std::move(new_table));
+      _lookup_table.store(table, std::memory_order_release);
+    }
+    insert_code_object(*table, key, hash, obj);
+  }
+
+  static void insert_code_object(code_object_lookup_table &table,
+                                 const code_object_key &key,
+                                 std::uint64_t hash, const code_object *obj) {
+    for(std::size_t i = hash & table.mask;; i = (i + 1) & table.mask) {
+      auto &e = table.entries[i];
+      const code_object *existing = e.obj.load(std::memory_order_relaxed);
+      if(existing == obj)
+        return;
+      if(!existing) {
+        e.hash = hash;
+        e.key = key;
+        e.obj.store(obj, std::memory_order_release);
+        ++table.num_entries;
+        return;
+      }
+    }
+  }
+
   template <class Constructor, class Predicate>
   const code_object *get_or_construct_code_object_impl(
       kernel_name_index_t kernel_index, const std::string &backend_kernel_name,
-      backend_id b, Predicate &&object_selector, Constructor &&c) {
-
-    const code_object *obj = get_code_object_impl(
-        kernel_index, backend_kernel_name, b, object_selector);
-    if(obj) {
-      HIPSYCL_DEBUG_INFO << "kernel_cache: cache hit for kernel index "
-                         << kernel_index << " and backend kernel name "
-                         << backend_kernel_name << std::endl;
+      backend_id b, hcf_object_id source_object,
+      const glue::kernel_configuration::id_type &config_id,
+      Predicate &&object_selector, Constructor &&c) {
+
+    assert(kernel_index < _kernel_statistics.size());
+    kernel_statistics_counters &stats = _kernel_statistics[kernel_index];
+
+    const code_object_key lookup_key{kernel_index, b, source_object,
+                                     config_id};
+    const std::uint64_t lookup_hash = lookup_key.hash();
+    if(const code_object *obj =
+           lookup_code_object(lookup_key, lookup_hash, object_selector)) {
+      stats.hits.fetch_add(1, std::memory_order_relaxed);
+      performance_counters::get().kernel_cache_lookup(true);
       return obj;
-    } else {
-      HIPSYCL_DEBUG_INFO << "kernel_cache: cache MISS; constructing new object "
-                            "for kernel index "
+    }
+
+    construction_key key{b, kernel_index, backend_kernel_name, config_id};
+    bool is_nested_construction = false;
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    for(;;) {
+      const code_object *obj = get_code_object_impl(
+          kernel_index, backend_kernel_name, b, object_selector);
+      if(obj) {
+        HIPSYCL_DEBUG_INFO << "kernel_cache: cache hit for kernel index "
+                           << kernel_index << " and backend kernel name "
+                           << backend_kernel_name << std::endl;
+        insert_code_object(lookup_key, lookup_hash, obj);
+        stats.hits.fetch_add(1, std::memory_order_relaxed);
+        performance_counters::get().kernel_cache_lookup(true);
+        return obj;
+      }
+
+      auto it = _constructions_in_progress.find(key);
+      if(it == _constructions_in_progress.end())
+        break;
+      if(it->second.owner == std::this_thread::get_id()) {
+        // We are being called from a constructor for the same key
+        // (e.g. to obtain a source object for an executable object).
+        // Waiting would deadlock, so construct directly.
+        is_nested_construction = true;
+        break;
+      }
+
+      HIPSYCL_DEBUG_INFO << "kernel_cache: Waiting for construction of "
+                            "object for kernel index "
                          << kernel_index << " and backend kernel name "
                          << backend_kernel_name << std::endl;
+      // Wait for the other thread to finish, then look again - the
+      // constructed object might not satisfy our predicate, or the
+      // construction might have failed.
+      std::shared_future<void> construction = it->second.done;
+      lock.unlock();
+      construction.wait();
+      lock.lock();
     }
-    
-    // We haven't found the requested object: Construct new code object
-    const code_object* new_obj = c();
+
+    HIPSYCL_DEBUG_INFO << "kernel_cache: cache MISS; constructing new object "
+                          "for kernel index "
+                       << kernel_index << " and backend kernel name "
+                       << backend_kernel_name << std::endl;
+
+    std::promise<void> construction_done;
+    if(!is_nested_construction) {
+      _constructions_in_progress[key] = construction_in_progress{
+          std::this_thread::get_id(), construction_done.get_future().share()};
+    }
+
+    // Unblocks threads waiting for this construction. They look up the
+    // object again and construct it themselves if it is still missing.
+    // Requires the lock to be held.
+    auto finish_construction = [&]() {
+      if(!is_nested_construction) {
+        _constructions_in_progress.erase(key);
+        construction_done.set_value();
+      }
+    };
+
+    // We haven't found the requested object: Construct new code object.
+    // Other threads may meanwhile use the cache.
+    lock.unlock();
+    const code_object* new_obj = nullptr;
+    try {
+      new_obj = c();
+    } catch(...) {
+      lock.lock();
+      finish_construction();
+      throw;
+    }
+    lock.lock();
+
     if(new_obj) {
       _code_objects.emplace_back(code_object_ptr{new_obj});
       code_object_index_t new_cidx = _code_objects.size() - 1;
 
-      _kernel_code_objects[b][kernel_index].push_back(new_cidx);
+      auto& backend_code_objects = _kernel_code_objects[b];
+      if(backend_code_objects.size() != _kernel_names.size())
+        backend_code_objects.resize(_kernel_names.size());
+      backend_code_objects[kernel_index].push_back(new_cidx);
+
+      insert_code_object(lookup_key, lookup_hash, new_obj);
     } else {
       register_error(
           __hipsycl_here(),
           error_info{"kernel_cache: code object creation has failed"});
     }
 
+    finish_construction();
+    stats.misses.fetch_add(1, std::memory_order_relaxed);
+    performance_counters::get().kernel_cache_lookup(false);
+
     return new_obj;
   }
 
@@ -438,6 +717,30 @@ private:
 
   std::vector<code_object_ptr> _code_objects;
 
+  using construction_key =
+      std::tuple<backend_id, kernel_name_index_t, std::string,
+                 glue::kernel_configuration::id_type>;
+
+  struct construction_in_progress {
+    std::thread::id owner;
+    std::shared_future<void> done;
+  };
+
+  std::map<construction_key, construction_in_progress>
+      _constructions_in_progress;
+
+  std::atomic<code_object_lookup_table *> _lookup_table{nullptr};
+  // Owns the current and all previous lookup tables
+  std::vector<std::unique_ptr<code_object_lookup_table>> _retired_lookup_tables;
+
+  struct kernel_statistics_counters {
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+  };
+  // Indexed by kernel_name_index_t. deque, so that registering further
+  // kernels does not move counters that might be in use.
+  std::deque<kernel_statistics_counters> _kernel_statistics;
+
   kernel_cache() = default;
 
   mutable std::mutex _mutex;
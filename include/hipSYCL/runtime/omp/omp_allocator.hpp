@@ -28,7 +28,11 @@
 #ifndef HIPSYCL_OMP_ALLOCATOR_HPP
 #define HIPSYCL_OMP_ALLOCATOR_HPP
 
+#include <memory>
+
 #include "../allocator.hpp"
+#include "../generic/async_worker.hpp"
+#include "../hw_model/numa.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -36,7 +40,11 @@ namespace rt {
 class omp_allocator : public backend_allocator 
 {
 public:
-  omp_allocator(const device_id &my_device);
+  /// \param numa_topology If not null, large allocations are initialized
+  /// by OpenMP threads that are bound to the NUMA domains of this topology
+  /// in the same way as those of omp_queue.
+  omp_allocator(const device_id &my_device,
+                const numa_topology *numa_topology = nullptr);
   
   virtual void* allocate(size_t min_alignment, size_t size_bytes) override;
 
@@ -54,7 +62,13 @@ public:
   virtual result mem_advise(const void *addr, std::size_t num_bytes,
                             int advise) const override;
 private:
+  void first_touch(void* mem, std::size_t size_bytes) const;
+
   device_id _my_device;
+  std::size_t _page_size;
+  // Only exists if first touch is enabled. Its OpenMP team is
+  // bound to NUMA domains.
+  std::unique_ptr<worker_thread> _first_touch_worker;
 };
 
 }
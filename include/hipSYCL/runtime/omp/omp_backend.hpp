@@ -28,8 +28,11 @@
 #ifndef HIPSYCL_OMP_BACKEND_HPP
 #define HIPSYCL_OMP_BACKEND_HPP
 
+#include <optional>
+
 #include "../backend.hpp"
 #include "../multi_queue_executor.hpp"
+#include "../generic/async_worker.hpp"
 #include "omp_allocator.hpp"
 #include "omp_hardware_manager.hpp"
 
@@ -57,8 +60,15 @@ public:
   std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) override;
 private:
+  const numa_topology* get_numa_topology() const;
+
+  // Only set if NUMA-aware execution is enabled
+  std::optional<numa_topology> _numa_topology;
   mutable omp_allocator _allocator;
   mutable omp_hardware_manager _hw;
+  // Shared by all queues, so that kernels of higher-priority
+  // queues are executed first
+  mutable priority_arbiter _priority_arbiter;
   mutable multi_queue_executor _executor;
 }; 
 
@@ -0,0 +1,96 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_OMP_CODE_OBJECT_HPP
+#define HIPSYCL_OMP_CODE_OBJECT_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hipSYCL/glue/kernel_configuration.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/HostKernelABI.hpp"
+
+namespace hipsycl {
+
+namespace compiler {
+namespace host {
+class HostJITModule;
+}
+}
+
+namespace rt {
+
+/// Native host code generated by the SSCP LLVMToHost translator
+/// and loaded into the process.
+class omp_sscp_executable_object : public code_object {
+public:
+  struct kernel_entry {
+    compiler::host::KernelEntrypoint entrypoint = nullptr;
+    std::size_t static_local_mem_size = 0;
+  };
+
+  omp_sscp_executable_object(const std::string &object_file,
+                             hcf_object_id hcf_source,
+                             const std::vector<std::string> &kernel_names,
+                             const glue::kernel_configuration &config);
+  virtual ~omp_sscp_executable_object();
+
+  result get_build_result() const;
+
+  virtual code_object_state state() const override;
+  virtual code_format format() const override;
+  virtual backend_id managing_backend() const override;
+  virtual hcf_object_id hcf_source() const override;
+  virtual std::string target_arch() const override;
+  virtual compilation_flow source_compilation_flow() const override;
+  virtual glue::kernel_configuration::id_type configuration_id() const override;
+
+  virtual std::vector<std::string>
+  supported_backend_kernel_names() const override;
+  virtual bool contains(const std::string &backend_kernel_name) const override;
+
+  /// \return nullptr if the kernel is not part of this object
+  const kernel_entry* get_kernel(const std::string& kernel_name) const;
+private:
+  result build(const std::string& object_file);
+
+  hcf_object_id _hcf;
+  std::vector<std::string> _kernel_names;
+  glue::kernel_configuration::id_type _id;
+  result _build_result;
+  std::unique_ptr<compiler::host::HostJITModule> _module;
+  std::unordered_map<std::string, kernel_entry> _kernels;
+};
+
+}
+}
+
+#endif
@@ -44,6 +44,7 @@ public:
 
   virtual bool is_complete() const override;
   virtual void wait() override;
+  virtual bool notify_on_completion(std::function<void()> callback) override;
 
   std::shared_ptr<signal_channel> get_signal_channel() const;
 
@@ -0,0 +1,53 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_OMP_FILL_HPP
+#define HIPSYCL_OMP_FILL_HPP
+
+#include <cstddef>
+
+namespace hipsycl {
+namespace rt {
+
+/// Fills \c num_bytes starting at \c ptr with a repeating pattern of
+/// \c pattern_size bytes, which must be 1, 2, 4, 8 or 16.
+///
+/// Large fills are split across the calling thread's OpenMP team with a
+/// static schedule over contiguous chunks. When this runs on the same team
+/// as kernels, pages touched first by the fill end up in the NUMA domain
+/// of the threads that access them in kernels with a similar static
+/// decomposition.
+/// Fills of at least \c streaming_threshold bytes use non-temporal stores
+/// where available, to avoid evicting the working set from the cache.
+void omp_fill(void *ptr, std::size_t num_bytes, const unsigned char *pattern,
+              std::size_t pattern_size, std::size_t streaming_threshold);
+
+}
+}
+
+#endif
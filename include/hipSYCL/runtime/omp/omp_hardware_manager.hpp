@@ -29,13 +29,23 @@
 #define HIPSYCL_OMP_HARDWARE_MANAGER_HPP
 
 #include "../hardware.hpp"
+#include "../hw_model/numa.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+/// Binds thread t of the calling thread's OpenMP team to the CPUs of NUMA
+/// domain topology.get_domain_of_thread(t, team size). The OpenMP runtime
+/// reuses these threads for later parallel regions of the calling thread,
+/// so the binding persists for its kernels and fills. Does nothing if the
+/// topology consists of a single domain.
+void bind_omp_team_to_numa_domains(const numa_topology &topology);
+
 class omp_hardware_context : public hardware_context
 {
 public:
+  omp_hardware_context();
+
   virtual bool is_cpu() const override;
   virtual bool is_gpu() const override;
 
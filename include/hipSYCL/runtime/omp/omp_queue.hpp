@@ -31,15 +31,48 @@
 #include "../generic/async_worker.hpp"
 #include "../executor.hpp"
 #include "../inorder_queue.hpp"
+#include "hipSYCL/runtime/code_object_invoker.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/hw_model/numa.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+class omp_queue;
+
+class omp_sscp_code_object_invoker : public sscp_code_object_invoker {
+public:
+  omp_sscp_code_object_invoker(omp_queue* q)
+  : _queue{q} {}
+
+  virtual ~omp_sscp_code_object_invoker(){}
+
+  virtual result submit_kernel(const kernel_operation& op,
+                               const sscp_kernel_id &kernel_id,
+                               const rt::range<3> &num_groups,
+                               const rt::range<3> &group_size,
+                               unsigned local_mem_size, void **args,
+                               std::size_t *arg_sizes, std::size_t num_args,
+                               const glue::kernel_configuration& config) override;
+
+  virtual result prepare_kernel(hcf_object_id hcf_object,
+                                const std::string &global_kernel_name,
+                                const std::string &kernel_name,
+                                unsigned local_mem_size,
+                                const glue::kernel_configuration &config) override;
+private:
+  omp_queue* _queue;
+};
+
 class omp_queue : public inorder_queue
 {
 public:
-  omp_queue(backend_id id);
+  /// \param arbiter If not null, kernel execution is ordered by \c priority
+  /// against other queues sharing the arbiter.
+  /// \param numa_topology If not null, the OpenMP threads that execute
+  /// operations are bound to NUMA domains of this topology.
+  omp_queue(backend_id id, priority_arbiter *arbiter = nullptr,
+            int priority = 0, const numa_topology *numa_topology = nullptr);
   virtual ~omp_queue();
 
   /// Inserts an event into the stream
@@ -62,11 +95,31 @@ public:
   virtual void *get_native_type() const override;
 
   virtual result query_status(inorder_queue_status& status) override;
+
+  virtual sscp_code_object_invoker* get_sscp_code_object_invoker() override;
   
   worker_thread& get_worker();
+
+  /// Compiles (if necessary) and executes an SSCP kernel. Must be called
+  /// from the worker thread.
+  result submit_sscp_kernel_from_code_object(
+      const kernel_operation &op, const sscp_kernel_id &kernel_id,
+      const rt::range<3> &num_groups, const rt::range<3> &group_size,
+      unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+      std::size_t num_args,
+      const glue::kernel_configuration &config);
+
+  /// Obtains the code object containing an SSCP kernel from the kernel
+  /// cache, compiling it if necessary. Can be called from any thread.
+  result get_sscp_code_object(const sscp_kernel_id &kernel_id,
+                              const glue::kernel_configuration &config,
+                              const code_object *&obj_out);
 private:
   backend_id _backend_id;
   worker_thread _worker;
+  priority_arbiter* _arbiter;
+  int _priority;
+  omp_sscp_code_object_invoker _sscp_code_object_invoker;
 };
 
 }
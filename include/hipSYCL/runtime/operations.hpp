@@ -93,6 +93,11 @@ public:
 
   virtual result dispatch(operation_dispatcher* dispatch, dag_node_ptr node) = 0;
 
+  // Invoked once the operation is known to have completed. Operations can
+  // drop references here that are only needed for execution, such that
+  // completed parts of the DAG can be freed even if the node stays alive.
+  virtual void release_dependencies() {}
+
   instrumentation_set &get_instrumentations();
   const instrumentation_set &get_instrumentations() const;
 
@@ -155,7 +160,8 @@ public:
                             sycl::access::target access_target)
       : _mem_region{mem_region}, _element_size{mem_region->get_element_size()},
         _mode{access_mode}, _target{access_target}, _dimensions{Dim},
-        _device_data_location{nullptr}, _bound_embedded_ptr_id{0}
+        _view_offset{0, 0, 0}, _device_data_location{nullptr},
+        _bound_embedded_ptr_id{0}
   {
     static_assert(Dim >= 1 && Dim <=3, 
       "dimension of buffer memory requirement must be between 1 and 3");
@@ -250,6 +256,24 @@ public:
     return _device_data_location;
   }
 
+  /// Requirements of sub-buffer accessors refer to a view into the
+  /// data region starting at \c view_offset. Bound embedded pointers
+  /// then point to the start of the view instead of the allocation.
+  void set_view_offset(id<3> view_offset) {
+    _view_offset = view_offset;
+  }
+
+  id<3> get_view_offset3d() const {
+    return _view_offset;
+  }
+
+  /// \return The pointer that bound embedded pointers are initialized with,
+  /// i.e. the device pointer shifted to the start of the view.
+  void* get_bound_ptr() const {
+    return static_cast<char *>(get_device_ptr()) +
+           _mem_region->get_byte_offset(_view_offset);
+  }
+
   void bind(glue::unique_id uid) {
     if(is_bound()) {
       HIPSYCL_DEBUG_WARNING
@@ -279,7 +303,7 @@ public:
                            << this << std::endl;
 
         return glue::kernel_blob::initialize_embedded_pointer(
-                blob, _bound_embedded_ptr_id, get_device_ptr());
+                blob, _bound_embedded_ptr_id, get_bound_ptr());
       }
     }
     return false;
@@ -315,6 +339,7 @@ private:
   sycl::access::mode _mode;
   sycl::access::target _target;
   int _dimensions;
+  id<3> _view_offset;
 
   void* _device_data_location;
   glue::unique_id _bound_embedded_ptr_id;
@@ -327,9 +352,12 @@ class requirements_list;
 class kernel_operation : public operation
 {
 public:
+  /// \param counters The performance counters of this kernel, or nullptr
+  /// if performance counters are disabled
   kernel_operation(const std::string& kernel_name,
                   std::vector<std::unique_ptr<backend_kernel_launcher>> kernels,
-                  const requirements_list& requirements);
+                  const requirements_list& requirements,
+                  performance_counters::kernel_counters* counters = nullptr);
 
   kernel_launcher& get_launcher();
   const kernel_launcher& get_launcher() const;
@@ -374,13 +402,21 @@ public:
   const std::string& get_global_kernel_name() const {
     return _kernel_name;
   }
+
+  performance_counters::kernel_counters* get_performance_counters() const {
+    return _performance_counters;
+  }
+
+  void release_dependencies() override;
 private:
   std::string _kernel_name;
   kernel_launcher _launcher;
+  performance_counters::kernel_counters* _performance_counters;
   // We store shared_ptr to the memory requirement nodes to make sure
-  // that they are alive as long as kernel operations live.
+  // that they are alive until the kernel has been launched.
   // This is required to guarantee the functionality of
-  // initialize_embedded_pointers()
+  // initialize_embedded_pointers(). They are released
+  // by release_dependencies() once the kernel has completed.
   std::vector<dag_node_ptr> _requirements;
 };
 
@@ -495,23 +531,46 @@ private:
 /// USM memset
 class memset_operation : public operation {
 public:
+  /// Largest pattern that can be repeated by a memset operation
+  static constexpr std::size_t max_pattern_size = 16;
+
   memset_operation(void *ptr, unsigned char pattern, std::size_t num_bytes)
-      : _ptr{ptr}, _pattern{pattern}, _num_bytes{num_bytes} {}
+      : _ptr{ptr}, _pattern{pattern}, _pattern_size{1},
+        _num_bytes{num_bytes} {}
+
+  /// Repeats a pattern of \c pattern_size bytes, which must divide
+  /// \c max_pattern_size. Backends other than the host backend only
+  /// support single-byte patterns.
+  memset_operation(void *ptr, const void *pattern, std::size_t pattern_size,
+                   std::size_t num_bytes);
+
+  /// Fills the data accessed by a buffer requirement instead of a
+  /// pointer. The accessed range must be contiguous; the pointer is
+  /// only resolved at dispatch, once memory has been allocated.
+  memset_operation(dag_node_ptr buffer_requirement, const void *pattern,
+                   std::size_t pattern_size, std::size_t num_bytes);
 
   result dispatch(operation_dispatcher *dispatcher,
                   dag_node_ptr node) final override {
     return dispatcher->dispatch_memset(this, node);
   }
 
-  void *get_pointer() const { return _ptr; }
-  unsigned char get_pattern() const { return _pattern; }
+  void *get_pointer() const;
+  unsigned char get_pattern() const { return _pattern[0]; }
+  const unsigned char *get_pattern_data() const { return _pattern; }
+  std::size_t get_pattern_size() const { return _pattern_size; }
   std::size_t get_num_bytes() const { return _num_bytes; }
 
+  void release_dependencies() override;
+
   void dump(std::ostream&, int = 0) const override;
 private:
   void *_ptr;
-  unsigned char _pattern;
+  unsigned char _pattern[max_pattern_size];
+  std::size_t _pattern_size;
   std::size_t _num_bytes;
+  // Keeps the requirement alive until the pointer has been resolved
+  dag_node_ptr _buffer_requirement;
 };
 
 
@@ -641,9 +700,15 @@ public:
   void add_node_requirement(dag_node_ptr node);
 
   const std::vector<dag_node_ptr>& get() const;
+
+  /// \return Whether the node was created by this list from a requirement
+  /// passed to \c add_requirement(), as opposed to an existing node that
+  /// was added as a dependency with \c add_node_requirement().
+  bool is_own_requirement(const dag_node_ptr& node) const;
   
 private:
   std::vector<dag_node_ptr> _reqs;
+  std::vector<dag_node*> _own_reqs;
   runtime* _rt;
 };
 
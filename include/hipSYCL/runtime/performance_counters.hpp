@@ -0,0 +1,225 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_RT_PERFORMANCE_COUNTERS_HPP
+#define HIPSYCL_RT_PERFORMANCE_COUNTERS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hipSYCL/runtime/device_id.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Lock-free histogram of durations with four buckets per power of two,
+/// i.e. percentiles are accurate to within 25%.
+class duration_histogram {
+public:
+  void add(uint64_t ns);
+
+  uint64_t get_count() const;
+  uint64_t get_total() const;
+  uint64_t get_max() const;
+  /// \return An upper bound of the given percentile (0 < p <= 1)
+  uint64_t get_percentile(double p) const;
+private:
+  static constexpr int sub_buckets = 4;
+  static constexpr int num_buckets = 64 * sub_buckets;
+
+  static int get_bucket(uint64_t ns);
+  static uint64_t get_bucket_upper_bound(int bucket);
+
+  std::array<std::atomic<uint64_t>, num_buckets> _buckets{};
+  std::atomic<uint64_t> _count{0};
+  std::atomic<uint64_t> _total{0};
+  std::atomic<uint64_t> _max{0};
+};
+
+struct kernel_performance_statistics {
+  std::string kernel_name;
+  uint64_t num_launches = 0;
+  // Only available for backends that can time kernels on the host
+  // (currently the OpenMP backend)
+  uint64_t num_timed_executions = 0;
+  uint64_t total_execution_time_ns = 0;
+  uint64_t mean_execution_time_ns = 0;
+  uint64_t p99_execution_time_ns = 0;
+  uint64_t max_execution_time_ns = 0;
+};
+
+struct transfer_performance_statistics {
+  device_id source;
+  device_id dest;
+  uint64_t num_transfers = 0;
+  uint64_t num_bytes = 0;
+};
+
+struct allocation_performance_statistics {
+  device_id dev;
+  uint64_t num_allocations = 0;
+  uint64_t num_bytes = 0;
+};
+
+struct performance_counter_snapshot {
+  std::vector<kernel_performance_statistics> kernels;
+  std::vector<transfer_performance_statistics> transfers;
+  std::vector<allocation_performance_statistics> allocations;
+
+  uint64_t dag_nodes_built = 0;
+  uint64_t dag_nodes_flushed = 0;
+  uint64_t requirement_edges_pruned = 0;
+  uint64_t kernel_cache_hits = 0;
+  uint64_t kernel_cache_misses = 0;
+  uint64_t persistent_kernel_cache_hits = 0;
+  uint64_t persistent_kernel_cache_misses = 0;
+
+  void dump(std::ostream &out) const;
+};
+
+/// Aggregated runtime statistics. Counters are updated with relaxed
+/// atomics; the maps for per-device and per-transfer statistics are only
+/// locked exclusively when a new key is seen. Per-kernel counters are
+/// resolved once per kernel with get_kernel_counters() and then updated
+/// without any lookup.
+///
+/// The global instance is enabled with HIPSYCL_PERFORMANCE_COUNTERS and
+/// prints its statistics on exit. When disabled, the record functions
+/// return immediately.
+class performance_counters {
+public:
+  class kernel_counters {
+  public:
+    void kernel_launched() {
+      _num_launches.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void kernel_executed(uint64_t duration_ns) {
+      _execution_times.add(duration_ns);
+    }
+  private:
+    friend class performance_counters;
+
+    std::atomic<uint64_t> _num_launches{0};
+    duration_histogram _execution_times;
+  };
+
+  explicit performance_counters(bool enabled);
+
+  static performance_counters &get();
+
+  bool is_enabled() const { return _enabled; }
+
+  /// \return The counters of the given kernel, or nullptr if this object
+  /// is disabled. The counters remain valid as long as this object exists.
+  kernel_counters *get_kernel_counters(const std::string &kernel_name);
+
+  void memcpy_submitted(const device_id &source, const device_id &dest,
+                        std::size_t num_bytes);
+  void memory_allocated(const device_id &dev, std::size_t num_bytes);
+
+  void dag_node_built() {
+    if(_enabled)
+      _dag_nodes_built.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void dag_nodes_flushed(std::size_t num_nodes) {
+    if(_enabled)
+      _dag_nodes_flushed.fetch_add(num_nodes, std::memory_order_relaxed);
+  }
+
+  void requirement_edge_pruned() {
+    if(_enabled)
+      _requirement_edges_pruned.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void kernel_cache_lookup(bool is_hit) {
+    if(_enabled)
+      (is_hit ? _kernel_cache_hits : _kernel_cache_misses)
+          .fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void persistent_kernel_cache_lookup(bool is_hit) {
+    if(_enabled)
+      (is_hit ? _persistent_kernel_cache_hits : _persistent_kernel_cache_misses)
+          .fetch_add(1, std::memory_order_relaxed);
+  }
+
+  performance_counter_snapshot get_snapshot() const;
+  /// Prints the current statistics. If this has been called explicitly,
+  /// they are not printed again on exit.
+  void dump(std::ostream &out);
+private:
+  struct transfer_counters {
+    device_id source;
+    device_id dest;
+    std::atomic<uint64_t> num_transfers{0};
+    std::atomic<uint64_t> num_bytes{0};
+  };
+
+  struct allocation_counters {
+    device_id dev;
+    std::atomic<uint64_t> num_allocations{0};
+    std::atomic<uint64_t> num_bytes{0};
+  };
+
+  transfer_counters &get_transfer_counters(const device_id &source,
+                                           const device_id &dest);
+  allocation_counters &get_allocation_counters(const device_id &dev);
+
+  const bool _enabled;
+  std::atomic<bool> _was_dumped{false};
+
+  std::atomic<uint64_t> _dag_nodes_built{0};
+  std::atomic<uint64_t> _dag_nodes_flushed{0};
+  std::atomic<uint64_t> _requirement_edges_pruned{0};
+  std::atomic<uint64_t> _kernel_cache_hits{0};
+  std::atomic<uint64_t> _kernel_cache_misses{0};
+  std::atomic<uint64_t> _persistent_kernel_cache_hits{0};
+  std::atomic<uint64_t> _persistent_kernel_cache_misses{0};
+
+  mutable std::shared_mutex _mutex;
+  // deques, such that references remain valid when new entries are added
+  std::unordered_map<std::string, std::size_t> _kernel_indices;
+  std::deque<kernel_counters> _kernels;
+  std::vector<std::string> _kernel_names;
+  std::deque<transfer_counters> _transfers;
+  std::deque<allocation_counters> _allocations;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_PERSISTENT_KERNEL_CACHE_HPP
+#define HIPSYCL_PERSISTENT_KERNEL_CACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "hipSYCL/runtime/error.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// On-disk cache for JIT-compiled device code, such that binaries
+/// produced by e.g. the SSCP flow can be reused across application runs.
+///
+/// Entries are identified by a key string that must describe everything
+/// that influences the compilation result (HCF object, image, backend,
+/// target, build options, kernel configuration, compiler version).
+/// The key is hashed to obtain the file name, and the full key is stored
+/// inside the file as well, such that hash collisions are detected.
+///
+/// Files are written to a temporary file first and then renamed, so
+/// concurrent processes sharing a cache directory never observe partially
+/// written entries. If the total size of the cache exceeds the configured
+/// maximum size, least recently used entries are removed.
+class persistent_kernel_cache {
+public:
+  using compiler_function = std::function<result(std::string &)>;
+
+  /// \param directory The cache directory. If empty, the cache is disabled.
+  /// \param max_size Maximum total size of all cache entries in bytes.
+  persistent_kernel_cache(const std::string &directory, std::size_t max_size);
+
+  /// Returns the process-wide cache as configured by the
+  /// \c HIPSYCL_SSCP_JIT_CACHE_DIRECTORY and
+  /// \c HIPSYCL_SSCP_JIT_CACHE_MAX_SIZE settings.
+  static persistent_kernel_cache &get();
+
+  bool is_enabled() const { return !_directory.empty(); }
+  const std::string &get_directory() const { return _directory; }
+  std::size_t get_max_size() const { return _max_size; }
+
+  /// Attempts to load the entry for \c key into \c out.
+  /// \return whether the entry was found.
+  bool load(const std::string &key, std::string &out) const;
+
+  /// Stores \c data under \c key, and evicts old entries if required.
+  /// \return whether the entry was successfully written.
+  bool store(const std::string &key, const std::string &data);
+
+  /// Loads the entry for \c key if it exists; otherwise invokes
+  /// \c compiler and stores its output on success.
+  result get_or_compile(const std::string &key, std::string &out,
+                        const compiler_function &compiler);
+
+  /// Removes least recently used entries until the total size of the cache
+  /// is at most \c max_size bytes.
+  void evict(std::size_t max_size);
+
+  /// \return the total size of all cache entries in bytes
+  std::size_t get_current_size() const;
+
+  /// \return The name of the file (without directory) used for \c key.
+  static std::string get_entry_filename(const std::string &key);
+
+private:
+  std::string get_entry_path(const std::string& key) const;
+
+  std::string _directory;
+  std::size_t _max_size;
+  mutable std::mutex _mutex;
+};
+
+}
+}
+
+#endif
@@ -74,6 +74,17 @@ public:
     _is_complete = true;
   }
 
+  virtual bool notify_on_completion(std::function<void()> callback) override {
+    if(_is_complete) {
+      callback();
+      return true;
+    }
+    // Without a fine-grained event, we would need to query the queue.
+    if(_has_fine_grained_event)
+      return _fine_grained_event->notify_on_completion(std::move(callback));
+    return false;
+  }
+
   // This function is currently not thread-safe and should not be
   // invoked by multiple threads
   virtual FineGrainedBackendEventT request_backend_event() override {
@@ -43,10 +43,12 @@ namespace rt {
 
 enum class scheduler_type { direct, unbound };
 enum class default_selector_behavior { strict, multigpu, system };
+enum class dag_flush_policy { eager, batched, adaptive };
 
 std::istream &operator>>(std::istream &istr, scheduler_type &out);
 std::istream &operator>>(std::istream &istr, std::vector<rt::backend_id> &out);
 std::istream &operator>>(std::istream &istr, default_selector_behavior& out);
+std::istream &operator>>(std::istream &istr, dag_flush_policy& out);
 
 enum class setting {
   debug_level,
@@ -59,7 +61,16 @@ enum class setting {
   hcf_dump_directory,
   persistent_runtime,
   max_cached_nodes,
-  sscp_failed_ir_dump_directory
+  sscp_failed_ir_dump_directory,
+  omp_numa_first_touch,
+  sscp_jit_cache_directory,
+  sscp_jit_cache_max_size,
+  sscp_jit_threads,
+  trace_file,
+  performance_counters,
+  runtime_idle_timeout,
+  dag_flush_policy,
+  omp_streaming_fill_threshold
 };
 
 template <setting S> struct setting_trait {};
@@ -87,6 +98,23 @@ HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::persistent_runtime, "persistent_runtime",
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::max_cached_nodes, "rt_max_cached_nodes", std::size_t)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::sscp_failed_ir_dump_directory,
                               "sscp_failed_ir_dump_directory", std::string)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_numa_first_touch,
+                              "rt_omp_numa_first_touch", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::sscp_jit_cache_directory,
+                              "sscp_jit_cache_directory", std::string)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::sscp_jit_cache_max_size,
+                              "sscp_jit_cache_max_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::sscp_jit_threads,
+                              "sscp_jit_threads", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::trace_file, "trace_file", std::string)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::performance_counters,
+                              "performance_counters", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::runtime_idle_timeout,
+                              "runtime_idle_timeout", double)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::dag_flush_policy,
+                              "rt_dag_flush_policy", dag_flush_policy)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_streaming_fill_threshold,
+                              "rt_omp_streaming_fill_threshold", std::size_t)
 
 class settings
 {
@@ -115,6 +143,24 @@ public:
       return _max_cached_nodes;
     } else if constexpr(S == setting::sscp_failed_ir_dump_directory) {
       return _sscp_failed_ir_dump_directory;
+    } else if constexpr(S == setting::omp_numa_first_touch) {
+      return _omp_numa_first_touch;
+    } else if constexpr(S == setting::sscp_jit_cache_directory) {
+      return _sscp_jit_cache_directory;
+    } else if constexpr(S == setting::sscp_jit_cache_max_size) {
+      return _sscp_jit_cache_max_size;
+    } else if constexpr(S == setting::sscp_jit_threads) {
+      return _sscp_jit_threads;
+    } else if constexpr(S == setting::trace_file) {
+      return _trace_file;
+    } else if constexpr(S == setting::performance_counters) {
+      return _performance_counters;
+    } else if constexpr(S == setting::runtime_idle_timeout) {
+      return _runtime_idle_timeout;
+    } else if constexpr(S == setting::dag_flush_policy) {
+      return _dag_flush_policy;
+    } else if constexpr(S == setting::omp_streaming_fill_threshold) {
+      return _omp_streaming_fill_threshold;
     }
     return typename setting_trait<S>::type{};
   }
@@ -150,6 +196,32 @@ public:
         get_environment_variable_or_default<setting::max_cached_nodes>(100);
     _sscp_failed_ir_dump_directory = get_environment_variable_or_default<
         setting::sscp_failed_ir_dump_directory>(std::string{});
+    _omp_numa_first_touch =
+        get_environment_variable_or_default<setting::omp_numa_first_touch>(
+            false);
+    _sscp_jit_cache_directory = get_environment_variable_or_default<
+        setting::sscp_jit_cache_directory>(std::string{});
+    _sscp_jit_cache_max_size = get_environment_variable_or_default<
+        setting::sscp_jit_cache_max_size>(1024);
+    _sscp_jit_threads =
+        get_environment_variable_or_default<setting::sscp_jit_threads>(0);
+    _trace_file = get_environment_variable_or_default<setting::trace_file>(
+        std::string{});
+    _performance_counters =
+        get_environment_variable_or_default<setting::performance_counters>(
+            false);
+    _runtime_idle_timeout =
+        get_environment_variable_or_default<setting::runtime_idle_timeout>(
+            0.0);
+    // By default, keep the flushing behavior that each scheduler
+    // had before the policy became configurable.
+    _dag_flush_policy =
+        get_environment_variable_or_default<setting::dag_flush_policy>(
+            _scheduler_type == scheduler_type::direct
+                ? dag_flush_policy::eager
+                : dag_flush_policy::batched);
+    _omp_streaming_fill_threshold = get_environment_variable_or_default<
+        setting::omp_streaming_fill_threshold>(32);
   }
 
 private:
@@ -190,6 +262,15 @@ private:
   bool _persistent_runtime;
   std::size_t _max_cached_nodes;
   std::string _sscp_failed_ir_dump_directory;
+  bool _omp_numa_first_touch;
+  std::string _sscp_jit_cache_directory;
+  std::size_t _sscp_jit_cache_max_size;
+  std::size_t _sscp_jit_threads;
+  std::string _trace_file;
+  bool _performance_counters;
+  double _runtime_idle_timeout;
+  dag_flush_policy _dag_flush_policy;
+  std::size_t _omp_streaming_fill_threshold;
 };
 
 }
@@ -28,8 +28,12 @@
 #ifndef HIPSYCL_SIGNAL_CHANNEL_HPP
 #define HIPSYCL_SIGNAL_CHANNEL_HPP
 
+#include <atomic>
 #include <future>
 #include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
 
 
 namespace hipsycl {
@@ -43,10 +47,32 @@ public:
   }
 
   void signal() {
-    _has_signalled_flag = true;
+    std::vector<std::function<void()>> callbacks;
+    {
+      std::lock_guard<std::mutex> lock{_callback_mutex};
+      _has_signalled_flag = true;
+      callbacks.swap(_callbacks);
+    }
+    // Run callbacks before waking up waiters, so that a waiter
+    // can rely on callbacks having completed.
+    for(auto& cb : callbacks)
+      cb();
     _promise.set_value(true);
   }
 
+  // Invokes callback when the channel is signalled, or immediately
+  // if this has already happened.
+  void on_signal(std::function<void()> callback) {
+    {
+      std::lock_guard<std::mutex> lock{_callback_mutex};
+      if(!_has_signalled_flag) {
+        _callbacks.push_back(std::move(callback));
+        return;
+      }
+    }
+    callback();
+  }
+
   void wait() {
     auto future = _shared_future;
     future.wait();
@@ -63,6 +89,9 @@ private:
   // bug in libstdc++ prior to version 11, where the
   // future::wait_for(duration(0)) pattern is extremely inefficient
   std::atomic<bool> _has_signalled_flag;
+
+  std::mutex _callback_mutex;
+  std::vector<std::function<void()>> _callbacks;
 };
 
 }
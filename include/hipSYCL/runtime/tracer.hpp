@@ -0,0 +1,160 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_RT_TRACER_HPP
+#define HIPSYCL_RT_TRACER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+/// A single trace event. Category and name must be string literals
+/// (or otherwise outlive the tracer), since only the pointers are stored.
+struct trace_record {
+  enum record_type : uint32_t { complete, instant };
+
+  uint64_t begin_ns;
+  uint64_t end_ns;
+  const char *category;
+  const char *name;
+  uint64_t arg;
+  record_type type;
+};
+
+/// Ring buffer of trace records that is written by exactly one thread.
+/// Once full, the oldest records are overwritten.
+class trace_buffer {
+public:
+  static constexpr std::size_t capacity = 1 << 15;
+
+  explicit trace_buffer(std::size_t thread_index);
+
+  void push(const trace_record &r) {
+    std::size_t head = _head.load(std::memory_order_relaxed);
+    _records[head & (capacity - 1)] = r;
+    _head.store(head + 1, std::memory_order_release);
+  }
+
+  std::size_t get_thread_index() const { return _thread_index;}
+
+  /// Invokes f for all records that are still available, oldest first.
+  template <class F> void for_each_record(F &&f) const {
+    std::size_t head = _head.load(std::memory_order_acquire);
+    std::size_t begin = head > capacity ? head - capacity : 0;
+    for(std::size_t i = begin; i < head; ++i)
+      f(_records[i & (capacity - 1)]);
+  }
+private:
+  std::size_t _thread_index;
+  std::atomic<std::size_t> _head;
+  std::unique_ptr<trace_record[]> _records;
+};
+
+/// Low-overhead tracer for runtime activity. Each thread records into its
+/// own trace_buffer without synchronization; the buffers are only merged
+/// when the trace is written in the Chrome trace event JSON format
+/// (which can be viewed in chrome://tracing or Perfetto).
+///
+/// The global tracer is enabled by setting HIPSYCL_TRACE_FILE, and writes
+/// its trace to that file on exit.
+class tracer {
+public:
+  /// Constructs a tracer that is enabled if \c filename is non-empty.
+  explicit tracer(const std::string &filename);
+
+  static tracer &get();
+
+  bool is_enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+  void record(const char *category, const char *name, uint64_t begin_ns,
+              uint64_t end_ns, uint64_t arg = 0);
+  void record_instant(const char *category, const char *name,
+                      uint64_t arg = 0);
+
+  /// \return Nanoseconds since construction of the tracer
+  uint64_t now() const;
+
+  /// Stops recording and writes all records in Chrome trace format.
+  void write(std::ostream &out);
+  /// Stops recording and writes the trace to the file that
+  /// was passed to the constructor.
+  bool write();
+private:
+  trace_buffer *get_thread_buffer();
+
+  std::atomic<bool> _enabled;
+  std::string _filename;
+  uint64_t _start_ns;
+  // Identifies the tracer in per-thread buffer caches
+  uint64_t _id;
+
+  std::mutex _mutex;
+  std::vector<std::unique_ptr<trace_buffer>> _buffers;
+};
+
+/// Records the lifetime of the object as a complete event in the
+/// global tracer, if tracing is enabled.
+class trace_scope {
+public:
+  trace_scope(const char *category, const char *name, uint64_t arg = 0)
+      : _category{category}, _name{name}, _arg{arg}, _begin{0},
+        _is_active{tracer::get().is_enabled()} {
+    if(_is_active)
+      _begin = tracer::get().now();
+  }
+
+  ~trace_scope() {
+    if(_is_active) {
+      tracer &t = tracer::get();
+      t.record(_category, _name, _begin, t.now(), _arg);
+    }
+  }
+
+  void set_arg(uint64_t arg) { _arg = arg; }
+
+  trace_scope(const trace_scope &) = delete;
+  trace_scope &operator=(const trace_scope &) = delete;
+private:
+  const char *_category;
+  const char *_name;
+  uint64_t _arg;
+  uint64_t _begin;
+  bool _is_active;
+};
+
+}
+}
+
+#endif
@@ -69,13 +69,18 @@ public:
   virtual ~ze_sscp_code_object_invoker(){}
 
   virtual result submit_kernel(const kernel_operation& op,
-                               hcf_object_id hcf_object,
+                               const sscp_kernel_id &kernel_id,
                                const rt::range<3> &num_groups,
                                const rt::range<3> &group_size,
                                unsigned local_mem_size, void **args,
                                std::size_t *arg_sizes, std::size_t num_args,
-                               const std::string &kernel_name,
                                const glue::kernel_configuration& config) override;
+
+  virtual result prepare_kernel(hcf_object_id hcf_object,
+                                const std::string &global_kernel_name,
+                                const std::string &kernel_name,
+                                unsigned local_mem_size,
+                                const glue::kernel_configuration &config) override;
 private:
   ze_queue* _queue;
 };
@@ -36,23 +36,32 @@
 namespace hipsycl {
 namespace rt {
 
+class worker_thread;
 
-class ze_node_event : public inorder_queue_event<ze_event_handle_t>
+class ze_node_event : public inorder_queue_event<ze_event_handle_t>,
+                      public std::enable_shared_from_this<ze_node_event>
 {
 public:
   /// Takes ownership of supplied ze_event_handle_t
+  /// \param completion_notifier Level Zero has no host callbacks, so
+  /// completion notifications are delivered by a thread that waits for the
+  /// event. If null, notify_on_completion() is not supported. Must outlive
+  /// all pending notifications.
   ze_node_event(ze_event_handle_t evt, 
-    std::shared_ptr<ze_event_pool_handle_t> pool);
+    std::shared_ptr<ze_event_pool_handle_t> pool,
+    worker_thread* completion_notifier = nullptr);
   ~ze_node_event();
 
   virtual bool is_complete() const override;
   virtual void wait() override;
+  virtual bool notify_on_completion(std::function<void()> callback) override;
 
   ze_event_handle_t get_event_handle() const;
   virtual ze_event_handle_t request_backend_event() override;
 private:
   ze_event_handle_t _evt;
   std::shared_ptr<ze_event_pool_handle_t> _pool;
+  worker_thread* _completion_notifier;
 };
 
 
@@ -35,6 +35,7 @@
 #include "../inorder_queue.hpp"
 #include "hipSYCL/runtime/code_object_invoker.hpp"
 #include "hipSYCL/runtime/event.hpp"
+#include "hipSYCL/runtime/generic/async_worker.hpp"
 #include "ze_code_object.hpp"
 
 
@@ -73,6 +74,8 @@ public:
 
   virtual result query_status(inorder_queue_status& status) override;
 
+  virtual sscp_code_object_invoker* get_sscp_code_object_invoker() override;
+
   ze_command_list_handle_t get_ze_command_list() const {
     return _command_list;
   }
@@ -88,12 +91,19 @@ public:
       void **kernel_args, const std::size_t *arg_sizes, std::size_t num_args);
 
   result submit_sscp_kernel_from_code_object(
-      const kernel_operation &op, hcf_object_id hcf_object,
-      const std::string &kernel_name, const rt::range<3> &num_groups,
-      const rt::range<3> &group_size, unsigned local_mem_size, void **args,
-      std::size_t *arg_sizes, std::size_t num_args,
+      const kernel_operation &op, const sscp_kernel_id &kernel_id,
+      const rt::range<3> &num_groups, const rt::range<3> &group_size,
+      unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+      std::size_t num_args,
       const glue::kernel_configuration &config);
 
+  /// Obtains the code object containing an SSCP kernel from the kernel
+  /// cache, compiling it if necessary. Can be called from any thread.
+  result get_sscp_code_object(const sscp_kernel_id &kernel_id,
+                              unsigned local_mem_size,
+                              const glue::kernel_configuration &config,
+                              const code_object *&obj_out);
+
 private:
   const std::vector<std::shared_ptr<dag_node_event>>&
   get_enqueued_synchronization_ops() const;
@@ -115,6 +125,8 @@ private:
   std::vector<std::shared_ptr<dag_node_event>> _enqueued_synchronization_ops;
 
   std::vector<std::future<void>> _external_waits;
+  // Delivers completion notifications of events of this queue
+  worker_thread _completion_notifier;
 };
 
 }
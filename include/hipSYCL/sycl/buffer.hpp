@@ -175,6 +175,10 @@ template <class BufferT>
 std::shared_ptr<rt::buffer_data_region>
 extract_buffer_data_region(const BufferT &buff);
 
+template <class BufferT>
+sycl::id<BufferT::buffer_dim>
+extract_sub_buffer_offset(const BufferT &buff);
+
 struct buffer_impl
 {
   rt::runtime_keep_alive_token requires_runtime;
@@ -207,15 +211,27 @@ struct buffer_impl
             << "buffer_impl::~buffer_impl: Preparing submission of writeback..."
             << std::endl;
         
-        if (data->has_allocation(get_host_device()) &&
+        if (!data->has_allocation(get_host_device()) ||
             (data->get_memory(get_host_device()) != this->writeback_ptr)) {
           // We are writing back to an external location, i.e. a location
-          // set with set_final_data()
-          // TODO Currently, we are requesting an host update and then
-          // submit an explicit copy to writeback_ptr.
-          // We could directly copy from device if
-          // there is a device that has up-to-date data.
-          submit_copy(detail::get_host_device(), writeback_ptr);
+          // set with set_final_data(). Copy directly from a device
+          // that will hold the most recent data instead of routing
+          // the data through the host allocation first.
+          std::vector<std::pair<rt::device_id, rt::range_store::rect>> sources;
+          if (select_writeback_sources(sources)) {
+            for (const auto &source : sources) {
+              HIPSYCL_DEBUG_INFO << "buffer_impl::~buffer_impl: Writing back "
+                                    "directly from device "
+                                 << source.first.get_id() << std::endl;
+              submit_copy(source.first, writeback_ptr, source.second.first,
+                          source.second.second);
+            }
+          } else {
+            HIPSYCL_DEBUG_INFO
+                << "buffer_impl::~buffer_impl: Buffer has no initialized "
+                   "content, skipping write-back."
+                << std::endl;
+          }
         } else {
           rt::dag_build_guard build{requires_runtime.get()->dag()};
 
@@ -271,7 +287,68 @@ private:
     }
   }
   
-  rt::dag_node_ptr submit_copy(rt::device_id source_dev, void* dest) {
+  // Selects the devices from which the write-back copies should
+  // originate, together with the range each of them provides.
+  // Returns false if the buffer has never been initialized.
+  bool select_writeback_sources(
+      std::vector<std::pair<rt::device_id, rt::range_store::rect>> &sources) {
+    // If there are still pending users, the validity state of the data region
+    // may not yet reflect them since it is only updated during scheduling.
+    // The device of the most recent user will hold valid data once that user
+    // has executed. Prefer users that cover the entire buffer, so that
+    // the copy does not require an update of the source device.
+    const rt::range<3> num_elements = data->get_num_elements();
+    rt::device_id source_dev;
+    bool found_user = false;
+    bool found_full_range_user = false;
+    data->get_users().for_each_user([&](const rt::data_user &user) {
+      if (found_full_range_user)
+        return;
+      rt::dag_node_ptr node = user.user.lock();
+      // Completed users are already reflected in the validity state
+      if (!node || (node->is_submitted() && node->is_complete()))
+        return;
+
+      rt::device_id dev;
+      if (node->is_submitted()) {
+        dev = node->get_assigned_device();
+      } else if (node->get_execution_hints()
+                     .has_hint<rt::hints::bind_to_device>()) {
+        dev = node->get_execution_hints()
+                  .get_hint<rt::hints::bind_to_device>()
+                  ->get_device_id();
+      } else {
+        return;
+      }
+
+      const bool is_full_range =
+          user.offset == rt::id<3>{} && user.range == num_elements;
+      if (!found_user || is_full_range) {
+        source_dev = dev;
+        found_user = true;
+        found_full_range_user = is_full_range;
+      }
+    });
+    if (found_user) {
+      sources.push_back(std::make_pair(
+          source_dev, rt::range_store::rect{rt::id<3>{}, num_elements}));
+      return true;
+    }
+
+    // Without pending users, no scheduling of this data region is in flight
+    // and the validity state is final.
+    if (!data->has_initialized_content(rt::id<3>{}, num_elements))
+      return false;
+
+    // If the data is spread across devices, copy each part from a device
+    // holding it.
+    data->get_valid_sources(get_host_device(), rt::id<3>{}, num_elements,
+                            sources);
+    return !sources.empty();
+  }
+
+  rt::dag_node_ptr submit_copy(rt::device_id source_dev, void *dest,
+                               rt::id<3> offset, rt::range<3> range) {
 
     std::shared_ptr<rt::buffer_data_region> data_src = this->data;
 
@@ -282,20 +359,18 @@ private:
     rt::requirements_list reqs{requires_runtime.get()};
 
     auto req = std::make_unique<rt::buffer_memory_requirement>(
-        data_src, rt::id<3>{}, data_src->get_num_elements(), access_mode::read,
-        target::device);
+        data_src, offset, range, access_mode::read, target::device);
 
     reqs.add_requirement(std::move(req));
 
-    rt::memory_location source_location{source_dev, rt::id<3>{},
-                                        data_src};
+    rt::memory_location source_location{source_dev, offset, data_src};
     
     rt::memory_location dest_location{detail::get_host_device(), dest,
-                                      rt::id<3>{}, data_src->get_num_elements(),
+                                      offset, data_src->get_num_elements(),
                                       data_src->get_element_size()};
 
     auto explicit_copy = rt::make_operation<rt::memcpy_operation>(
-        source_location, dest_location, data_src->get_num_elements());
+        source_location, dest_location, range);
 
     rt::dag_node_ptr node = build.builder()->add_memcpy(
         std::move(explicit_copy), reqs, hints);
@@ -383,6 +458,10 @@ public:
   friend std::shared_ptr<rt::buffer_data_region>
   detail::extract_buffer_data_region(const BufferT &buff);
 
+  template <class BufferT>
+  friend sycl::id<BufferT::buffer_dim>
+  detail::extract_sub_buffer_offset(const BufferT &buff);
+
   using value_type = T;
   using reference = value_type &;
   using const_reference = const value_type &;
@@ -600,17 +679,61 @@ public:
   : buffer(first, last, AllocatorT(), propList) 
   {}
 
+  /// Sub-buffers share the data region of their parent and only
+  /// describe a view into it, so no data is copied. Accesses are tracked
+  /// in the coordinates of the parent, such that accesses to disjoint
+  /// sub-buffers do not depend on each other as long as they touch
+  /// different pages. The page size of the parent is refined to the
+  /// bounds of the sub-buffer if no operation on the parent is pending;
+  /// otherwise the hipSYCL_page_size buffer property controls it.
   buffer(buffer<T, dimensions, AllocatorT> b,
          const id<dimensions> &baseIndex,
          const range<dimensions> &subRange)
-  {
-    assert(false && "subbuffer is unimplemented");
+      : detail::property_carrying_object{b}, _alloc{b._alloc},
+        _range{subRange}, _impl{b._impl}, _is_sub_buffer{true} {
+
+    for(int i = 0; i < dimensions; ++i) {
+      if(baseIndex[i] + subRange[i] > b._range[i])
+        throw invalid_object_error{
+            "buffer: Sub-buffer exceeds the range of its parent buffer"};
+      _sub_buffer_offset[i] = b._sub_buffer_offset[i] + baseIndex[i];
+    }
+
+    const rt::range<3> region_shape = _impl->data->get_num_elements();
+    if (!b._is_sub_buffer &&
+        (rt::embed_in_range3(b._range) != region_shape ||
+         _impl->data->get_element_size() != sizeof(T)))
+      throw feature_not_supported{
+          "buffer: Sub-buffers of reinterpreted buffers are unsupported"};
+
+    // The sub-buffer must be a contiguous region of the parent: Once a
+    // dimension spans more than one element, all faster dimensions need
+    // to span the entire parent.
+    const rt::range<3> sub_shape = rt::embed_in_range3(subRange);
+    int first_nontrivial_dim = 0;
+    while(first_nontrivial_dim < 2 && sub_shape[first_nontrivial_dim] <= 1)
+      ++first_nontrivial_dim;
+    for(int i = first_nontrivial_dim + 1; i < 3; ++i) {
+      if(sub_shape[i] != region_shape[i])
+        throw invalid_object_error{
+            "buffer: Sub-buffer does not describe a contiguous region of "
+            "its parent buffer"};
+    }
+
+    std::lock_guard<std::mutex> lock{_impl->data->get_dependency_lock()};
+    if (!_impl->data->align_pages_to(rt::embed_in_id3(_sub_buffer_offset),
+                                     sub_shape))
+      HIPSYCL_DEBUG_INFO << "buffer: Could not align pages to sub-buffer, "
+                            "accesses may depend on neighboring sub-buffers"
+                         << std::endl;
   }
 
   // Allow conversion to buffer<const T> from buffer<T>
   template <class t = T, std::enable_if_t<std::is_const_v<t>, bool> = true>
   buffer(const buffer<std::remove_const_t<T>, dimensions, AllocatorT> &other)
       : _alloc{other._alloc}, _range{other._range}, _impl{other._impl},
+        _sub_buffer_offset{other._sub_buffer_offset},
+        _is_sub_buffer{other._is_sub_buffer},
         detail::property_carrying_object{other} {}
 
   range<dimensions> get_range() const
@@ -701,6 +824,9 @@ public:
 
   void set_final_data(std::shared_ptr<T> finalData)
   {
+    if(ignore_write_back_change("set_final_data()"))
+      return;
+
     std::lock_guard<std::mutex> lock {_impl->lock};
     set_write_back_target(finalData.get());
     
@@ -711,19 +837,24 @@ public:
   template <typename Destination = std::nullptr_t>
   void set_final_data(Destination finalData = nullptr)
   {
+    if(ignore_write_back_change("set_final_data()"))
+      return;
+
     std::lock_guard<std::mutex> lock {_impl->lock};
     set_write_back_target(finalData);
   }
 
   void set_write_back(bool flag = true)
   {
+    if(ignore_write_back_change("set_write_back()"))
+      return;
+
     std::lock_guard<std::mutex> lock {_impl->lock};
     this->enable_write_back(flag);
   }
 
-  // ToDo Subbuffers are unsupported
   bool is_sub_buffer() const
-  { return false; }
+  { return _is_sub_buffer; }
 
   template <typename ReinterpretT, int ReinterpretDim>
   buffer<ReinterpretT, ReinterpretDim,
@@ -732,6 +863,8 @@ public:
   reinterpret(range<ReinterpretDim> reinterpretRange) const {
     if(_range.size() * sizeof(T) != reinterpretRange.size() * sizeof(ReinterpretT))
       throw invalid_parameter_error{"reinterpret must preserve the byte count of the buffer"};
+    if(_is_sub_buffer)
+      throw feature_not_supported{"reinterpret is unsupported for sub-buffers"};
 
     buffer<ReinterpretT, ReinterpretDim,
             typename std::allocator_traits<AllocatorT>::template rebind_alloc<
@@ -761,7 +894,10 @@ public:
 
   friend bool operator==(const buffer& lhs, const buffer& rhs)
   {
-    return lhs._impl == rhs._impl;
+    return lhs._impl == rhs._impl &&
+           lhs._is_sub_buffer == rhs._is_sub_buffer &&
+           lhs._sub_buffer_offset == rhs._sub_buffer_offset &&
+           lhs._range == rhs._range;
   }
 
   friend bool operator!=(const buffer& lhs, const buffer& rhs)
@@ -1160,10 +1296,25 @@ private:
     }
   }
 
+  // Write-back is a property of the entire data region and
+  // can therefore only be controlled through the parent buffer.
+  bool ignore_write_back_change(const char* operation) const {
+    if(_is_sub_buffer) {
+      HIPSYCL_DEBUG_WARNING << "buffer: Ignoring " << operation
+                            << " on sub-buffer" << std::endl;
+      return true;
+    }
+    return false;
+  }
+
   AllocatorT _alloc;
   range<dimensions> _range;
 
   std::shared_ptr<detail::buffer_impl> _impl;
+
+  // Offset of a sub-buffer within the data region
+  id<dimensions> _sub_buffer_offset;
+  bool _is_sub_buffer = false;
 };
 
 // Deduction guides
@@ -1211,6 +1362,12 @@ extract_buffer_range(const buffer<T, dimensions, AllocatorT> &buff) {
   return buff.get_range();
 }
 
+template <class BufferT>
+sycl::id<BufferT::buffer_dim>
+extract_sub_buffer_offset(const BufferT &buff) {
+  return buff._sub_buffer_offset;
+}
+
 }
 
 
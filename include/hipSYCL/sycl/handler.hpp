@@ -78,6 +78,8 @@ template <int Dim> struct accessor_data {
   sycl::range<Dim> range;
 
   bool is_no_init;
+
+  detail::buffer_view<Dim> view;
 };
 
 
@@ -93,7 +95,8 @@ class handler {
   detail::accessor::bind_to_handler(AccessorType &acc, sycl::handler &cgh,
                                     std::shared_ptr<rt::buffer_data_region> mem,
                                     sycl::id<Dim> offset, sycl::range<Dim> range,
-                                    bool is_no_init);
+                                    bool is_no_init,
+                                    const detail::buffer_view<Dim> &view);
 
   template <class AccessorType, int Dim>
   void require(AccessorType& acc,
@@ -119,16 +122,17 @@ class handler {
       data.mem,
       detail::get_effective_offset<typename AccessorType::value_type>(
           data.mem, rt::make_id(data.offset), buffer_shape,
-          AccessorType::has_access_range),
+          AccessorType::has_access_range, data.view),
       detail::get_effective_range<typename AccessorType::value_type>(
           data.mem, rt::make_range(data.range), buffer_shape,
-          AccessorType::has_access_range),
+          AccessorType::has_access_range, data.view),
       mode, AccessorType::access_target
     );
 
     // Bind the accessor's embedded pointer to the requirement, such that
     // the scheduler is able to initialize the accessor's data pointer
     // once it has been captured
+    req->set_view_offset(rt::embed_in_id3(rt::make_id(data.view.offset)));
     req->bind(accessor_id);
 
     _requirements.add_requirement(std::move(req));
@@ -220,6 +224,20 @@ class handler {
             mem_req->get_access_range3d()));
   }
 
+  // For accessors to sub-buffers, the offset of the sub-buffer
+  // within the data region. get_offset() includes this offset.
+  template<class AccessorType>
+  auto get_view_offset(const AccessorType& acc) {
+    rt::buffer_memory_requirement *mem_req = get_buffer_memory_requirement(acc);
+
+    if(!mem_req)
+      raise_unregistered_accessor(acc);
+
+    return rt_id_to_sycl_id(
+        rt::extract_from_id3<AccessorType::get_dimensions()>(
+            mem_req->get_view_offset3d()));
+  }
+
   template<class AccessorType>
   auto get_memory_region(const AccessorType& acc) {
     rt::buffer_memory_requirement *mem_req = get_buffer_memory_requirement(acc);
@@ -230,6 +248,60 @@ class handler {
     return mem_req->get_data_region();
   }
 
+  template <class T> static constexpr bool is_memset_pattern() {
+    return std::is_trivially_copyable_v<T> &&
+           rt::memset_operation::max_pattern_size % sizeof(T) == 0;
+  }
+
+  bool is_bound_to_host_device() const {
+    if (!_execution_hints.has_hint<rt::hints::bind_to_device>())
+      return false;
+    rt::device_id dev =
+        _execution_hints.get_hint<rt::hints::bind_to_device>()->get_device_id();
+    return dev.get_full_backend_descriptor().hw_platform ==
+           rt::hardware_platform::cpu;
+  }
+
+  // Returns the requirement node of the accessor if it accesses a
+  // contiguous range of memory, nullptr otherwise.
+  template <class AccessorType>
+  rt::dag_node_ptr get_contiguous_requirement_node(const AccessorType &acc) {
+    rt::buffer_memory_requirement *mem_req = get_buffer_memory_requirement(acc);
+
+    if(!mem_req)
+      raise_unregistered_accessor(acc);
+
+    rt::id<3> offset = mem_req->get_access_offset3d();
+    rt::range<3> range = mem_req->get_access_range3d();
+    rt::range<3> shape = mem_req->get_data_region()->get_num_elements();
+    if (range.size() == 0)
+      return nullptr;
+    // Once a dimension does not span the whole allocation, all
+    // slower dimensions must be of size 1.
+    bool is_partial = false;
+    for (int i = 2; i >= 0; --i) {
+      if (is_partial && range[i] != 1)
+        return nullptr;
+      if (offset[i] != 0 || range[i] != shape[i])
+        is_partial = true;
+    }
+
+    for (rt::dag_node_ptr req : _requirements.get()) {
+      if (req->get_operation() == mem_req)
+        return req;
+    }
+    return nullptr;
+  }
+
+  void submit_memset(std::unique_ptr<rt::operation> op) {
+    rt::dag_build_guard build{_rt->dag()};
+
+    rt::dag_node_ptr node = build.builder()->add_memset(
+        std::move(op), _requirements, _execution_hints);
+
+    _command_group_nodes.push_back(node);
+  }
+
 public:
   ~handler()
   {
@@ -492,9 +564,6 @@ public:
         acc);
   }
 
-  /// \todo fill() on host accessors can be optimized to use
-  /// memset() if the accessor describes a large area of
-  /// contiguous memory
   template <typename T, int dim, access::mode mode, access::target tgt,
             accessor_variant variant>
   void fill(accessor<T, dim, mode, tgt, variant> dest, const T &src) {
@@ -503,9 +572,25 @@ public:
     static_assert(tgt != access::target::host_image,
                   "host_image targets are unsupported");
 
+    // On the host, contiguous accesses are filled by a memset operation,
+    // which is faster than a kernel and can bypass the cache.
+    if constexpr (is_memset_pattern<T>()) {
+      if (is_bound_to_host_device()) {
+        if (rt::dag_node_ptr req_node = get_contiguous_requirement_node(dest)) {
+          auto *req =
+              rt::cast<rt::buffer_memory_requirement>(req_node->get_operation());
+          if (req->get_element_size() == sizeof(T)) {
+            submit_memset(rt::make_operation<rt::memset_operation>(
+                req_node, &src, sizeof(T), req->get_required_size()));
+            return;
+          }
+        }
+      }
+    }
+
 
     this->submit_kernel<__hipsycl_unnamed_kernel, rt::kernel_type::basic_parallel_for>(
-        get_offset(dest), get_range(dest),
+        get_offset(dest) - get_view_offset(dest), get_range(dest),
         get_preferred_group_size<dim>(),
         detail::kernels::fill_kernel{dest, src});
   }
@@ -575,6 +660,10 @@ public:
       unsigned char val = *reinterpret_cast<const unsigned char*>(&pattern);
       
       memset(ptr, static_cast<int>(val), count);
+    } else if (is_memset_pattern<T>() && is_bound_to_host_device()) {
+      // The host backend supports memset with wider patterns
+      submit_memset(rt::make_operation<rt::memset_operation>(
+          ptr, &pattern, sizeof(T), count * sizeof(T)));
     } else {
       T *typed_ptr = static_cast<T *>(ptr);
 
@@ -591,20 +680,13 @@ public:
   }
 
   void memset(void *ptr, int value, std::size_t num_bytes) {
-   
-    rt::dag_build_guard build{_rt->dag()};
 
     if(!_execution_hints.has_hint<rt::hints::bind_to_device>())
       throw invalid_parameter_error{"handler: explicit memset() is unsupported "
                                     "for queues not bound to devices"};
 
-    auto op = rt::make_operation<rt::memset_operation>(
-        ptr, static_cast<unsigned char>(value), num_bytes);
-
-    rt::dag_node_ptr node = build.builder()->add_memset(
-        std::move(op), _requirements, _execution_hints);
-
-    _command_group_nodes.push_back(node);
+    submit_memset(rt::make_operation<rt::memset_operation>(
+        ptr, static_cast<unsigned char>(value), num_bytes));
   }
 
   void prefetch_host(const void *ptr, std::size_t num_bytes) {
@@ -770,12 +852,18 @@ private:
 
     rt::dag_build_guard build{_rt->dag()};
 
+    // Looked up once per kernel, so that launches only need to
+    // increment the counters.
+    static rt::performance_counters::kernel_counters *const counters =
+        rt::performance_counters::get().get_kernel_counters(
+            rt::kernel_cache::get().get_global_kernel_name<KernelFuncType>());
+
     auto kernel_op = rt::make_operation<rt::kernel_operation>(
         rt::kernel_cache::get().get_global_kernel_name<KernelFuncType>(),
         glue::make_kernel_launchers<KernelName, KernelType>(
             offset, local_range, global_range, shared_mem_size, f,
             reductions...),
-        _requirements);
+        _requirements, counters);
 
     rt::dag_node_ptr node = build.builder()->add_kernel(
         std::move(kernel_op), _requirements, _execution_hints);
@@ -972,8 +1060,10 @@ void bind_to_handler(AccessorType& acc, sycl::handler& cgh)
 template <class AccessorType, int Dim>
 void bind_to_handler(AccessorType& acc, sycl::handler& cgh,
                      std::shared_ptr<rt::buffer_data_region> mem,
-                     sycl::id<Dim> offset, sycl::range<Dim> range, bool is_no_init) {
-  cgh.require(acc, detail::accessor_data<Dim>{mem, offset, range, is_no_init});
+                     sycl::id<Dim> offset, sycl::range<Dim> range, bool is_no_init,
+                     const buffer_view<Dim> &view) {
+  cgh.require(acc, detail::accessor_data<Dim>{mem, offset, range, is_no_init,
+                                              view});
 }
 
 }
@@ -112,6 +112,9 @@ constexpr accessor_variant deduce_accessor_variant(mode_tag<TagDescT> tag,
   }
 }
 
+template<int Dim>
+struct buffer_view;
+
 // Defined in buffer.hpp
 template <class BufferT>
 std::shared_ptr<rt::buffer_data_region>
@@ -121,6 +124,9 @@ template <class T, int dimensions, class AllocatorT>
 sycl::range<dimensions>
 extract_buffer_range(const buffer<T, dimensions, AllocatorT> &buff);
 
+template <class BufferT>
+sycl::id<BufferT::buffer_dim>
+extract_sub_buffer_offset(const BufferT &buff);
 
 }
 
@@ -251,7 +257,7 @@ template <class AccessorType, int Dim>
 void bind_to_handler(AccessorType &acc, sycl::handler &cgh,
                      std::shared_ptr<rt::buffer_data_region> mem,
                      sycl::id<Dim> offset, sycl::range<Dim> range,
-                     bool is_no_init);
+                     bool is_no_init, const buffer_view<Dim> &view);
 
 
 template<class AccessorType>
@@ -449,6 +455,51 @@ rt::id<3> get_effective_offset(const std::shared_ptr<rt::buffer_data_region> &me
   return rt::embed_in_id3(offset);
 }
 
+/// Describes which part of its data region a buffer refers to.
+/// Sub-buffers are contiguous views into the data region of their
+/// parent, starting at \c offset (in elements of the parent).
+template<int Dim>
+struct buffer_view {
+  bool is_sub_buffer = false;
+  sycl::id<Dim> offset;
+};
+
+template <class BufferT>
+buffer_view<BufferT::buffer_dim> extract_buffer_view(const BufferT &buff) {
+  return buffer_view<BufferT::buffer_dim>{
+      buff.is_sub_buffer(), extract_sub_buffer_offset(buff)};
+}
+
+template <class T, int Dim>
+rt::range<3> get_effective_range(const std::shared_ptr<rt::buffer_data_region> &mem_region,
+                                  const rt::range<Dim> range, const rt::range<Dim> buffer_shape,
+                                  const bool has_access_range,
+                                  const buffer_view<Dim>& view) {
+  if(!view.is_sub_buffer)
+    return get_effective_range<T>(mem_region, range, buffer_shape,
+                                  has_access_range);
+  // Sub-buffers are guaranteed to have the element type and shape of
+  // the data region, so we can always describe the accessed range exactly.
+  return rt::embed_in_range3(has_access_range ? range : buffer_shape);
+}
+
+template <class T, int Dim>
+rt::id<3> get_effective_offset(const std::shared_ptr<rt::buffer_data_region> &mem_region,
+                                  const rt::id<Dim> offset, const rt::range<Dim> buffer_shape,
+                                  const bool has_access_range,
+                                  const buffer_view<Dim>& view) {
+  if(!view.is_sub_buffer)
+    return get_effective_offset<T>(mem_region, offset, buffer_shape,
+                                   has_access_range);
+  // Translate into coordinates of the data region
+  rt::id<Dim> region_offset = rt::make_id(view.offset);
+  if(has_access_range) {
+    for(int i = 0; i < Dim; ++i)
+      region_offset[i] += offset[i];
+  }
+  return rt::embed_in_id3(region_offset);
+}
+
 /// The accessor base allows us to retrieve the associated buffer
 /// for the accessor.
 template<class T>
@@ -1050,8 +1101,14 @@ private:
 
     bind_to_buffer(buff, offset, access_range);
 
+    auto view = detail::extract_buffer_view(buff);
     if (accessTarget == access::target::host_buffer) {
-      init_host_buffer(buff.hipSYCL_runtime(), is_no_init_access);
+      init_host_buffer(buff.hipSYCL_runtime(), is_no_init_access, view);
+    } else if (view.is_sub_buffer) {
+      // Placeholder accessors do not remember where the sub-buffer starts
+      // within its parent by the time they are require()d.
+      throw feature_not_supported{
+          "accessor: Placeholder accessors to sub-buffers are unsupported"};
     }
   }
   
@@ -1077,7 +1134,8 @@ private:
     bind_to_buffer(buff, offset, access_range);
     detail::accessor::bind_to_handler(*this, cgh,
                                       detail::extract_buffer_data_region(buff),
-                                      offset, access_range, is_no_init_access);
+                                      offset, access_range, is_no_init_access,
+                                      detail::extract_buffer_view(buff));
   }
 
   template <class BufferT>
@@ -1141,7 +1199,8 @@ private:
         dimensions>::attempt_set(detail::extract_buffer_range(buff));
   }
 
-  void init_host_buffer(rt::runtime* rt, bool is_no_init) {
+  void init_host_buffer(rt::runtime *rt, bool is_no_init,
+                        const detail::buffer_view<dimensions> &view) {
     // TODO: Maybe unify code with handler::update_host()?
     HIPSYCL_DEBUG_INFO << "accessor [host]: Initializing host access" << std::endl;
 
@@ -1151,23 +1210,41 @@ private:
     auto data = data_mobile_ptr.get_shared_ptr();
     assert(data);
 
+    const rt::range<dimensions> buffer_shape = rt::make_range(get_buffer_shape());
+    const rt::id<3> access_offset = detail::get_effective_offset<dataT>(
+        data, rt::make_id(get_offset()), buffer_shape, has_access_range, view);
+    const rt::range<3> access_range = detail::get_effective_range<dataT>(
+        data, rt::make_range(get_range()), buffer_shape, has_access_range, view);
+    const rt::id<3> view_offset = rt::embed_in_id3(rt::make_id(view.offset));
+
+    // Fast path: If the host already holds valid data and nothing is
+    // pending, there is no need to go through the DAG.
+    if(void *host_ptr = data->try_direct_access(
+           detail::get_host_device(),
+           detail::get_effective_access_mode(accessmode, is_no_init),
+           access_offset, access_range)) {
+      HIPSYCL_DEBUG_INFO << "accessor [host]: Host data is coherent, skipping "
+                            "DAG submission"
+                         << std::endl;
+      this->_ptr.explicit_init(static_cast<char *>(host_ptr) +
+                               data->get_byte_offset(view_offset));
+      return;
+    }
+
     rt::dag_node_ptr node;
     {
       rt::dag_build_guard build{rt->dag()};
-      
-      const rt::range<dimensions> buffer_shape = rt::make_range(get_buffer_shape());
+
       auto explicit_requirement = rt::make_operation<rt::buffer_memory_requirement>(
-        data,
-        detail::get_effective_offset<dataT>(data, rt::make_id(get_offset()),
-                                            buffer_shape, has_access_range),
-        detail::get_effective_range<dataT>(data, rt::make_range(get_range()),
-                                            buffer_shape, has_access_range),
+        data, access_offset, access_range,
         detail::get_effective_access_mode(accessmode, is_no_init),
         accessTarget
       );
 
-      rt::cast<rt::buffer_memory_requirement>(explicit_requirement.get())
-          ->bind(this->get_uid());
+      auto *req =
+          rt::cast<rt::buffer_memory_requirement>(explicit_requirement.get());
+      req->set_view_offset(view_offset);
+      req->bind(this->get_uid());
 
       rt::execution_hints enforce_bind_to_host;
       enforce_bind_to_host.add_hint(
@@ -1190,7 +1267,7 @@ private:
       rt::buffer_memory_requirement *req =
           static_cast<rt::buffer_memory_requirement *>(node->get_operation());
       assert(req->has_device_ptr());
-      void* host_ptr = req->get_device_ptr();
+      void* host_ptr = req->get_bound_ptr();
       assert(host_ptr);
       
       // For host accessors, we need to manually trigger the initialization
@@ -101,11 +101,13 @@
  #define HIPSYCL_LOOP_SPLIT_ND_KERNEL [[clang::annotate("hipsycl_nd_kernel")]]
  #define HIPSYCL_LOOP_SPLIT_ND_KERNEL_LOCAL_SIZE_ARG [[clang::annotate("hipsycl_nd_kernel_local_size_arg")]]
  #define HIPSYCL_LOOP_SPLIT_BARRIER [[clang::annotate("hipsycl_barrier")]]
+ #define HIPSYCL_BARRIER_FREE_ND_KERNEL_QUERY [[clang::annotate("hipsycl_barrier_free_nd_kernel_query")]]
 #else
  #define HIPSYCL_FORCE_INLINE inline
  #define HIPSYCL_LOOP_SPLIT_ND_KERNEL
  #define HIPSYCL_LOOP_SPLIT_BARRIER
  #define HIPSYCL_LOOP_SPLIT_ND_KERNEL_LOCAL_SIZE_ARG
+ #define HIPSYCL_BARRIER_FREE_ND_KERNEL_QUERY
 #endif
 #define HIPSYCL_BUILTIN HIPSYCL_UNIVERSAL_TARGET HIPSYCL_FORCE_INLINE
 #if HIPSYCL_LIBKERNEL_COMPILER_SUPPORTS_CUDA ||                                \
@@ -0,0 +1,77 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_SSCP_BUILTIN_HOST_COMMON_HPP
+#define HIPSYCL_SSCP_BUILTIN_HOST_COMMON_HPP
+
+#include "hipSYCL/sycl/libkernel/sscp/builtins/builtin_config.hpp"
+
+#include <stddef.h>
+
+// Work item ids within the group. These are owned by the CBS pipeline,
+// which replaces them with the induction variables of the work item
+// loops. __hipsycl_local_id_z is the innermost loop.
+extern "C" size_t __hipsycl_local_id_x;
+extern "C" size_t __hipsycl_local_id_y;
+extern "C" size_t __hipsycl_local_id_z;
+
+// Group geometry. LLVMToHost replaces loads from these by
+// loads from the arguments of the generated kernel entry point,
+// see HostKernelABI.hpp.
+extern "C" size_t __hipsycl_sscp_host_group_id_x;
+extern "C" size_t __hipsycl_sscp_host_group_id_y;
+extern "C" size_t __hipsycl_sscp_host_group_id_z;
+
+extern "C" size_t __hipsycl_sscp_host_num_groups_x;
+extern "C" size_t __hipsycl_sscp_host_num_groups_y;
+extern "C" size_t __hipsycl_sscp_host_num_groups_z;
+
+extern "C" size_t __hipsycl_sscp_host_local_size_x;
+extern "C" size_t __hipsycl_sscp_host_local_size_y;
+extern "C" size_t __hipsycl_sscp_host_local_size_z;
+
+// Barrier marker recognized by the CBS pipeline
+extern "C" void __hipsycl_barrier();
+
+inline int __hipsycl_sscp_host_get_builtin_memory_order(
+    __hipsycl_sscp_memory_order order) {
+  switch (order) {
+  case __hipsycl_sscp_memory_order::relaxed:
+    return __ATOMIC_RELAXED;
+  case __hipsycl_sscp_memory_order::acquire:
+    return __ATOMIC_ACQUIRE;
+  case __hipsycl_sscp_memory_order::release:
+    return __ATOMIC_RELEASE;
+  case __hipsycl_sscp_memory_order::acq_rel:
+    return __ATOMIC_ACQ_REL;
+  case __hipsycl_sscp_memory_order::seq_cst:
+    return __ATOMIC_SEQ_CST;
+  }
+  return __ATOMIC_SEQ_CST;
+}
+
+#endif
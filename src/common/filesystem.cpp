@@ -29,8 +29,14 @@
 #include "hipSYCL/common/config.hpp"
 
 
+#include <fstream>
+
 #ifndef _WIN32
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #else
 #include <windows.h> 
 #endif
@@ -109,6 +115,49 @@ std::vector<std::string> list_regular_files(const std::string& directory,
   return result;
 }
 
+std::shared_ptr<mapped_file> mapped_file::open(const std::string& filename) {
+  std::shared_ptr<mapped_file> result{new mapped_file{}};
+#ifndef _WIN32
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    return nullptr;
+
+  struct stat file_info;
+  if(fstat(fd, &file_info) != 0) {
+    close(fd);
+    return nullptr;
+  }
+  result->_size = static_cast<std::size_t>(file_info.st_size);
+  if(result->_size > 0) {
+    void* addr = mmap(nullptr, result->_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(addr != MAP_FAILED) {
+      result->_data = static_cast<const char*>(addr);
+      result->_is_mapped = true;
+    }
+  }
+  close(fd);
+  if(result->_is_mapped || result->_size == 0)
+    return result;
+#endif
+  // Fall back to reading the file
+  std::ifstream file{filename, std::ios::binary | std::ios::ate};
+  if(!file.is_open())
+    return nullptr;
+  result->_size = static_cast<std::size_t>(file.tellg());
+  result->_buffer.resize(result->_size);
+  file.seekg(0, std::ios::beg);
+  file.read(result->_buffer.data(), result->_size);
+  result->_data = result->_buffer.data();
+  return result;
+}
+
+mapped_file::~mapped_file() {
+#ifndef _WIN32
+  if(_is_mapped)
+    munmap(const_cast<char*>(_data), _size);
+#endif
+}
+
 }
 }
 }
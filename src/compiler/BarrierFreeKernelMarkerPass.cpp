@@ -0,0 +1,197 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/compiler/BarrierFreeKernelMarkerPass.hpp"
+#include "hipSYCL/compiler/CompilationState.hpp"
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+namespace {
+
+constexpr const char *QueryAnnotation = "hipsycl_barrier_free_nd_kernel_query";
+constexpr const char *BarrierAnnotation = "hipsycl_barrier";
+constexpr const char *BarrierIntrinsicName = "__hipsycl_barrier";
+// Name under which the classification of kernels is reported as optimization
+// remark, e.g. -Rpass=hipsycl-barrier-free-kernel-marker for barrier-free
+// kernels and -Rpass-missed=hipsycl-barrier-free-kernel-marker for the others.
+constexpr const char *RemarkPassName = "hipsycl-barrier-free-kernel-marker";
+
+// Without opaque pointers, annotation operands are wrapped in bitcasts
+template <class T> T *lookThroughCast(llvm::Constant *V) {
+  if (auto *R = llvm::dyn_cast<T>(V))
+    return R;
+  if (V->getNumOperands() == 0)
+    return nullptr;
+  return llvm::dyn_cast<T>(V->getOperand(0));
+}
+
+template <class Handler>
+void forEachAnnotatedFunction(llvm::Module &M, Handler &&H) {
+  auto *Annotations = M.getGlobalVariable("llvm.global.annotations");
+  if (!Annotations || !Annotations->hasInitializer())
+    return;
+  auto *CA = llvm::dyn_cast<llvm::ConstantArray>(Annotations->getInitializer());
+  if (!CA)
+    return;
+
+  for (auto &Op : CA->operands()) {
+    auto *CS = llvm::dyn_cast<llvm::ConstantStruct>(Op.get());
+    if (!CS || CS->getNumOperands() < 2)
+      continue;
+    auto *F = lookThroughCast<llvm::Function>(CS->getOperand(0));
+    auto *AnnotationGV = lookThroughCast<llvm::GlobalVariable>(CS->getOperand(1));
+    if (!F || !AnnotationGV || !AnnotationGV->hasInitializer())
+      continue;
+    if (auto *Str = llvm::dyn_cast<llvm::ConstantDataArray>(AnnotationGV->getInitializer()))
+      H(F, Str->getAsCString());
+  }
+}
+
+// Conservative: Any call we cannot see through might end up in a barrier.
+// Declarations are only considered safe if they cannot receive an nd_item/group,
+// i.e. if they do not take any pointer arguments (e.g. math functions).
+bool mayReachBarrier(const llvm::CallBase &CB,
+                     const llvm::SmallPtrSetImpl<llvm::Function *> &Barriers) {
+  if (CB.isInlineAsm())
+    return false;
+
+  llvm::Function *Callee = CB.getCalledFunction();
+  if (!Callee)
+    return true;
+  if (Barriers.count(Callee))
+    return true;
+  if (Callee->isIntrinsic())
+    return false;
+  if (Callee->isDeclaration()) {
+    for (auto &Arg : CB.args())
+      if (Arg->getType()->isPointerTy())
+        return true;
+  }
+  return false;
+}
+
+bool isBarrierFree(llvm::Function *Query,
+                   const llvm::SmallPtrSetImpl<llvm::Function *> &Barriers) {
+  llvm::SmallPtrSet<llvm::Function *, 32> Visited;
+  llvm::SmallVector<llvm::Function *, 32> Worklist;
+  Worklist.push_back(Query);
+  Visited.insert(Query);
+
+  while (!Worklist.empty()) {
+    llvm::Function *F = Worklist.pop_back_val();
+    for (auto &I : llvm::instructions(*F)) {
+      if (auto *CB = llvm::dyn_cast<llvm::CallBase>(&I)) {
+        if (mayReachBarrier(*CB, Barriers))
+          return false;
+        llvm::Function *Callee = CB->getCalledFunction();
+        if (Callee && !Callee->isDeclaration() && Visited.insert(Callee).second)
+          Worklist.push_back(Callee);
+      }
+    }
+  }
+  return true;
+}
+
+void replaceWithConstantResult(llvm::Function *F, bool Result) {
+  auto Linkage = F->getLinkage();
+  F->deleteBody();
+  // Each TU resolves its own queries; make sure the linker
+  // cannot mix them up with the unresolved fallback from other TUs.
+  F->setLinkage(llvm::GlobalValue::isLocalLinkage(Linkage) ? Linkage
+                                                            : llvm::GlobalValue::InternalLinkage);
+  F->removeFnAttr(llvm::Attribute::OptimizeNone);
+  F->removeFnAttr(llvm::Attribute::NoInline);
+  F->addFnAttr(llvm::Attribute::AlwaysInline);
+
+  auto *BB = llvm::BasicBlock::Create(F->getContext(), "entry", F);
+  llvm::IRBuilder<> Builder{BB};
+  Builder.CreateRet(llvm::ConstantInt::get(F->getReturnType(), Result ? 1 : 0));
+}
+
+void emitClassificationRemark(llvm::Function *Query, bool IsBarrierFree) {
+  llvm::OptimizationRemarkEmitter ORE{Query};
+  if (IsBarrierFree)
+    ORE.emit(llvm::OptimizationRemark{RemarkPassName, "BarrierFree", Query}
+             << "nd_range kernel is barrier-free and runs without fibers");
+  else
+    ORE.emit(llvm::OptimizationRemarkMissed{RemarkPassName, "MayReachBarrier", Query}
+             << "nd_range kernel may reach a barrier and runs on fibers");
+}
+
+bool markBarrierFreeKernels(llvm::Module &M) {
+  llvm::SmallPtrSet<llvm::Function *, 8> Barriers;
+  llvm::SmallVector<llvm::Function *, 8> Queries;
+
+  if (auto *BarrierIntrinsic = M.getFunction(BarrierIntrinsicName))
+    Barriers.insert(BarrierIntrinsic);
+
+  forEachAnnotatedFunction(M, [&](llvm::Function *F, llvm::StringRef Annotation) {
+    if (Annotation == BarrierAnnotation)
+      Barriers.insert(F);
+    else if (Annotation == QueryAnnotation && !F->isDeclaration())
+      Queries.push_back(F);
+  });
+
+  for (auto *F : Queries) {
+    bool Result = isBarrierFree(F, Barriers);
+    emitClassificationRemark(F, Result);
+    replaceWithConstantResult(F, Result);
+  }
+  return !Queries.empty();
+}
+
+} // namespace
+
+bool hipsycl::compiler::BarrierFreeKernelMarkerPassLegacy::runOnModule(llvm::Module &M) {
+  if (CompilationStateManager::getASTPassState().isDeviceCompilation())
+    return false;
+
+  return markBarrierFreeKernels(M);
+}
+
+#if !defined(_WIN32) && LLVM_VERSION_MAJOR >= 11
+llvm::PreservedAnalyses
+hipsycl::compiler::BarrierFreeKernelMarkerPass::run(llvm::Module &M,
+                                                    llvm::ModuleAnalysisManager &AM) {
+  if (CompilationStateManager::getASTPassState().isDeviceCompilation())
+    return llvm::PreservedAnalyses::all();
+
+  if (!markBarrierFreeKernels(M))
+    return llvm::PreservedAnalyses::all();
+  return llvm::PreservedAnalyses::none();
+}
+#endif // !_WIN32 && LLVM_VERSION_MAJOR >= 11
+
+char hipsycl::compiler::BarrierFreeKernelMarkerPassLegacy::ID = 0;
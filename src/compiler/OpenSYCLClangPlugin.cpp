@@ -27,6 +27,7 @@
 #include "hipSYCL/common/config.hpp"
 
 #include "hipSYCL/compiler/FrontendPlugin.hpp"
+#include "hipSYCL/compiler/BarrierFreeKernelMarkerPass.hpp"
 #include "hipSYCL/compiler/GlobalsPruningPass.hpp"
 #include "hipSYCL/compiler/cbs/PipelineBuilder.hpp"
 
@@ -69,6 +70,19 @@ static llvm::RegisterStandardPasses
     RegisterGlobalsPruningPassOptLevel0(llvm::PassManagerBuilder::EP_EnabledOnOptLevel0,
                                         registerGlobalsPruningPass);
 
+static void registerBarrierFreeKernelMarkerPass(const llvm::PassManagerBuilder &,
+                                                llvm::legacy::PassManagerBase &PM) {
+  PM.add(new BarrierFreeKernelMarkerPassLegacy{});
+}
+
+static llvm::RegisterStandardPasses
+    RegisterBarrierFreeKernelMarkerPassOptLevel0(llvm::PassManagerBuilder::EP_EnabledOnOptLevel0,
+                                                 registerBarrierFreeKernelMarkerPass);
+
+static llvm::RegisterStandardPasses
+    RegisterBarrierFreeKernelMarkerPassEarly(llvm::PassManagerBuilder::EP_ModuleOptimizerEarly,
+                                             registerBarrierFreeKernelMarkerPass);
+
 static llvm::RegisterStandardPasses
     RegisterGlobalsPruningPassOptimizerLast(llvm::PassManagerBuilder::EP_OptimizerLast,
                                             registerGlobalsPruningPass);
@@ -115,6 +129,15 @@ extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo llvmGetPassPluginIn
           PB.registerOptimizerLastEPCallback([](llvm::ModulePassManager &MPM, OptLevel) {
             MPM.addPass(hipsycl::compiler::GlobalsPruningPass{});
           });
+          // Must run before any inlining or interprocedural constant propagation
+          // of the (unresolved) barrier-free queries can take place.
+#if LLVM_VERSION_MAJOR < 12
+          PB.registerPipelineStartEPCallback([](llvm::ModulePassManager &MPM) {
+#else
+          PB.registerPipelineStartEPCallback([](llvm::ModulePassManager &MPM, OptLevel) {
+#endif
+            MPM.addPass(hipsycl::compiler::BarrierFreeKernelMarkerPass{});
+          });
 
 #ifdef HIPSYCL_WITH_SSCP_COMPILER
           if(EnableLLVMSSCP){
@@ -55,6 +55,12 @@ bool hipsycl::compiler::SplitterAnnotationInfo::analyzeModule(llvm::Module &M) {
       HIPSYCL_DEBUG_INFO << "Found kernel annotated function " << F->getName() << "\n";
     }
   });
+
+  for (auto &F : M)
+    if (F.hasFnAttribute(hipsycl::compiler::NDKernelAttribute)) {
+      NDKernels.insert(&F);
+      HIPSYCL_DEBUG_INFO << "Found kernel attributed function " << F.getName() << "\n";
+    }
   return false;
 }
 
@@ -76,6 +76,13 @@ llvm::Instruction *getLoadForGlobalVariable(llvm::Function &F, llvm::StringRef V
 
 // parses the range dimensionality from the mangled kernel name
 std::size_t getRangeDim(llvm::Function &F) {
+  if (F.hasFnAttribute(NDKernelDimAttribute)) {
+    std::size_t Dim = 0;
+    if (!F.getFnAttribute(NDKernelDimAttribute).getValueAsString().getAsInteger(10, Dim) &&
+        Dim >= 1 && Dim <= 3)
+      return Dim;
+  }
+
   auto FName = F.getName();
   // todo: fix with MS mangling
   llvm::Regex Rgx("iterate_nd_range_ompILi([1-3])E");
@@ -89,6 +96,15 @@ std::size_t getRangeDim(llvm::Function &F) {
 // annotation instruction
 std::pair<llvm::Value *, llvm::Instruction *>
 getLocalSizeArgumentFromAnnotation(llvm::Function &F) {
+  if (F.hasFnAttribute(NDKernelLocalSizeArgAttribute)) {
+    unsigned ArgNo = 0;
+    if (!F.getFnAttribute(NDKernelLocalSizeArgAttribute)
+             .getValueAsString()
+             .getAsInteger(10, ArgNo) &&
+        ArgNo < F.arg_size())
+      return {F.getArg(ArgNo), nullptr};
+  }
+
   for (auto &BB : F)
     for (auto &I : BB)
       if (auto *UI = llvm::dyn_cast<llvm::CallInst>(&I))
@@ -181,7 +197,8 @@ llvm::SmallVector<llvm::Value *, 3> getLocalSizeValues(llvm::Function &F, int Di
   else
     loadSizeValuesFromArgument(F, Dim, LocalSizeArg, DL, LocalSize);
 
-  Annotation->eraseFromParent();
+  if (Annotation)
+    Annotation->eraseFromParent();
   return LocalSize;
 }
 
@@ -25,6 +25,7 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "hipSYCL/common/config.hpp"
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/AddressSpaceInferencePass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/LLVMToBackend.hpp"
@@ -34,6 +35,7 @@
 #include "hipSYCL/glue/llvm-sscp/s2_ir_constants.hpp"
 
 #include <cstdint>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/PassManager.h>
@@ -70,21 +72,39 @@ LLVMToBackendTranslator::LLVMToBackendTranslator(int S2IRConstantCurrentBackendI
   const std::vector<std::string>& OutliningEPs)
 : S2IRConstantBackendId(S2IRConstantCurrentBackendId), OutliningEntrypoints{OutliningEPs} {}
 
+#ifndef HIPSYCL_GIT_REVISION
+#define HIPSYCL_GIT_REVISION "unknown"
+#endif
+
+std::string LLVMToBackendTranslator::getCompilerIdentifier() {
+  // Include the git revision such that development builds of the same
+  // version do not share JIT cache entries.
+  return "hipSYCL-" + std::to_string(HIPSYCL_VERSION_MAJOR) + "." +
+         std::to_string(HIPSYCL_VERSION_MINOR) + "." +
+         std::to_string(HIPSYCL_VERSION_PATCH) + "-" + HIPSYCL_VERSION_TYPE +
+         " " HIPSYCL_GIT_REVISION " LLVM-" LLVM_VERSION_STRING;
+}
+
 bool LLVMToBackendTranslator::setBuildFlag(const std::string &Flag) { 
   HIPSYCL_DEBUG_INFO << "LLVMToBackend: Using build flag: " << Flag << "\n";
+  BuildConfiguration.push_back("flag:" + Flag);
   return applyBuildFlag(Flag);
 }
 
 bool LLVMToBackendTranslator::setBuildOption(const std::string &Option, const std::string &Value) {
   HIPSYCL_DEBUG_INFO << "LLVMToBackend: Using build option: " << Option << "=" << Value << "\n";
+  BuildConfiguration.push_back("option:" + Option + "=" + Value);
   return applyBuildOption(Option, Value);
 }
 bool LLVMToBackendTranslator::setBuildToolArguments(const std::string &ToolName,
                                     const std::vector<std::string> &Args) {
   HIPSYCL_DEBUG_INFO << "LLVMToBackend: Using tool arguments for tool " << ToolName << ":\n";
+  std::string ToolConfiguration = "tool:" + ToolName;
   for(const auto& A : Args) {
     HIPSYCL_DEBUG_INFO << "   " << A << "\n";
+    ToolConfiguration += " " + A;
   }
+  BuildConfiguration.push_back(ToolConfiguration);
   return applyBuildToolArguments(ToolName, Args);
 }
 
@@ -0,0 +1,103 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/compiler/llvm-to-backend/host/HostJIT.hpp"
+
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <mutex>
+
+namespace hipsycl {
+namespace compiler {
+namespace host {
+
+struct HostJITModule::Impl {
+  std::unique_ptr<llvm::orc::LLJIT> JIT;
+};
+
+HostJITModule::HostJITModule(std::unique_ptr<Impl> I)
+: JITImpl{std::move(I)} {}
+
+HostJITModule::~HostJITModule() {}
+
+std::unique_ptr<HostJITModule> HostJITModule::load(const std::string &ObjectFile,
+                                                   std::string &ErrorOut) {
+  static std::once_flag Flag;
+  std::call_once(Flag, [](){
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+  });
+
+  auto JIT = llvm::orc::LLJITBuilder().create();
+  if(!JIT) {
+    ErrorOut = "HostJIT: Could not create JIT: " + llvm::toString(JIT.takeError());
+    return nullptr;
+  }
+
+  // Resolve builtins that were lowered to libc/libm calls from the process
+  auto Generator = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+      (*JIT)->getDataLayout().getGlobalPrefix());
+  if(!Generator) {
+    ErrorOut = "HostJIT: Could not create symbol generator: " +
+               llvm::toString(Generator.takeError());
+    return nullptr;
+  }
+  (*JIT)->getMainJITDylib().addGenerator(std::move(*Generator));
+
+  auto Buffer = llvm::MemoryBuffer::getMemBufferCopy(ObjectFile, "hipsycl-sscp-host-object");
+  if(auto Err = (*JIT)->addObjectFile(std::move(Buffer))) {
+    ErrorOut = "HostJIT: Could not add object file: " + llvm::toString(std::move(Err));
+    return nullptr;
+  }
+
+  auto I = std::make_unique<Impl>();
+  I->JIT = std::move(*JIT);
+
+  return std::unique_ptr<HostJITModule>{new HostJITModule{std::move(I)}};
+}
+
+void *HostJITModule::getSymbol(const std::string &Name, std::string &ErrorOut) const {
+  auto Symbol = JITImpl->JIT->lookup(Name);
+  if(!Symbol) {
+    ErrorOut = "HostJIT: Could not look up symbol " + Name + ": " +
+               llvm::toString(Symbol.takeError());
+    return nullptr;
+  }
+#if LLVM_VERSION_MAJOR < 15
+  return reinterpret_cast<void *>(static_cast<uintptr_t>(Symbol->getAddress()));
+#else
+  return Symbol->toPtr<void *>();
+#endif
+}
+
+}
+}
+}
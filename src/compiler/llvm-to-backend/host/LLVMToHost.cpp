@@ -0,0 +1,488 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHost.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/HostKernelABI.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/AddressSpaceMap.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/Utils.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/AddressSpaceInferencePass.hpp"
+#include "hipSYCL/compiler/cbs/IRUtils.hpp"
+#include "hipSYCL/compiler/cbs/LoopsParallelMarker.hpp"
+#include "hipSYCL/compiler/cbs/PipelineBuilder.hpp"
+#include "hipSYCL/compiler/cbs/SplitterAnnotationAnalysis.hpp"
+#include "hipSYCL/glue/llvm-sscp/s2_ir_constants.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/IR/Attributes.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/GlobalValue.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Target/TargetOptions.h>
+#include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <llvm/Transforms/IPO/GlobalDCE.h>
+#include <llvm/MC/TargetRegistry.h>
+#if LLVM_VERSION_MAJOR < 17
+#include <llvm/MC/SubtargetFeature.h>
+#include <llvm/Support/Host.h>
+#else
+#include <llvm/TargetParser/SubtargetFeature.h>
+#include <llvm/TargetParser/Host.h>
+#endif
+#include <memory>
+#include <cassert>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+constexpr const char* DynamicLocalMemName = "__hipsycl_sscp_host_dynamic_local_mem";
+
+struct GroupGeometryGlobal {
+  const char* Name;
+  // Index of the entrypoint argument containing the value
+  unsigned ArgNo;
+  // Index within the argument array. Note that SSCP x is the
+  // fastest dimension, which is stored last.
+  unsigned Element;
+};
+
+constexpr GroupGeometryGlobal GroupGeometryGlobals[] = {
+    {"__hipsycl_sscp_host_local_size_x", 1, 2},
+    {"__hipsycl_sscp_host_local_size_y", 1, 1},
+    {"__hipsycl_sscp_host_local_size_z", 1, 0},
+    {"__hipsycl_sscp_host_group_id_x", 2, 2},
+    {"__hipsycl_sscp_host_group_id_y", 2, 1},
+    {"__hipsycl_sscp_host_group_id_z", 2, 0},
+    {"__hipsycl_sscp_host_num_groups_x", 3, 2},
+    {"__hipsycl_sscp_host_num_groups_y", 3, 1},
+    {"__hipsycl_sscp_host_num_groups_z", 3, 0}};
+
+constexpr unsigned LocalMemoryArgNo = 4;
+
+void initializeNativeTarget() {
+  static std::once_flag Flag;
+  std::call_once(Flag, [](){
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+  });
+}
+
+// Replaces all uses of C within F by V. Constant expressions using C are
+// expanded into instructions at InsertBefore, which must dominate all uses in F.
+void replaceConstantUsesInFunction(llvm::Constant *C, llvm::Value *V, llvm::Function &F,
+                                   llvm::Instruction *InsertBefore) {
+  llvm::SmallVector<llvm::User *, 16> Users{C->user_begin(), C->user_end()};
+  for (llvm::User *U : Users) {
+    if (auto *I = llvm::dyn_cast<llvm::Instruction>(U)) {
+      if (I->getFunction() == &F)
+        I->replaceUsesOfWith(C, V);
+    } else if (auto *CE = llvm::dyn_cast<llvm::ConstantExpr>(U)) {
+      llvm::Instruction *Expanded = CE->getAsInstruction();
+      Expanded->insertBefore(InsertBefore);
+      Expanded->replaceUsesOfWith(C, V);
+      replaceConstantUsesInFunction(CE, Expanded, F, InsertBefore);
+      if (Expanded->use_empty())
+        Expanded->eraseFromParent();
+    }
+  }
+}
+
+bool isUsedByInstructions(llvm::Constant* C) {
+  for(llvm::User* U : C->users()) {
+    if(llvm::isa<llvm::Instruction>(U))
+      return true;
+    if(auto* CE = llvm::dyn_cast<llvm::ConstantExpr>(U))
+      if(isUsedByInstructions(CE))
+        return true;
+  }
+  return false;
+}
+
+}
+
+LLVMToHostTranslator::LLVMToHostTranslator(const std::vector<std::string> &KN)
+    : LLVMToBackendTranslator{sycl::sscp::backend::host, KN}, KernelNames{KN} {
+  for(const auto& Name : KernelNames)
+    EntrypointNames.push_back(host::getEntrypointName(Name));
+}
+
+LLVMToHostTranslator::~LLVMToHostTranslator() {}
+
+bool LLVMToHostTranslator::initializeTargetMachine() {
+  if(TM)
+    return true;
+
+  initializeNativeTarget();
+
+  std::string Triple = llvm::sys::getProcessTriple();
+  std::string Error;
+  const llvm::Target *Target = llvm::TargetRegistry::lookupTarget(Triple, Error);
+  if (!Target) {
+    this->registerError("LLVMToHost: Could not find target for triple " + Triple + ": " + Error);
+    return false;
+  }
+
+  std::string CPU;
+  std::string Features;
+  getEffectiveTarget(CPU, Features);
+
+  HIPSYCL_DEBUG_INFO << "LLVMToHost: Targeting " << Triple << ", CPU " << CPU << "\n";
+
+  llvm::TargetOptions Options;
+  TM.reset(Target->createTargetMachine(Triple, CPU, Features, Options,
+                                       llvm::Reloc::PIC_, {},
+#if LLVM_VERSION_MAJOR < 18
+                                       llvm::CodeGenOpt::Aggressive
+#else
+                                       llvm::CodeGenOptLevel::Aggressive
+#endif
+                                       ));
+  if(!TM) {
+    this->registerError("LLVMToHost: Could not create target machine");
+    return false;
+  }
+  return true;
+}
+
+void LLVMToHostTranslator::getEffectiveTarget(std::string &CPU,
+                                              std::string &Features) const {
+  CPU = TargetCPU;
+  if(CPU.empty())
+    CPU = llvm::sys::getHostCPUName().str();
+
+  llvm::SubtargetFeatures SubtargetFeatures;
+  // Only query host features when compiling for the host CPU
+  if (CPU == llvm::sys::getHostCPUName()) {
+#if LLVM_VERSION_MAJOR < 19
+    llvm::StringMap<bool> HostFeatures;
+    if (llvm::sys::getHostCPUFeatures(HostFeatures))
+#else
+    llvm::StringMap<bool> HostFeatures = llvm::sys::getHostCPUFeatures();
+#endif
+      for (const auto &F : HostFeatures)
+        SubtargetFeatures.AddFeature(F.first(), F.second);
+  }
+  Features = SubtargetFeatures.getString();
+}
+
+std::vector<std::string> LLVMToHostTranslator::getTargetConfiguration() const {
+  std::string CPU;
+  std::string Features;
+  getEffectiveTarget(CPU, Features);
+  // Cached code must not be reused on a machine with a different ISA
+  return {"triple=" + llvm::sys::getProcessTriple(), "cpu=" + CPU,
+          "features=" + Features};
+}
+
+bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler& PH) {
+  if(!initializeTargetMachine())
+    return false;
+
+  M.setTargetTriple(TM->getTargetTriple().str());
+  M.setDataLayout(TM->createDataLayout());
+
+  AddressSpaceMap ASMap = getAddressSpaceMap();
+
+  KernelFunctionParameterRewriter ParamRewriter{
+      KernelFunctionParameterRewriter::ByValueArgAttribute::ByVal,
+      ASMap[AddressSpace::Generic],
+      ASMap[AddressSpace::Global]};
+
+  ParamRewriter.run(M, KernelNames, *PH.ModuleAnalysisManager);
+
+  AddressSpaceInferencePass ASIPass {ASMap};
+  ASIPass.run(M, *PH.ModuleAnalysisManager);
+
+  std::string BuiltinBitcodeFile = 
+    common::filesystem::join_path(common::filesystem::get_install_directory(),
+      {"lib", "hipSYCL", "bitcode", "libkernel-sscp-host-full.bc"});
+
+  if(!this->linkBitcodeFile(M, BuiltinBitcodeFile))
+    return false;
+
+  for(const auto& KernelName : KernelNames) {
+    if(auto* F = M.getFunction(KernelName)) {
+      if(!createEntrypoint(M, *F))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+bool LLVMToHostTranslator::createEntrypoint(llvm::Module &M, llvm::Function &Kernel) {
+  llvm::LLVMContext &Ctx = M.getContext();
+  const llvm::DataLayout &DL = M.getDataLayout();
+
+  llvm::Type *SizeT = DL.getIntPtrType(Ctx);
+  llvm::Type *VoidPtrT = llvm::PointerType::getUnqual(llvm::Type::getInt8Ty(Ctx));
+  llvm::Type *SizePtrT = llvm::PointerType::getUnqual(SizeT);
+  llvm::Type *ArgsT = llvm::PointerType::getUnqual(VoidPtrT);
+
+  llvm::FunctionType *EntrypointT = llvm::FunctionType::get(
+      llvm::Type::getVoidTy(Ctx), {ArgsT, SizePtrT, SizePtrT, SizePtrT, VoidPtrT}, false);
+
+  std::string KernelName = Kernel.getName().str();
+  llvm::Function *Entrypoint =
+      llvm::Function::Create(EntrypointT, llvm::GlobalValue::ExternalLinkage,
+                             host::getEntrypointName(KernelName), M);
+  // Mark as nd-range kernel for the CBS pipeline. All three dimensions are
+  // always iterated; the local size array is the second argument.
+  Entrypoint->addFnAttr(NDKernelAttribute);
+  Entrypoint->addFnAttr(NDKernelDimAttribute, "3");
+  Entrypoint->addFnAttr(NDKernelLocalSizeArgAttribute, "1");
+  Entrypoint->addFnAttr(llvm::Attribute::NoUnwind);
+
+  // The kernel will be inlined into the entrypoint
+  Kernel.removeFnAttr(llvm::Attribute::NoInline);
+  Kernel.removeFnAttr(llvm::Attribute::OptimizeNone);
+
+  llvm::BasicBlock *BB = llvm::BasicBlock::Create(Ctx, "entry", Entrypoint);
+  llvm::IRBuilder<> Builder{BB};
+
+  llvm::SmallVector<llvm::Value *, 8> CallArgs;
+  for (unsigned i = 0; i < Kernel.arg_size(); ++i) {
+    llvm::Value *ArgPtrPtr = Builder.CreateConstInBoundsGEP1_64(VoidPtrT, Entrypoint->getArg(0), i);
+    llvm::Value *ArgPtr = Builder.CreateLoad(VoidPtrT, ArgPtrPtr);
+    llvm::Type *ParamT = Kernel.getFunctionType()->getParamType(i);
+
+    if (Kernel.hasParamAttribute(i, llvm::Attribute::ByVal)) {
+      // Aggregates are passed as pointer to the argument data
+      CallArgs.push_back(Builder.CreatePointerBitCastOrAddrSpaceCast(ArgPtr, ParamT));
+    } else {
+      llvm::Value *TypedArgPtr =
+          Builder.CreatePointerBitCastOrAddrSpaceCast(ArgPtr, llvm::PointerType::getUnqual(ParamT));
+      CallArgs.push_back(Builder.CreateLoad(ParamT, TypedArgPtr));
+    }
+  }
+  llvm::CallInst *Call = Builder.CreateCall(Kernel.getFunctionType(), &Kernel, CallArgs);
+  Call->setCallingConv(Kernel.getCallingConv());
+  Builder.CreateRetVoid();
+
+  return true;
+}
+
+bool LLVMToHostTranslator::lowerGroupGeometry(llvm::Module &M, llvm::Function &Entrypoint) {
+  llvm::Instruction *InsertBefore = Entrypoint.getEntryBlock().getFirstNonPHI();
+  llvm::IRBuilder<> Builder{InsertBefore};
+  llvm::Type *SizeT = M.getDataLayout().getIntPtrType(M.getContext());
+
+  for (const auto &G : GroupGeometryGlobals) {
+    if (auto *GV = M.getGlobalVariable(G.Name)) {
+      llvm::Value *Ptr =
+          Builder.CreateConstInBoundsGEP1_64(SizeT, Entrypoint.getArg(G.ArgNo), G.Element);
+      Ptr = Builder.CreatePointerBitCastOrAddrSpaceCast(Ptr, GV->getType());
+      replaceConstantUsesInFunction(GV, Ptr, Entrypoint, InsertBefore);
+    }
+  }
+  return true;
+}
+
+bool LLVMToHostTranslator::lowerLocalMemory(llvm::Module &M) {
+  unsigned LocalAS = getAddressSpaceMap()[AddressSpace::Local];
+  const llvm::DataLayout &DL = M.getDataLayout();
+
+  // Statically sized local memory variables come first, followed by
+  // the dynamic local memory.
+  llvm::SmallVector<std::pair<llvm::GlobalVariable *, uint64_t>, 8> Layout;
+  llvm::GlobalVariable *DynamicLocalMem = nullptr;
+  uint64_t CurrentOffset = 0;
+
+  for (auto &GV : M.globals()) {
+    if (GV.getAddressSpace() != LocalAS || !isUsedByInstructions(&GV))
+      continue;
+    if (GV.getName() == DynamicLocalMemName) {
+      DynamicLocalMem = &GV;
+      continue;
+    }
+    uint64_t Alignment = std::max<uint64_t>(DL.getPreferredAlign(&GV).value(), 16);
+    CurrentOffset = llvm::alignTo(CurrentOffset, Alignment);
+    Layout.push_back(std::make_pair(&GV, CurrentOffset));
+    CurrentOffset += DL.getTypeAllocSize(GV.getValueType());
+  }
+
+  uint64_t StaticSize = llvm::alignTo(CurrentOffset, host::LocalMemoryAlignment);
+  if (DynamicLocalMem)
+    Layout.push_back(std::make_pair(DynamicLocalMem, StaticSize));
+
+  llvm::Type *SizeT = DL.getIntPtrType(M.getContext());
+  for (std::size_t i = 0; i < KernelNames.size(); ++i) {
+    llvm::Function *Entrypoint = M.getFunction(EntrypointNames[i]);
+    if (!Entrypoint)
+      continue;
+
+    llvm::Instruction *InsertBefore = Entrypoint->getEntryBlock().getFirstNonPHI();
+    llvm::IRBuilder<> Builder{InsertBefore};
+    for (const auto &Entry : Layout) {
+      llvm::Value *Ptr = Builder.CreateConstInBoundsGEP1_64(
+          Builder.getInt8Ty(), Entrypoint->getArg(LocalMemoryArgNo), Entry.second);
+      Ptr = Builder.CreatePointerBitCastOrAddrSpaceCast(Ptr, Entry.first->getType());
+      replaceConstantUsesInFunction(Entry.first, Ptr, *Entrypoint, InsertBefore);
+    }
+
+    new llvm::GlobalVariable(M, SizeT, true, llvm::GlobalValue::ExternalLinkage,
+                             llvm::ConstantInt::get(SizeT, StaticSize),
+                             host::getLocalMemSizeSymbolName(KernelNames[i]));
+  }
+
+  for (const auto &Entry : Layout) {
+    Entry.first->removeDeadConstantUsers();
+    if (isUsedByInstructions(Entry.first)) {
+      this->registerError("LLVMToHost: Local memory variable " + Entry.first->getName().str() +
+                          " is used outside of kernel entrypoints");
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LLVMToHostTranslator::optimizeFlavoredIR(llvm::Module &M, PassHandler &PH) {
+  assert(TM);
+
+  // Inline kernels and builtins into the entrypoints first, such that
+  // group geometry and local memory can be resolved to entrypoint arguments.
+  llvm::ModulePassManager InlineMPM;
+  InlineMPM.addPass(llvm::AlwaysInlinerPass{});
+  InlineMPM.addPass(llvm::GlobalDCEPass{});
+  InlineMPM.run(M, *PH.ModuleAnalysisManager);
+
+  for (const auto &Name : EntrypointNames)
+    if (auto *F = M.getFunction(Name))
+      if (!lowerGroupGeometry(M, *F))
+        return false;
+
+  if (!lowerLocalMemory(M))
+    return false;
+
+  // Construct a dedicated pass builder which knows about the target machine,
+  // otherwise the vectorizer has no information about the available vector units.
+  llvm::LoopAnalysisManager LAM;
+  llvm::FunctionAnalysisManager FAM;
+  llvm::CGSCCAnalysisManager CGAM;
+  llvm::ModuleAnalysisManager MAM;
+  llvm::PassBuilder PB{TM.get()};
+
+  MAM.registerPass([] { return SplitterAnnotationAnalysis{}; });
+  PB.registerModuleAnalyses(MAM);
+  PB.registerCGSCCAnalyses(CGAM);
+  PB.registerFunctionAnalyses(FAM);
+  PB.registerLoopAnalyses(LAM);
+  PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+  // Same configuration as the CBS pipeline of the clang plugin
+  PB.registerPipelineStartEPCallback([](llvm::ModulePassManager &MPM, OptLevel Opt) {
+    registerCBSPipeline(MPM, Opt);
+  });
+  PB.registerVectorizerStartEPCallback([](llvm::FunctionPassManager &FPM, OptLevel) {
+    FPM.addPass(LoopsParallelMarkerPass{});
+  });
+
+  llvm::ModulePassManager MPM = PB.buildPerModuleDefaultPipeline(OptLevel::O3);
+  MPM.run(M, MAM);
+
+  return true;
+}
+
+bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule, std::string &out) {
+  assert(TM);
+
+  llvm::SmallVector<char, 0> Buffer;
+  llvm::raw_svector_ostream OS{Buffer};
+
+  llvm::legacy::PassManager PM;
+  if (TM->addPassesToEmitFile(PM, OS, nullptr,
+#if LLVM_VERSION_MAJOR < 18
+                              llvm::CGFT_ObjectFile
+#else
+                              llvm::CodeGenFileType::ObjectFile
+#endif
+                              )) {
+    this->registerError("LLVMToHost: Target machine cannot emit object files");
+    return false;
+  }
+  PM.run(FlavoredModule);
+
+  out.assign(Buffer.begin(), Buffer.end());
+  HIPSYCL_DEBUG_INFO << "LLVMToHost: Emitted object file of " << out.size() << " bytes\n";
+
+  return true;
+}
+
+bool LLVMToHostTranslator::applyBuildOption(const std::string &Option, const std::string &Value) {
+  if(Option == "host-target-cpu") {
+    this->TargetCPU = Value;
+    return true;
+  }
+
+  return false;
+}
+
+bool LLVMToHostTranslator::isKernelAfterFlavoring(llvm::Function& F) {
+  for(const auto& Name : EntrypointNames)
+    if(F.getName() == Name)
+      return true;
+  return false;
+}
+
+AddressSpaceMap LLVMToHostTranslator::getAddressSpaceMap() const {
+  AddressSpaceMap ASMap;
+
+  // Only local memory needs to be distinguishable so that it can be
+  // mapped to the per-group local memory buffer. x86 and AArch64 treat
+  // address space casts between these address spaces as no-ops.
+  ASMap[AddressSpace::Generic] = 0;
+  ASMap[AddressSpace::Global] = 0;
+  ASMap[AddressSpace::Local] = 3;
+  ASMap[AddressSpace::Private] = 0;
+  ASMap[AddressSpace::Constant] = 0;
+  ASMap[AddressSpace::AllocaDefault] = 0;
+  ASMap[AddressSpace::GlobalVariableDefault] = 0;
+
+  return ASMap;
+}
+
+std::unique_ptr<LLVMToBackendTranslator>
+createLLVMToHostTranslator(const std::vector<std::string> &KernelNames) {
+  return std::make_unique<LLVMToHostTranslator>(KernelNames);
+}
+
+}
+}
@@ -362,7 +362,7 @@ std::string generateHCF(llvm::Module& DeviceModule,
   }
   
 
-  return HcfObject.serialize();
+  return HcfObject.serialize_binary();
 }
 
 llvm::PreservedAnalyses TargetSeparationPass::run(llvm::Module &M,
@@ -0,0 +1,156 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/sycl/libkernel/sscp/builtins/atomic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/builtin_config.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/host/host_common.hpp"
+
+// All atomics are lowered to the clang __atomic builtins. Since all
+// work items of a group are executed by the same thread, memory scopes
+// narrower than the device scope do not require special treatment.
+
+namespace {
+
+inline int get_failure_order(__hipsycl_sscp_memory_order order) {
+  // The failure ordering of a compare-exchange cannot be a release
+  // ordering.
+  if (order == __hipsycl_sscp_memory_order::release)
+    return __ATOMIC_RELAXED;
+  if (order == __hipsycl_sscp_memory_order::acq_rel)
+    return __ATOMIC_ACQUIRE;
+  return __hipsycl_sscp_host_get_builtin_memory_order(order);
+}
+
+template <class T, class F>
+inline T cas_fetch_op(__hipsycl_sscp_memory_order order, T *ptr, T x, F op) {
+  int builtin_order = __hipsycl_sscp_host_get_builtin_memory_order(order);
+  T old;
+  __atomic_load(ptr, &old, __ATOMIC_RELAXED);
+  T desired = op(old, x);
+  while (!__atomic_compare_exchange(ptr, &old, &desired, true, builtin_order,
+                                    __ATOMIC_RELAXED)) {
+    desired = op(old, x);
+  }
+  return old;
+}
+
+template <class T> inline T min_op(T a, T b) { return (b < a) ? b : a; }
+template <class T> inline T max_op(T a, T b) { return (a < b) ? b : a; }
+template <class T> inline T add_op(T a, T b) { return a + b; }
+template <class T> inline T sub_op(T a, T b) { return a - b; }
+
+}
+
+#define HIPSYCL_SSCP_HOST_ATOMIC_STORE(suffix, type)                           \
+  HIPSYCL_SSCP_BUILTIN void __hipsycl_sscp_atomic_store_##suffix(              \
+      __hipsycl_sscp_address_space as, __hipsycl_sscp_memory_order order,      \
+      __hipsycl_sscp_memory_scope scope, type *ptr, type x) {                  \
+    __atomic_store_n(ptr, x,                                                   \
+                     __hipsycl_sscp_host_get_builtin_memory_order(order));     \
+  }
+
+#define HIPSYCL_SSCP_HOST_ATOMIC_LOAD(suffix, type)                            \
+  HIPSYCL_SSCP_BUILTIN type __hipsycl_sscp_atomic_load_##suffix(               \
+      __hipsycl_sscp_address_space as, __hipsycl_sscp_memory_order order,      \
+      __hipsycl_sscp_memory_scope scope, type *ptr) {                          \
+    return __atomic_load_n(ptr,                                                \
+                           __hipsycl_sscp_host_get_builtin_memory_order(order)); \
+  }
+
+#define HIPSYCL_SSCP_HOST_ATOMIC_EXCHANGE(suffix, type)                        \
+  HIPSYCL_SSCP_BUILTIN type __hipsycl_sscp_atomic_exchange_##suffix(           \
+      __hipsycl_sscp_address_space as, __hipsycl_sscp_memory_order order,      \
+      __hipsycl_sscp_memory_scope scope, type *ptr, type x) {                  \
+    return __atomic_exchange_n(                                                \
+        ptr, x, __hipsycl_sscp_host_get_builtin_memory_order(order));          \
+  }
+
+#define HIPSYCL_SSCP_HOST_CMP_EXCH(strength, is_weak, suffix, type)            \
+  HIPSYCL_SSCP_BUILTIN bool __hipsycl_sscp_cmp_exch_##strength##_##suffix(     \
+      __hipsycl_sscp_address_space as, __hipsycl_sscp_memory_order success,    \
+      __hipsycl_sscp_memory_order failure, __hipsycl_sscp_memory_scope scope,  \
+      type *ptr, type *expected, type desired) {                               \
+    return __atomic_compare_exchange_n(                                        \
+        ptr, expected, desired, is_weak,                                       \
+        __hipsycl_sscp_host_get_builtin_memory_order(success),                 \
+        get_failure_order(failure));                                           \
+  }
+
+#define HIPSYCL_SSCP_HOST_ATOMIC_FETCH_OP(op, suffix, type)                    \
+  HIPSYCL_SSCP_BUILTIN type __hipsycl_sscp_atomic_fetch_##op##_##suffix(       \
+      __hipsycl_sscp_address_space as, __hipsycl_sscp_memory_order order,      \
+      __hipsycl_sscp_memory_scope scope, type *ptr, type x) {                  \
+    return __atomic_fetch_##op(                                                \
+        ptr, x, __hipsycl_sscp_host_get_builtin_memory_order(order));          \
+  }
+
+#define HIPSYCL_SSCP_HOST_ATOMIC_CAS_FETCH_OP(op, suffix, type)                \
+  HIPSYCL_SSCP_BUILTIN type __hipsycl_sscp_atomic_fetch_##op##_##suffix(       \
+      __hipsycl_sscp_address_space as, __hipsycl_sscp_memory_order order,      \
+      __hipsycl_sscp_memory_scope scope, type *ptr, type x) {                  \
+    return cas_fetch_op(order, ptr, x, op##_op<type>);                         \
+  }
+
+#define HIPSYCL_SSCP_HOST_INTEGER_ATOMICS(suffix, type)                        \
+  HIPSYCL_SSCP_HOST_ATOMIC_STORE(suffix, type)                                 \
+  HIPSYCL_SSCP_HOST_ATOMIC_LOAD(suffix, type)                                  \
+  HIPSYCL_SSCP_HOST_ATOMIC_EXCHANGE(suffix, type)                              \
+  HIPSYCL_SSCP_HOST_CMP_EXCH(weak, true, suffix, type)                         \
+  HIPSYCL_SSCP_HOST_CMP_EXCH(strong, false, suffix, type)                      \
+  HIPSYCL_SSCP_HOST_ATOMIC_FETCH_OP(and, suffix, type)                         \
+  HIPSYCL_SSCP_HOST_ATOMIC_FETCH_OP(or, suffix, type)                          \
+  HIPSYCL_SSCP_HOST_ATOMIC_FETCH_OP(xor, suffix, type)
+
+#define HIPSYCL_SSCP_HOST_ARITHMETIC_ATOMICS(suffix, type)                     \
+  HIPSYCL_SSCP_HOST_ATOMIC_FETCH_OP(add, suffix, type)                         \
+  HIPSYCL_SSCP_HOST_ATOMIC_FETCH_OP(sub, suffix, type)                         \
+  HIPSYCL_SSCP_HOST_ATOMIC_CAS_FETCH_OP(min, suffix, type)                     \
+  HIPSYCL_SSCP_HOST_ATOMIC_CAS_FETCH_OP(max, suffix, type)
+
+#define HIPSYCL_SSCP_HOST_FLOAT_ATOMICS(suffix, type)                          \
+  HIPSYCL_SSCP_HOST_ATOMIC_CAS_FETCH_OP(add, suffix, type)                     \
+  HIPSYCL_SSCP_HOST_ATOMIC_CAS_FETCH_OP(sub, suffix, type)                     \
+  HIPSYCL_SSCP_HOST_ATOMIC_CAS_FETCH_OP(min, suffix, type)                     \
+  HIPSYCL_SSCP_HOST_ATOMIC_CAS_FETCH_OP(max, suffix, type)
+
+HIPSYCL_SSCP_HOST_INTEGER_ATOMICS(i8, __hipsycl_int8)
+HIPSYCL_SSCP_HOST_INTEGER_ATOMICS(i16, __hipsycl_int16)
+HIPSYCL_SSCP_HOST_INTEGER_ATOMICS(i32, __hipsycl_int32)
+HIPSYCL_SSCP_HOST_INTEGER_ATOMICS(i64, __hipsycl_int64)
+
+HIPSYCL_SSCP_HOST_ARITHMETIC_ATOMICS(i8, __hipsycl_int8)
+HIPSYCL_SSCP_HOST_ARITHMETIC_ATOMICS(i16, __hipsycl_int16)
+HIPSYCL_SSCP_HOST_ARITHMETIC_ATOMICS(i32, __hipsycl_int32)
+HIPSYCL_SSCP_HOST_ARITHMETIC_ATOMICS(i64, __hipsycl_int64)
+
+HIPSYCL_SSCP_HOST_ARITHMETIC_ATOMICS(u8, __hipsycl_uint8)
+HIPSYCL_SSCP_HOST_ARITHMETIC_ATOMICS(u16, __hipsycl_uint16)
+HIPSYCL_SSCP_HOST_ARITHMETIC_ATOMICS(u32, __hipsycl_uint32)
+HIPSYCL_SSCP_HOST_ARITHMETIC_ATOMICS(u64, __hipsycl_uint64)
+
+HIPSYCL_SSCP_HOST_FLOAT_ATOMICS(f32, __hipsycl_f32)
+HIPSYCL_SSCP_HOST_FLOAT_ATOMICS(f64, __hipsycl_f64)
@@ -0,0 +1,215 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2019-2022 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/sycl/libkernel/sscp/builtins/math.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/builtin_config.hpp"
+
+#define PI 3.14159265358979323846
+
+#define HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(name, float_version,                \
+                                           double_version)                     \
+  HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_##name##_f32(float x) {            \
+    return float_version(x);                                                   \
+  }                                                                            \
+  HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_##name##_f64(double x) {          \
+    return double_version(x);                                                  \
+  }
+
+#define HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(name, float_version,               \
+                                            double_version)                    \
+  HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_##name##_f32(float x, float y) {   \
+    return float_version(x, y);                                                \
+  }                                                                            \
+  HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_##name##_f64(double x,            \
+                                                          double y) {          \
+    return double_version(x, y);                                               \
+  }
+
+#define HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN3(name, float_version,               \
+                                            double_version)                    \
+  HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_##name##_f32(float x, float y,     \
+                                                         float z) {            \
+    return float_version(x, y, z);                                             \
+  }                                                                            \
+  HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_##name##_f64(double x, double y,  \
+                                                          double z) {          \
+    return double_version(x, y, z);                                            \
+  }
+
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(acos, __builtin_acosf, __builtin_acos)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(acosh, __builtin_acoshf, __builtin_acosh)
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_acospi_f32(float x) { return __hipsycl_sscp_acos_f32(x) / PI; }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_acospi_f64(double x) { return __hipsycl_sscp_acos_f64(x) / PI; }
+
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(asin, __builtin_asinf, __builtin_asin)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(asinh, __builtin_asinhf, __builtin_asinh)
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_asinpi_f32(float x) { return __hipsycl_sscp_asin_f32(x) / PI; }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_asinpi_f64(double x) { return __hipsycl_sscp_asin_f64(x) / PI; }
+
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(atan, __builtin_atanf, __builtin_atan)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(atan2, __builtin_atan2f, __builtin_atan2)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(atanh, __builtin_atanhf, __builtin_atanh)
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_atanpi_f32(float x) { return __hipsycl_sscp_atan_f32(x) / PI; }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_atanpi_f64(double x) { return __hipsycl_sscp_atan_f64(x) / PI; }
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_atan2pi_f32(float x, float y) { return __hipsycl_sscp_atan2_f32(x, y) / PI; }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_atan2pi_f64(double x, double y) { return __hipsycl_sscp_atan2_f64(x, y) / PI; }
+
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(cbrt, __builtin_cbrtf, __builtin_cbrt)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(ceil, __builtin_ceilf, __builtin_ceil)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(copysign, __builtin_copysignf, __builtin_copysign)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(cos, __builtin_cosf, __builtin_cos)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(cosh, __builtin_coshf, __builtin_cosh)
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_cospi_f32(float x) { return __builtin_cosf(x * static_cast<float>(PI)); }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_cospi_f64(double x) { return __builtin_cos(x * PI); }
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(erf, __builtin_erff, __builtin_erf)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(erfc, __builtin_erfcf, __builtin_erfc)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(exp, __builtin_expf, __builtin_exp)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(exp2, __builtin_exp2f, __builtin_exp2)
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_exp10_f32(float x) { return __builtin_powf(10.f, x); }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_exp10_f64(double x) { return __builtin_pow(10., x); }
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(pow, __builtin_powf, __builtin_pow)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(expm1, __builtin_expm1f, __builtin_expm1)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(fabs, __builtin_fabsf, __builtin_fabs)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(fdim, __builtin_fdimf, __builtin_fdim)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(floor, __builtin_floorf, __builtin_floor)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN3(fma, __builtin_fmaf, __builtin_fma)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(fmax, __builtin_fmaxf, __builtin_fmax)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(fmin, __builtin_fminf, __builtin_fmin)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(fmod, __builtin_fmodf, __builtin_fmod)
+
+// fmin(x - floor(x), nextafter(genfloat(1.0), genfloat(0.0)) ). floor(x) is returned in iptr.
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_fract_f32(float x, float* y ) {
+  *y = __hipsycl_sscp_floor_f32(x);
+  return __hipsycl_sscp_fmin_f32(x - *y, __hipsycl_sscp_nextafter_f32(1.f, 0.f));
+}
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_fract_f64(double x, double* y) {
+  *y = __hipsycl_sscp_floor_f64(x);
+  return __hipsycl_sscp_fmin_f64(x - *y, __hipsycl_sscp_nextafter_f64(1.f, 0.f));
+}
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_frexp_f32(float x,
+                                                    __hipsycl_int32 *y) {
+  return __builtin_frexpf(x, y);
+}
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_frexp_f64(double x,
+                                                     __hipsycl_int64 *y) {
+  __hipsycl_int32 w;
+  double res = __builtin_frexp(x, &w);
+  *y = static_cast<__hipsycl_int64>(w);
+  return res;
+}
+
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(hypot, __builtin_hypotf, __builtin_hypot)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(ilogb, __builtin_ilogbf, __builtin_ilogb)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(tgamma, __builtin_tgammaf, __builtin_tgamma)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(lgamma, __builtin_lgammaf, __builtin_lgamma)
+
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_lgamma_r_f32(float x, __hipsycl_int32* y ) {
+  auto r = __hipsycl_sscp_lgamma_f32(x);
+  auto g = __hipsycl_sscp_tgamma_f32(x);
+  *y = (g >= 0) ? 1 : -1;
+  return r;
+}
+
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_lgamma_r_f64(double x, __hipsycl_int64* y) {
+  auto r = __hipsycl_sscp_lgamma_f64(x);
+  auto g = __hipsycl_sscp_tgamma_f64(x);
+  *y = (g >= 0) ? 1 : -1;
+  return r;
+}
+
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(log, __builtin_logf, __builtin_log)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(log2, __builtin_log2f, __builtin_log2)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(log10, __builtin_log10f, __builtin_log10)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(log1p, __builtin_log1pf, __builtin_log1p)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(logb, __builtin_logbf, __builtin_logb)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN3(mad, __builtin_fmaf, __builtin_fma)
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_maxmag_f32(float x, float y) {
+  auto abs_x = __hipsycl_sscp_fabs_f32(x);
+  auto abs_y = __hipsycl_sscp_fabs_f32(y);
+  if(abs_x == abs_y) return __hipsycl_sscp_fmax_f32(x,y);
+  return (abs_x > abs_y) ? x : y;
+}
+
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_maxmag_f64(double x, double y) {
+  auto abs_x = __hipsycl_sscp_fabs_f64(x);
+  auto abs_y = __hipsycl_sscp_fabs_f64(y);
+  if(abs_x == abs_y) return __hipsycl_sscp_fmax_f64(x,y);
+  return (abs_x > abs_y) ? x : y;
+}
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_minmag_f32(float x, float y) {
+  auto abs_x = __hipsycl_sscp_fabs_f32(x);
+  auto abs_y = __hipsycl_sscp_fabs_f32(y);
+  if(abs_x == abs_y) return __hipsycl_sscp_fmin_f32(x,y);
+  return (abs_x < abs_y) ? x : y;
+}
+
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_minmag_f64(double x, double y) {
+  auto abs_x = __hipsycl_sscp_fabs_f64(x);
+  auto abs_y = __hipsycl_sscp_fabs_f64(y);
+  if(abs_x == abs_y) return __hipsycl_sscp_fmin_f64(x,y);
+  return (abs_x < abs_y) ? x : y;
+}
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_modf_f32(float x, float* y ) { return __builtin_modff(x, y); }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_modf_f64(double x, double* y) { return __builtin_modf(x, y); }
+
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(nextafter, __builtin_nextafterf, __builtin_nextafter)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(powr, __builtin_powf, __builtin_pow)
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_pown_f32(float x, __hipsycl_int32 y) {
+  return __builtin_powif(x, y);
+}
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_pown_f64(double x,
+                                                    __hipsycl_int64 y) {
+  return __builtin_powi(x, static_cast<__hipsycl_int32>(y));
+}
+
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN2(remainder, __builtin_remainderf, __builtin_remainder)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(rint, __builtin_rintf, __builtin_rint)
+
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_rootn_f32(float x, __hipsycl_int32 y) { return __hipsycl_sscp_pow_f32(x, 1.f/y); }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_rootn_f64(double x, __hipsycl_int64 y) {return __hipsycl_sscp_pow_f64(x, 1./y); }
+
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(round, __builtin_roundf, __builtin_round)
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_rsqrt_f32(float x) { return 1.f / __builtin_sqrtf(x); }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_rsqrt_f64(double x) { return 1. / __builtin_sqrt(x); }
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(sqrt, __builtin_sqrtf, __builtin_sqrt)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(sin, __builtin_sinf, __builtin_sin)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(sinh, __builtin_sinhf, __builtin_sinh)
+HIPSYCL_SSCP_BUILTIN float __hipsycl_sscp_sinpi_f32(float x) { return __builtin_sinf(x * static_cast<float>(PI)); }
+HIPSYCL_SSCP_BUILTIN double __hipsycl_sscp_sinpi_f64(double x) { return __builtin_sin(x * PI); }
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(tan, __builtin_tanf, __builtin_tan)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(tanh, __builtin_tanhf, __builtin_tanh)
+HIPSYCL_SSCP_MAP_HOST_FLOAT_BUILTIN(trunc, __builtin_truncf, __builtin_trunc)
@@ -31,7 +31,10 @@
 #include "hipSYCL/runtime/dag_manager.hpp"
 #include "hipSYCL/runtime/runtime.hpp"
 #include "hipSYCL/runtime/hw_model/hw_model.hpp"
+#include "hipSYCL/runtime/jit_compilation_service.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
 #include "hipSYCL/runtime/settings.hpp"
+#include <cstdlib>
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -48,10 +51,144 @@ runtime* runtime_keep_alive_token::get() const {
   return _rt.get();
 }
 
+runtime_lifetime_manager::runtime_lifetime_manager(
+    std::chrono::nanoseconds idle_timeout)
+: _idle_timeout{idle_timeout} {
+  _reaper = std::thread{[this]() { reap_idle_runtime(); }};
+}
+
+runtime_lifetime_manager::~runtime_lifetime_manager() {
+  shutdown();
+}
+
+std::shared_ptr<runtime> runtime_lifetime_manager::get_runtime_pointer() {
+  std::unique_lock<std::mutex> lock{_mutex};
+
+  if(std::shared_ptr<runtime> rt_ptr = _users.lock())
+    return rt_ptr;
+
+  // Never have two runtimes at the same time
+  _state_changed.wait(lock, [this]() { return !_is_being_destroyed; });
+
+  if(!_rt) {
+    _rt = std::make_unique<runtime>();
+    ++_num_launches;
+  } else {
+    HIPSYCL_DEBUG_INFO << "runtime_lifetime_manager: Reusing idle runtime"
+                       << std::endl;
+  }
+
+  std::size_t generation = ++_generation;
+  _is_idle = false;
+  std::shared_ptr<runtime> rt_ptr{
+      _rt.get(), [this, generation](runtime *) { on_released(generation); }};
+  _users = rt_ptr;
+  return rt_ptr;
+}
+
+void runtime_lifetime_manager::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(_is_shut_down)
+      return;
+    _is_shut_down = true;
+  }
+  _state_changed.notify_all();
+  if(_reaper.joinable())
+    _reaper.join();
+
+  std::unique_lock<std::mutex> lock{_mutex};
+  if(_is_idle && _rt)
+    destroy_runtime(lock);
+}
+
+bool runtime_lifetime_manager::is_runtime_alive() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _rt != nullptr;
+}
+
+std::size_t runtime_lifetime_manager::get_num_runtime_launches() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _num_launches;
+}
+
+void runtime_lifetime_manager::on_released(std::size_t generation) {
+  std::unique_lock<std::mutex> lock{_mutex};
+  // Another set of pointers might have been handed out already
+  // if the runtime was requested while this one was expiring.
+  if(generation != _generation)
+    return;
+
+  _is_idle = true;
+  _idle_since = std::chrono::steady_clock::now();
+
+  if(_is_shut_down) {
+    destroy_runtime(lock);
+  } else {
+    lock.unlock();
+    _state_changed.notify_all();
+  }
+}
+
+void runtime_lifetime_manager::destroy_runtime(
+    std::unique_lock<std::mutex> &lock) {
+  // The runtime is destroyed without holding the lock: Its worker threads
+  // might release runtime pointers of expired generations.
+  std::unique_ptr<runtime> rt = std::move(_rt);
+  _is_idle = false;
+  _is_being_destroyed = true;
+  lock.unlock();
+
+  HIPSYCL_DEBUG_INFO << "runtime_lifetime_manager: Shutting down idle runtime"
+                     << std::endl;
+  rt.reset();
+
+  lock.lock();
+  _is_being_destroyed = false;
+  _state_changed.notify_all();
+}
+
+void runtime_lifetime_manager::reap_idle_runtime() {
+  std::unique_lock<std::mutex> lock{_mutex};
+  while(!_is_shut_down) {
+    if(_is_idle && _rt) {
+      auto deadline = _idle_since + _idle_timeout;
+      if(std::chrono::steady_clock::now() >= deadline)
+        destroy_runtime(lock);
+      else
+        _state_changed.wait_until(lock, deadline);
+    } else {
+      _state_changed.wait(lock);
+    }
+  }
+}
+
 std::shared_ptr<runtime> application::get_runtime_pointer() {
   static std::mutex mutex;
   static std::weak_ptr<runtime> rt;
 
+  static double idle_timeout =
+      application::get_settings().get<setting::runtime_idle_timeout>();
+  if(idle_timeout > 0.0) {
+    // Never destroyed, since runtime pointers might outlive static
+    // objects. The runtime is instead shut down at exit.
+    static runtime_lifetime_manager *manager = [&]() {
+      // Make sure that static objects that the runtime relies on during
+      // shutdown are constructed before registering the exit handler,
+      // so that they are destroyed after it has run.
+      hcf_cache::get();
+      kernel_cache::get();
+      jit_compilation_service::get();
+
+      auto *result = new runtime_lifetime_manager{
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::duration<double>{idle_timeout})};
+      std::atexit([]() { manager->shutdown(); });
+      return result;
+    }();
+    return manager->get_runtime_pointer();
+  }
+
   std::lock_guard<std::mutex> lock{mutex};
 
   std::shared_ptr<runtime> rt_ptr = rt.lock();
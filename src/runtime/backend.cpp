@@ -32,79 +32,175 @@
 #include "hipSYCL/runtime/hw_model/hw_model.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/jit_compilation_service.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <thread>
 
 namespace hipsycl {
 namespace rt {
 
 backend_manager::backend_manager()
+: backend_manager{std::vector<std::string>{}}
+{}
+
+backend_manager::backend_manager(
+    const std::vector<std::string> &additional_plugin_search_paths)
 : _hw_model(std::make_unique<hw_model>(this))
 {
 
-  _loader.query_backends();
+  _loader.query_backends(additional_plugin_search_paths);
 
   for (std::size_t backend_index = 0;
        backend_index < _loader.get_num_backends(); ++backend_index) {
+    auto slot = std::make_unique<backend_slot>();
+    slot->loader_index = backend_index;
+    slot->name = _loader.get_backend_name(backend_index);
+    _backends.emplace_back(std::move(slot));
+  }
 
-    HIPSYCL_DEBUG_INFO << "Registering backend: '"
-                       << _loader.get_backend_name(backend_index) << "'..."
+  // Backend creation is deferred until the backend is first used,
+  // so we can only check that the CPU plugin is present here.
+  if(!_loader.has_backend("omp")) {
+    HIPSYCL_DEBUG_ERROR << "No CPU backend has been loaded. Terminating." << std::endl;
+    std::terminate();
+  }
+}
+
+backend_manager::~backend_manager()
+{
+  // Background compilation tasks may still refer to backend objects
+  jit_compilation_service::get().wait();
+  kernel_cache::get().unload();
+}
+
+void backend_manager::initialize_backend(backend_slot &slot) const {
+  std::call_once(slot.init_flag, [&]() {
+    trace_scope trace{"backend", "initialize"};
+
+    HIPSYCL_DEBUG_INFO << "Registering backend: '" << slot.name << "'..."
                        << std::endl;
-    backend *b = _loader.create(backend_index);
+
+    auto start = std::chrono::steady_clock::now();
+    backend *b = _loader.create(slot.loader_index);
+    slot.initialization_time_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+
     if (b) {
-      _backends.emplace_back(std::unique_ptr<backend>(b));
-    } else {
-      HIPSYCL_DEBUG_ERROR << "backend_manager: Backend creation failed" << std::endl;
-    }
-  }
-  
-  this->for_each_backend([](backend *b) {
-    HIPSYCL_DEBUG_INFO << "Discovered devices from backend '" << b->get_name()
-                       << "': " << std::endl;
-    backend_hardware_manager* hw_manager = b->get_hardware_manager();
-    if(hw_manager->get_num_devices() == 0) {
-      HIPSYCL_DEBUG_INFO << "  <no devices>" << std::endl;
-    } else {
-      for(std::size_t i = 0; i < hw_manager->get_num_devices(); ++i){
-        hardware_context* hw = hw_manager->get_device(i);
+      slot.instance.reset(b);
 
-        HIPSYCL_DEBUG_INFO << "  device " << i << ": " << std::endl;
-        HIPSYCL_DEBUG_INFO << "    vendor: " << hw->get_vendor_name() << std::endl;
-        HIPSYCL_DEBUG_INFO << "    name: " << hw->get_device_name() << std::endl;
+      // Backends may be initialized concurrently, so assemble the
+      // device list first to avoid interleaved output.
+      std::stringstream devices;
+      devices << "Discovered devices from backend '" << b->get_name()
+              << "': " << std::endl;
+      backend_hardware_manager *hw_manager = b->get_hardware_manager();
+      if (hw_manager->get_num_devices() == 0) {
+        devices << "  <no devices>" << std::endl;
+      } else {
+        for (std::size_t i = 0; i < hw_manager->get_num_devices(); ++i) {
+          hardware_context *hw = hw_manager->get_device(i);
+
+          devices << "  device " << i << ": " << std::endl;
+          devices << "    vendor: " << hw->get_vendor_name() << std::endl;
+          devices << "    name: " << hw->get_device_name() << std::endl;
+        }
       }
+      HIPSYCL_DEBUG_INFO << devices.str();
+      HIPSYCL_DEBUG_INFO << "backend_manager: Initialized backend '"
+                         << slot.name << "' in "
+                         << slot.initialization_time_ns / 1.e6 << " ms"
+                         << std::endl;
+    } else {
+      HIPSYCL_DEBUG_ERROR << "backend_manager: Backend creation failed"
+                          << std::endl;
     }
+
+    slot.is_initialized.store(true, std::memory_order_release);
   });
+}
 
-  if(std::none_of(_backends.cbegin(), _backends.cend(), 
-                  [](const std::unique_ptr<backend>& b){
-                    return b->get_hardware_platform() == hardware_platform::cpu;
-                    }))
-  {
-    HIPSYCL_DEBUG_ERROR << "No CPU backend has been loaded. Terminating." << std::endl;
-    std::terminate();
+void backend_manager::initialize_all_backends() const {
+  std::vector<backend_slot*> pending;
+  for(const auto& slot : _backends) {
+    if(!slot->is_initialized.load(std::memory_order_acquire))
+      pending.push_back(slot.get());
+  }
+
+  if(pending.empty())
+    return;
+  if(pending.size() == 1) {
+    initialize_backend(*pending.front());
+    return;
   }
+
+  // Backends are independent of each other, so their (potentially
+  // expensive) driver initialization can overlap.
+  std::vector<std::thread> workers;
+  for(std::size_t i = 1; i < pending.size(); ++i) {
+    workers.emplace_back(
+        [this, slot = pending[i]]() { initialize_backend(*slot); });
+  }
+  initialize_backend(*pending.front());
+
+  for(auto& w : workers)
+    w.join();
 }
 
-backend_manager::~backend_manager()
-{
-  kernel_cache::get().unload();
+backend *backend_manager::find_initialized(backend_id id) const {
+  for(const auto& slot : _backends) {
+    if(slot->is_initialized.load(std::memory_order_acquire) &&
+       slot->instance &&
+       slot->instance->get_backend_descriptor().id == id)
+      return slot->instance.get();
+  }
+  return nullptr;
 }
 
 backend *backend_manager::get(backend_id id) const {
-  auto it = std::find_if(_backends.begin(), _backends.end(),
-                         [id](const std::unique_ptr<backend> &b) -> bool {
-                           return b->get_backend_descriptor().id == id;
-                         });
-  
-  if(it == _backends.end()){
-    register_error(
-        __hipsycl_here(),
-        error_info{"backend_manager: Requested backend is not available.",
-                   error_type::runtime_error});
-
-    return nullptr;
+  if(backend* b = find_initialized(id))
+    return b;
+
+  // Try to only initialize the plugins that are known to provide
+  // the requested backend before falling back to initializing everything.
+  for(const auto& slot : _backends) {
+    backend_id plugin_backend;
+    if (get_backend_id_from_plugin_name(slot->name, plugin_backend) &&
+        plugin_backend == id)
+      initialize_backend(*slot);
+  }
+  if(backend* b = find_initialized(id))
+    return b;
+
+  initialize_all_backends();
+  if(backend* b = find_initialized(id))
+    return b;
+
+  register_error(
+      __hipsycl_here(),
+      error_info{"backend_manager: Requested backend is not available.",
+                 error_type::runtime_error});
+
+  return nullptr;
+}
+
+std::vector<backend_startup_info> backend_manager::get_startup_info() const {
+  std::vector<backend_startup_info> result;
+  for(const auto& slot : _backends) {
+    backend_startup_info info{slot->name, false, false, 0};
+    if(slot->is_initialized.load(std::memory_order_acquire)) {
+      info.is_initialized = true;
+      info.creation_failed = (slot->instance == nullptr);
+      info.initialization_time_ns = slot->initialization_time_ns;
+    }
+    result.push_back(info);
   }
-  return it->get();
+  return result;
 }
 
 hw_model &backend_manager::hardware_model()
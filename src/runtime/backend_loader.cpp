@@ -178,13 +178,10 @@ bool is_plugin_active(const std::string& name)
     return true;
 
   hipsycl::rt::backend_id id;
-  if(name == "cuda") {
-    id = hipsycl::rt::backend_id::cuda;
-  } else if(name == "hip") {
-    id = hipsycl::rt::backend_id::hip;
-  } else if(name == "ze") {
-    id = hipsycl::rt::backend_id::level_zero;
-  }
+  // Plugins that we cannot map to a backend id cannot be selected
+  // using the visibility mask.
+  if(!hipsycl::rt::get_backend_id_from_plugin_name(name, id))
+    return false;
   return std::find(backends_active.cbegin(), backends_active.cend(), id) != backends_active.cend();
 }
 
@@ -193,8 +190,27 @@ bool is_plugin_active(const std::string& name)
 namespace hipsycl {
 namespace rt {
 
-void backend_loader::query_backends() {
+bool get_backend_id_from_plugin_name(const std::string &name,
+                                     backend_id &out) {
+  if(name == "omp") {
+    out = backend_id::omp;
+  } else if(name == "cuda") {
+    out = backend_id::cuda;
+  } else if(name == "hip") {
+    out = backend_id::hip;
+  } else if(name == "ze") {
+    out = backend_id::level_zero;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void backend_loader::query_backends(
+    const std::vector<std::string> &additional_search_paths) {
   std::vector<fs::path> backend_lib_paths = get_plugin_search_paths();
+  for(const std::string& p : additional_search_paths)
+    backend_lib_paths.emplace_back(p);
 
 #ifdef __APPLE__
   std::string shared_lib_extension = ".dylib";
@@ -35,8 +35,19 @@ namespace hipsycl {
 namespace rt {
 
 
-cuda_node_event::cuda_node_event(device_id dev, cudaEvent_t evt, cuda_event_pool* pool)
-: _dev{dev}, _evt{evt}, _pool{pool}
+namespace {
+
+void invoke_completion_callback(void* user_data) {
+  auto* callback = static_cast<std::function<void()>*>(user_data);
+  (*callback)();
+  delete callback;
+}
+
+}
+
+cuda_node_event::cuda_node_event(device_id dev, cudaEvent_t evt,
+                                 cuda_event_pool *pool, cudaStream_t stream)
+: _dev{dev}, _evt{evt}, _pool{pool}, _stream{stream}
 {}
 
 cuda_node_event::~cuda_node_event() {
@@ -66,6 +77,26 @@ void cuda_node_event::wait()
   }
 }
 
+bool cuda_node_event::notify_on_completion(std::function<void()> callback)
+{
+  if(!_stream)
+    return false;
+
+  // The stream is in-order, so the host function runs once the
+  // operation that this event was recorded after has completed.
+  // Host functions must not call into the CUDA API.
+  auto* user_data = new std::function<void()>{std::move(callback)};
+  auto err = cudaLaunchHostFunc(_stream, invoke_completion_callback, user_data);
+  if (err != cudaSuccess) {
+    delete user_data;
+    register_error(__hipsycl_here(),
+                   error_info{"cuda_node_event: cudaLaunchHostFunc() failed",
+                              error_code{"CUDA", err}});
+    return false;
+  }
+  return true;
+}
+
 cuda_node_event::backend_event_type cuda_node_event::get_event() const
 {
   return _evt;
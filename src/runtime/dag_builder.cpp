@@ -31,20 +31,58 @@
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/dag_builder.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
+#include "hipSYCL/runtime/performance_counters.hpp"
 #include "hipSYCL/sycl/access.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <mutex>
 
-// TODO: Implement the following optimization:
-// - Reorder requirements such that larger accesses come first. This will cause
-// later requirements to potentially be optimized away entirely.
-
 
 namespace hipsycl {
 namespace rt {
 
 namespace {
 
+// Whether all accesses that conflict with the smaller requirement
+// are guaranteed to also conflict with the larger requirement.
+bool covers_conflicts_of(const buffer_memory_requirement *larger,
+                         const buffer_memory_requirement *smaller) {
+  if(larger->get_data_region() != smaller->get_data_region())
+    return false;
+  // A read access cannot cover conflicts with readers of a write access
+  if(larger->get_access_mode() == sycl::access::mode::read &&
+     smaller->get_access_mode() != sycl::access::mode::read)
+    return false;
+
+  auto larger_offset = larger->get_access_offset3d();
+  auto larger_range = larger->get_access_range3d();
+  auto smaller_offset = smaller->get_access_offset3d();
+  auto smaller_range = smaller->get_access_range3d();
+  for(int i = 0; i < 3; ++i) {
+    if(larger_offset[i] > smaller_offset[i])
+      return false;
+    if (larger_offset[i] + larger_range[i] <
+        smaller_offset[i] + smaller_range[i])
+      return false;
+  }
+  return true;
+}
+
+buffer_memory_requirement* as_buffer_requirement(const dag_node_ptr& node) {
+  operation* op = node->get_operation();
+  if(!op->is_requirement())
+    return nullptr;
+  auto *req = cast<requirement>(op);
+  if(!req->is_memory_requirement())
+    return nullptr;
+  auto *mem_req = cast<memory_requirement>(req);
+  if(!mem_req->is_buffer_requirement())
+    return nullptr;
+  return cast<buffer_memory_requirement>(mem_req);
+}
+
 
 // Add this node to the data users of the memory region of the specified
 // requirement
@@ -127,7 +165,17 @@ class kernel_operation;
 class memcpy_operation;
 class prefetch_operation;
 
-dag_builder::dag_builder(runtime *rt) : _rt{rt} {}
+dag_builder::dag_builder(runtime *rt)
+    : _pending_nodes{nullptr}, _current_dag_size{0}, _rt{rt} {}
+
+dag_builder::~dag_builder() {
+  pending_node *entry = _pending_nodes.exchange(nullptr);
+  while(entry) {
+    pending_node *next = entry->next;
+    delete entry;
+    entry = next;
+  }
+}
 
 dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
                                      const requirements_list& requirements,
@@ -169,8 +217,31 @@ dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
     }
   };
 
+  // Process the requirements of this command group such that larger
+  // accesses come first. Smaller requirements whose conflicts are all
+  // covered by a larger one then only need a single dependency on the
+  // larger requirement instead of edges to all conflicting users.
+  std::vector<dag_node_ptr> own_requirements;
+  std::vector<dag_node_ptr> node_requirements;
+  for(const dag_node_ptr& req : requirements.get()) {
+    if(requirements.is_own_requirement(req))
+      own_requirements.push_back(req);
+    else
+      node_requirements.push_back(req);
+  }
+  std::stable_sort(own_requirements.begin(), own_requirements.end(),
+                   [](const dag_node_ptr &a, const dag_node_ptr &b) {
+                     auto *mem_a = as_buffer_requirement(a);
+                     auto *mem_b = as_buffer_requirement(b);
+                     std::size_t size_a = mem_a ? mem_a->get_required_size() : 0;
+                     std::size_t size_b = mem_b ? mem_b->get_required_size() : 0;
+                     return size_a > size_b;
+                   });
+
+  // The scheduler submits requirements in this order, so a requirement
+  // is always submitted after the larger requirements it may depend on.
   auto operation_node = std::make_shared<dag_node>(
-      hints, requirements.get(), std::move(op), _rt);
+      hints, own_requirements, std::move(op), _rt);
   
   bool is_req = operation_node->get_operation()->is_requirement();
 
@@ -182,11 +253,28 @@ dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
     // with our requirements, but with the node itself
     add_conflicts_as_requirements(operation_node);
   
-  for (auto weak_node : operation_node->get_requirements()) {
-    if(auto node = weak_node.lock())
+  for(std::size_t i = 0; i < own_requirements.size(); ++i) {
+    const dag_node_ptr& node = own_requirements[i];
+    auto *mem_req = as_buffer_requirement(node);
+
+    bool is_covered = false;
+    for(std::size_t j = 0; j < i && mem_req && !is_covered; ++j) {
+      auto *larger = as_buffer_requirement(own_requirements[j]);
+      if(larger && covers_conflicts_of(larger, mem_req)) {
+        node->add_requirement(own_requirements[j]);
+        performance_counters::get().requirement_edge_pruned();
+        is_covered = true;
+      }
+    }
+    if(!is_covered)
       add_conflicts_as_requirements(node);
   }
 
+  // Explicit dependencies are often already implied by data dependencies.
+  // add_requirement() only inserts them if they are not reachable yet.
+  for(const dag_node_ptr& node : node_requirements)
+    operation_node->add_requirement(node);
+
   // if this is an explicit requirement, we need to add *this*
   // operation to the users of the requirement it refers to.
   if (is_req) {
@@ -206,15 +294,65 @@ dag_builder::add_command_group(std::unique_ptr<operation> op,
                                const execution_hints &hints)
 {
   assert(op);
+  trace_scope trace{"dag", "build_node", requirements.get().size()};
+  performance_counters::get().dag_node_built();
+
+  // Dependency analysis only needs to be atomic with respect to other
+  // command groups that access the same data regions. To avoid deadlocks,
+  // the locks of the data regions are always acquired in order of
+  // their addresses.
+  std::vector<buffer_data_region*> regions;
+  auto add_region = [&](operation* req_op) {
+    if(!req_op->is_requirement())
+      return;
+    auto *req = cast<requirement>(req_op);
+    if(!req->is_memory_requirement())
+      return;
+    auto *mem_req = cast<memory_requirement>(req);
+    if(mem_req->is_buffer_requirement())
+      regions.push_back(
+          cast<buffer_memory_requirement>(mem_req)->get_data_region().get());
+  };
+  add_region(op.get());
+  for(const dag_node_ptr& req : requirements.get()) {
+    if(requirements.is_own_requirement(req))
+      add_region(req->get_operation());
+  }
+  std::sort(regions.begin(), regions.end(), std::less<buffer_data_region*>{});
+  regions.erase(std::unique(regions.begin(), regions.end()), regions.end());
 
-  std::lock_guard<std::mutex> lock{_mutex};
+  std::vector<std::unique_lock<std::mutex>> region_locks;
+  region_locks.reserve(regions.size());
+  for(buffer_data_region* region : regions)
+    region_locks.emplace_back(region->get_dependency_lock());
 
   auto node = this->build_node(std::move(op), requirements, hints);
-  _current_dag.add_command_group(node);
+  // This must happen while still holding the region locks: Otherwise,
+  // a dependent command group might end up in the DAG before this one.
+  append_to_current_dag(node);
 
   return node;
 }
 
+void dag_builder::append_to_current_dag(dag_node_ptr node) {
+  pending_node *entry = new pending_node{node, {}, nullptr};
+  for(auto weak_req : node->get_requirements()) {
+    if(auto req = weak_req.lock())
+      if(req->get_operation()->is_requirement())
+        entry->memory_requirements.push_back(req);
+  }
+  // Account for the nodes before they become visible, such that
+  // get_current_dag_size() never misses a node that can be flushed.
+  _current_dag_size.fetch_add(1 + entry->memory_requirements.size(),
+                              std::memory_order_relaxed);
+
+  entry->next = _pending_nodes.load(std::memory_order_relaxed);
+  while (!_pending_nodes.compare_exchange_weak(entry->next, entry,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed))
+    ;
+}
+
 dag_node_ptr dag_builder::add_kernel(std::unique_ptr<operation> op,
                                      const requirements_list &requirements,
                                      const execution_hints &hints)
@@ -265,10 +403,21 @@ dag_node_ptr dag_builder::add_explicit_mem_requirement(
 
 dag dag_builder::finish_and_reset()
 {
-  std::lock_guard<std::mutex> lock{_mutex};
-
-  dag final_dag = _current_dag;
-  _current_dag = dag{};
+  pending_node *entry = _pending_nodes.exchange(nullptr, std::memory_order_acquire);
+
+  // The stack holds the newest node first, restore submission order
+  std::vector<pending_node*> entries;
+  for(; entry; entry = entry->next)
+    entries.push_back(entry);
+
+  dag final_dag;
+  std::size_t num_nodes = 0;
+  for(auto it = entries.rbegin(); it != entries.rend(); ++it) {
+    final_dag.add_command_group((*it)->node);
+    num_nodes += 1 + (*it)->memory_requirements.size();
+    delete *it;
+  }
+  _current_dag_size.fetch_sub(num_nodes, std::memory_order_relaxed);
 
   HIPSYCL_DEBUG_INFO << "dag_builder: DAG contains operations: " << std::endl;
   int operation_index = 0;
@@ -302,8 +451,7 @@ bool dag_builder::is_conflicting_access(
 
 std::size_t dag_builder::get_current_dag_size() const
 {
-  std::lock_guard<std::mutex> lock{_mutex};
-  return _current_dag.num_nodes();
+  return _current_dag_size.load(std::memory_order_relaxed);
 }
 
 }
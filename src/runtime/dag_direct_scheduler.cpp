@@ -38,6 +38,7 @@
 #include "hipSYCL/runtime/generic/multi_event.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
 #include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -102,6 +103,7 @@ result ensure_allocation_exists(runtime *rt,
 
     backend_allocator *allocator =
         rt->backends().get(target_dev.get_backend())->get_allocator(target_dev);
+    trace_scope trace{"memory", "allocate", num_bytes};
     void *ptr = allocator->allocate(min_align, num_bytes);
 
     if(!ptr)
@@ -318,6 +320,8 @@ dag_direct_scheduler::dag_direct_scheduler(runtime* rt)
 : _rt{rt} {}
 
 void dag_direct_scheduler::submit(dag_node_ptr node) {
+  trace_scope trace{"scheduler", "direct_submit"};
+
   if (!node->get_execution_hints().has_hint<hints::bind_to_device>()) {
     register_error(__hipsycl_here(),
                    error_info{"dag_direct_scheduler: Direct scheduler does not "
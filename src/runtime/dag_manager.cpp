@@ -25,8 +25,8 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <chrono>
 #include <memory>
-#include <mutex>
 
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/runtime/application.hpp"
@@ -37,10 +37,21 @@
 #include "hipSYCL/runtime/settings.hpp"
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
+#include "hipSYCL/runtime/performance_counters.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// Under the adaptive flush policy, submissions that are further apart
+// than this are flushed directly: batching cannot gain much, but
+// would add latency.
+constexpr std::chrono::microseconds adaptive_flush_submission_gap{50};
+
+}
+
 
 dag_build_guard::~dag_build_guard()
 {
@@ -51,12 +62,16 @@ dag_manager::dag_manager(runtime *rt)
     : _builder{std::make_unique<dag_builder>(rt)},
       _direct_scheduler{rt}, _unbound_scheduler{rt}, _rt{rt} {
   HIPSYCL_DEBUG_INFO << "dag_manager: DAG manager is alive!" << std::endl;
+  // Under the adaptive flush policy, nodes that were held back
+  // while executors were busy are flushed once they become idle.
+  _submitted_ops.set_idle_callback([this]() { this->flush_if_idle(); });
 }
 
 dag_manager::~dag_manager()
 {
   HIPSYCL_DEBUG_INFO << "dag_manager: Waiting for async worker..." << std::endl;
   
+  _submitted_ops.set_idle_callback({});
   flush_sync();
   wait();
 
@@ -73,90 +88,116 @@ void dag_manager::flush_async()
 {
   HIPSYCL_DEBUG_INFO << "dag_manager: Submitting asynchronous flush..."
                      << std::endl;
-  // This lock ensures that the submission process has atomic semantics.
-  // In particular, it is important that once we have popped the latest
-  // nodes from the DAG builder using finish_and_reset(), we directly submit them
-  // to the worker thread.
-  // Otherwise, the order in which submissions are processed in the worker thread
-  // can be incorrect. This can cause queue::submit();flush_sync() to fail in
-  // actually ensuring submission, or introduce dependencies in nodes during submission
-  //  to other nodes that have not yet been submitted.
-  std::lock_guard<std::mutex> lock{_flush_mutex};
-
-  if(_builder->get_current_dag_size() > 0){
-    dag new_dag = _builder->finish_and_reset();
-
-    if(new_dag.num_nodes() > 0) {
-      _worker([this, new_dag](){
-        HIPSYCL_DEBUG_INFO << "dag_manager [async]: Flushing!" << std::endl;
-        
-        for(dag_node_ptr req : new_dag.get_memory_requirements()){
-          assert_is<memory_requirement>(req->get_operation());
-
-          memory_requirement *mreq =
-              cast<memory_requirement>(req->get_operation());
-
-          if(mreq->is_buffer_requirement()) {
-            
-            HIPSYCL_DEBUG_INFO
-                << "dag_manager [async]: Releasing dead users of data region "
-                << cast<buffer_memory_requirement>(mreq)->get_data_region().get()
-                << std::endl;
-
-            cast<buffer_memory_requirement>(mreq)
-                ->get_data_region()
-                ->get_users()
-                .release_dead_users();
-          }
-          else
-            assert(false && "Non-buffer requirements are unsupported");
-        }
-
-        // Go!!!
-        scheduler_type stype =
-            application::get_settings().get<setting::scheduler_type>();
-        
-        // This is okay because get_command_groups() returns
-        // the nodes in the order they were submitted. This
-        // makes it safe to submit them in this order to the direct scheduler.
-        for(auto node : new_dag.get_command_groups()){
-          HIPSYCL_DEBUG_INFO
-                << "dag_manager [async]: Submitting node to scheduler!"
-                << std::endl;
-          if(stype == scheduler_type::direct) {
-            _direct_scheduler.submit(node);
-          } else if(stype == scheduler_type::unbound) {
-            _unbound_scheduler.submit(node);
-          }
-        }
-        HIPSYCL_DEBUG_INFO << "dag_manager [async]: DAG flush complete."
-                          << std::endl;
-
-        // Register nodes as submitted with the runtime
-        for(auto node : new_dag.get_command_groups())
-          this->register_submitted_ops(node);
-        for(auto node : new_dag.get_memory_requirements())
-          this->register_submitted_ops(node);
-              
-        // We do not need to wait for the requirements explicitly
-        // because they will also have completed by the time
-        // their command groups have finished and can
-        // be purged together with them.
-        //
-        // This is the case, because dag_node::wait() also
-        // marks all its requirements as complete.
-        this->_submitted_ops.async_wait_and_unregister(
-            new_dag.get_command_groups());
-      });
-    }
-  } else {
+  if(_builder->get_current_dag_size() == 0) {
     HIPSYCL_DEBUG_INFO << "dag_manager: Nothing to do" << std::endl;
+    return;
+  }
+  // The worker thread takes the nodes from the DAG builder itself. This
+  // guarantees that flushes are processed in the order in which nodes
+  // were submitted, so that queue::submit();flush_sync() always
+  // ensures submission and nodes never depend on unsubmitted nodes -
+  // without serializing submitting threads here.
+  // If a flush is already scheduled but has not yet taken the nodes,
+  // it will also pick up ours.
+  if(_flush_scheduled.exchange(true, std::memory_order_acq_rel))
+    return;
+
+  schedule_flush();
+}
+
+void dag_manager::schedule_flush()
+{
+  trace_scope trace{"dag", "flush"};
+  ++_num_pending_flushes;
+  _worker([this](){
+    this->process_flush();
+
+    --_num_pending_flushes;
+    // Nodes might have been held back while this flush was in progress
+    this->flush_if_idle();
+  });
+}
+
+void dag_manager::process_flush()
+{
+  // Must happen before taking the nodes, such that concurrent
+  // flush_async() calls either see the flag cleared and schedule
+  // another flush, or their nodes are taken here.
+  _flush_scheduled.exchange(false, std::memory_order_acq_rel);
+  dag new_dag = _builder->finish_and_reset();
+  if(new_dag.num_nodes() == 0)
+    return;
+
+  HIPSYCL_DEBUG_INFO << "dag_manager [async]: Flushing!" << std::endl;
+  trace_scope trace{"dag", "process_flush", new_dag.num_nodes()};
+  performance_counters::get().dag_nodes_flushed(new_dag.num_nodes());
+  
+  for(dag_node_ptr req : new_dag.get_memory_requirements()){
+    assert_is<memory_requirement>(req->get_operation());
+
+    memory_requirement *mreq =
+        cast<memory_requirement>(req->get_operation());
+
+    if(mreq->is_buffer_requirement()) {
+      
+      HIPSYCL_DEBUG_INFO
+          << "dag_manager [async]: Releasing dead users of data region "
+          << cast<buffer_memory_requirement>(mreq)->get_data_region().get()
+          << std::endl;
+
+      cast<buffer_memory_requirement>(mreq)
+          ->get_data_region()
+          ->get_users()
+          .release_dead_users();
+    }
+    else
+      assert(false && "Non-buffer requirements are unsupported");
+  }
+
+  // Go!!!
+  scheduler_type stype =
+      application::get_settings().get<setting::scheduler_type>();
+  
+  // This is okay because get_command_groups() returns
+  // the nodes in the order they were submitted. This
+  // makes it safe to submit them in this order to the direct scheduler.
+  for(auto node : new_dag.get_command_groups()){
+    HIPSYCL_DEBUG_INFO
+          << "dag_manager [async]: Submitting node to scheduler!"
+          << std::endl;
+    if(stype == scheduler_type::direct) {
+      _direct_scheduler.submit(node);
+    } else if(stype == scheduler_type::unbound) {
+      _unbound_scheduler.submit(node);
+    }
   }
+  HIPSYCL_DEBUG_INFO << "dag_manager [async]: DAG flush complete."
+                    << std::endl;
+
+  // Register nodes as submitted with the runtime
+  for(auto node : new_dag.get_command_groups())
+    this->register_submitted_ops(node);
+  for(auto node : new_dag.get_memory_requirements())
+    this->register_submitted_ops(node);
+        
+  // We do not need to wait for the requirements explicitly
+  // because they will also have completed by the time
+  // their command groups have finished and can
+  // be purged together with them.
+  //
+  // This is the case, because dag_node::wait() also
+  // marks all its requirements as complete.
+  this->_submitted_ops.async_wait_and_unregister(
+      new_dag.get_command_groups());
 }
 
 void dag_manager::flush_sync()
 {
-  this->flush_async();
+  // Unlike flush_async(), we cannot rely on an already scheduled flush:
+  // The thread that scheduled it might not have handed it to the worker
+  // yet, and then waiting for the worker would not ensure submission.
+  if(_builder->get_current_dag_size() > 0)
+    schedule_flush();
   
   HIPSYCL_DEBUG_INFO << "dag_manager: waiting for async worker..."
                      << std::endl;
@@ -176,20 +217,61 @@ void dag_manager::register_submitted_ops(dag_node_ptr node) {
   this->_submitted_ops.update_with_submission(node);
 }
 
+bool dag_manager::is_idle() const
+{
+  return _num_pending_flushes.load() == 0 && !_submitted_ops.has_pending_ops();
+}
+
+void dag_manager::flush_if_idle()
+{
+  if (application::get_settings().get<setting::dag_flush_policy>() ==
+          dag_flush_policy::adaptive &&
+      builder()->get_current_dag_size() > 0 && is_idle()) {
+    HIPSYCL_DEBUG_INFO << "dag_manager: Executors are idle, flushing held back "
+                          "nodes"
+                       << std::endl;
+    flush_async();
+  }
+}
+
+bool is_flush_due(dag_flush_policy policy, std::size_t num_cached_nodes,
+                  std::size_t max_cached_nodes, bool executors_idle,
+                  std::chrono::steady_clock::duration submission_gap) {
+  switch (policy) {
+  case dag_flush_policy::eager:
+    return true;
+  case dag_flush_policy::batched:
+    return num_cached_nodes > max_cached_nodes;
+  case dag_flush_policy::adaptive:
+    // Flush right away if executors would otherwise idle, or if
+    // submissions are too sparse to benefit from batching. Otherwise,
+    // hold nodes back until the batch is large enough or executors
+    // become idle.
+    return num_cached_nodes > max_cached_nodes || executors_idle ||
+           submission_gap > adaptive_flush_submission_gap;
+  }
+  return true;
+}
+
 void dag_manager::trigger_flush_opportunity()
 {
   HIPSYCL_DEBUG_INFO << "dag_manager: Checking DAG flush opportunity..."
                      << std::endl;
 
-  if (application::get_settings().get<setting::scheduler_type>() ==
-      scheduler_type::direct) {
-    // Direct scheduler always needs flushing
+  const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+  const auto previous_submission = _last_submission.exchange(now);
+
+  const dag_flush_policy policy =
+      application::get_settings().get<setting::dag_flush_policy>();
+  // Only the adaptive policy depends on whether executors are idle
+  const bool executors_idle =
+      policy == dag_flush_policy::adaptive && is_idle();
+
+  if (is_flush_due(policy, builder()->get_current_dag_size(),
+                   application::get_settings().get<setting::max_cached_nodes>(),
+                   executors_idle,
+                   std::chrono::steady_clock::duration{now - previous_submission}))
     flush_async();
-  } else {
-    if (builder()->get_current_dag_size() >
-        application::get_settings().get<setting::max_cached_nodes>())
-      flush_async();
-  }
 }
 
 std::vector<dag_node_ptr> dag_manager::get_group(std::size_t node_group_id) {
@@ -34,6 +34,7 @@
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/generic/multi_event.hpp"
+#include "hipSYCL/runtime/performance_counters.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -48,7 +49,9 @@ dag_node::dag_node(const execution_hints &hints,
       _is_cancelled{false}, _rt{rt} {
   
   for(const auto& req : requirements)
-    _requirements.push_back(req);
+    // Completed requirements do not provide any synchronization
+    if(!req->is_known_complete())
+      _requirements.push_back(req);
 }
 
 dag_node::~dag_node() {
@@ -172,20 +175,27 @@ void descend_requirement_tree(F&& f, const dag_node* n) {
 
 // Looks recursively in the requirement graph of current for x.
 // Descends no more than current_level levels and does not
-// descend into requirements that are known to be complete.
+// descend into nodes that are known to be complete, so the cost
+// does not grow with the number of completed operations.
+// Requirement nodes only connect an operation to the operations it
+// depends on, so they do not count as a level. Otherwise, every
+// command group would use up two levels of the search depth.
 bool recursive_find(const dag_node_ptr &current, int current_level,
                     const dag_node_ptr &x) {
   if(!current)
     return false;
   if(current == x)
     return true;
-  if(current_level <= 0)
+  if(current_level <= 0 || current->is_known_complete())
     return false;
 
   for(const auto& req : current->get_requirements()) {
     if(auto r = req.lock()) {
       if(!r->is_known_complete()) {
-        if(recursive_find(r, current_level - 1, x))
+        int next_level = r->get_operation()->is_requirement()
+                             ? current_level
+                             : current_level - 1;
+        if(recursive_find(r, next_level, x))
           return true;
       }
     }
@@ -200,6 +210,9 @@ bool recursive_find(const dag_node_ptr &current, int current_level,
 // Add requirement if not already present
 void dag_node::add_requirement(dag_node_ptr requirement)
 {
+  if(requirement->is_known_complete())
+    return;
+
   for (auto req : _requirements) {
     if (req.lock() == requirement)
       return;
@@ -219,16 +232,20 @@ void dag_node::add_requirement(dag_node_ptr requirement)
         // The requirement is already reachable from an existing requirement,
         // inserting is unnecessary since the existing requirement
         // already provides sufficient synchronization.
+        performance_counters::get().requirement_edge_pruned();
         return;
       }
     }
   }
 
-  // Remove requirements that are weaker than the new nequirement
+  // Remove requirements that are weaker than the new nequirement,
+  // or that have completed in the meantime.
   for(std::size_t i = 0; i < _requirements.size(); ++i) {
     if(auto r = _requirements[i].lock()) {
-      if(is_reachable_from(requirement, r, search_depth)) {
+      if(r->is_known_complete() ||
+         is_reachable_from(requirement, r, search_depth)) {
         _requirements[i] = std::weak_ptr<dag_node>{};
+        performance_counters::get().requirement_edge_pruned();
       }
     }
   }
@@ -255,6 +272,13 @@ void dag_node::wait() const
     return;
 
   _event->wait();
+  mark_known_complete();
+}
+
+void dag_node::mark_known_complete() const
+{
+  if(_is_complete)
+    return;
   // All requirements are now also complete
   descend_requirement_tree([](const dag_node* current) -> bool{
     // Descend to all nodes that are not yet marked as complete,
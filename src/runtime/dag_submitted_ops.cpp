@@ -25,43 +25,128 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 
 #include "hipSYCL/runtime/dag_submitted_ops.hpp"
 #include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/data.hpp"
 #include "hipSYCL/runtime/hints.hpp"
+#include "hipSYCL/runtime/operations.hpp"
 
 namespace hipsycl {
 namespace rt {
 
 namespace {
 
-void erase_known_completed_nodes(std::vector<dag_node_ptr> &ops) {
-  ops.erase(std::remove_if(ops.begin(), ops.end(),
-                           [&](dag_node_ptr node) -> bool {
-                             return node->is_known_complete();
-                           }),
-            ops.end());
+// Collapses the parts of the DAG that completed nodes keep alive: Strong
+// references held by their operations are dropped, and completed nodes
+// are removed from the users of the data regions they accessed, so that
+// neither memory usage nor the cost of future dependency analysis grows
+// with the number of completed operations.
+void release_completed_nodes(const std::vector<dag_node_ptr> &nodes) {
+  std::vector<buffer_data_region*> regions;
+  for(const dag_node_ptr& node : nodes) {
+    operation* op = node->get_operation();
+    if(op->is_requirement() &&
+       cast<requirement>(op)->is_memory_requirement()) {
+      memory_requirement *mreq = cast<memory_requirement>(op);
+      if(mreq->is_buffer_requirement()) {
+        buffer_data_region *region =
+            cast<buffer_memory_requirement>(mreq)->get_data_region().get();
+        if(std::find(regions.begin(), regions.end(), region) == regions.end())
+          regions.push_back(region);
+      }
+    }
+  }
+  // The regions are kept alive by the memory requirement nodes
+  for(buffer_data_region* region : regions)
+    region->get_users().release_dead_users();
+
+  for(const dag_node_ptr& node : nodes)
+    node->get_operation()->release_dependencies();
 }
+
 }
 
 void dag_submitted_ops::purge_known_completed() {
-  std::lock_guard lock{_lock};
+  std::vector<dag_node_ptr> completed_ops;
+  bool is_idle = false;
+  {
+    std::lock_guard lock{_lock};
 
-  erase_known_completed_nodes(_ops);
+    auto first_completed = std::stable_partition(
+        _ops.begin(), _ops.end(),
+        [](const dag_node_ptr &node) { return !node->is_known_complete(); });
+    completed_ops.assign(std::make_move_iterator(first_completed),
+                         std::make_move_iterator(_ops.end()));
+    _ops.erase(first_completed, _ops.end());
+    is_idle = _ops.empty() && !completed_ops.empty();
+  }
+  release_completed_nodes(completed_ops);
+
+  if(is_idle) {
+    std::lock_guard<std::mutex> lock{_idle_callback_lock};
+    if(_idle_callback)
+      _idle_callback();
+  }
+}
+
+dag_submitted_ops::~dag_submitted_ops() {
+  // Completion callbacks refer to this object
+  std::unique_lock<std::mutex> lock{_callback_lock};
+  _callbacks_completed.wait(lock,
+                            [this]() { return _num_pending_callbacks == 0; });
 }
 
 void dag_submitted_ops::async_wait_and_unregister(
     const std::vector<dag_node_ptr> &nodes) {
   
-  _updater_thread([nodes, this]{
+  // Nodes whose events can notify us about completion are marked
+  // as complete and purged in the order in which they finish, so that
+  // long-running operations do not delay bookkeeping for other nodes.
+  std::vector<dag_node_ptr> nodes_to_wait;
+  for(const dag_node_ptr& node : nodes) {
+    {
+      std::lock_guard<std::mutex> lock{_callback_lock};
+      ++_num_pending_callbacks;
+    }
+    std::weak_ptr<dag_node> weak_node = node;
+    bool has_callback =
+        node->get_event()->notify_on_completion([this, weak_node]() {
+          // Backend callbacks may run in contexts that must not call into
+          // the backend, which destroying the node could do. The reference
+          // is therefore handed over to the updater thread.
+          if(auto n = weak_node.lock()) {
+            n->mark_known_complete();
+            std::lock_guard<std::mutex> lock{_callback_lock};
+            _callback_released_nodes.push_back(std::move(n));
+          }
+          this->schedule_purge();
+
+          std::lock_guard<std::mutex> lock{_callback_lock};
+          --_num_pending_callbacks;
+          _callbacks_completed.notify_all();
+        });
+    if(!has_callback) {
+      std::lock_guard<std::mutex> lock{_callback_lock};
+      --_num_pending_callbacks;
+      nodes_to_wait.push_back(node);
+    }
+  }
+
+  if(nodes_to_wait.empty())
+    return;
+
+  _updater_thread([nodes_to_wait, this]{
     // Since node->wait() causes all requirements to be marked
     // as completed as well, we can reduce the number of backend wait
     // operations by reversing the iteration order,
     // since the newest operations will tend to be the last
     // in the list.
-    for(int i = nodes.size() - 1; i >= 0; --i) {
-      nodes[i]->wait();
+    for(int i = nodes_to_wait.size() - 1; i >= 0; --i) {
+      nodes_to_wait[i]->wait();
     }
     // Waiting on nodes causes them to be known complete,
     // so we can just purge all known completed nodes
@@ -69,6 +154,21 @@ void dag_submitted_ops::async_wait_and_unregister(
   });
 }
 
+void dag_submitted_ops::schedule_purge() {
+  // Completions that arrive while a purge is already pending
+  // are handled by that purge.
+  if(!_is_purge_scheduled.exchange(true, std::memory_order_acq_rel)) {
+    _updater_thread([this]() {
+      _is_purge_scheduled.store(false, std::memory_order_release);
+      this->purge_known_completed();
+
+      std::vector<dag_node_ptr> released_nodes;
+      std::lock_guard<std::mutex> lock{_callback_lock};
+      released_nodes.swap(_callback_released_nodes);
+    });
+  }
+}
+
 void dag_submitted_ops::update_with_submission(dag_node_ptr single_node) {
   std::lock_guard lock{_lock};
 
@@ -138,6 +238,21 @@ std::vector<dag_node_ptr> dag_submitted_ops::get_group(std::size_t node_group) {
   return ops;
 }
 
+bool dag_submitted_ops::has_pending_ops() const {
+  std::lock_guard lock{_lock};
+  // Newest nodes are at the end and most likely to still be running
+  for(auto it = _ops.rbegin(); it != _ops.rend(); ++it) {
+    if(!(*it)->is_known_complete())
+      return true;
+  }
+  return false;
+}
+
+void dag_submitted_ops::set_idle_callback(std::function<void()> callback) {
+  std::lock_guard<std::mutex> lock{_idle_callback_lock};
+  _idle_callback = std::move(callback);
+}
+
 bool dag_submitted_ops::contains_node(dag_node_ptr node) const {
   std::lock_guard lock{_lock};
 
@@ -33,6 +33,7 @@
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -41,6 +42,8 @@ dag_unbound_scheduler::dag_unbound_scheduler(runtime* rt)
 : _direct_scheduler{rt}, _rt{rt} {}
 
 void dag_unbound_scheduler::submit(dag_node_ptr node) {
+  trace_scope trace{"scheduler", "unbound_submit"};
+
   if(_devices.empty()) {
     // We cannot query this in the constructor, because
     // when schedulers are constructed the runtime is typically
@@ -176,5 +176,21 @@ bool range_store::entire_range_equals(
   return true;
 }
 
+range_store range_store::refine(range<3> factor, range<3> new_size) const
+{
+  range_store result{new_size};
+  std::size_t pos = 0;
+  for(size_t x = 0; x < new_size[0]; ++x){
+    for(size_t y = 0; y < new_size[1]; ++y){
+      size_t old_row_begin =
+          get_index(id<3>{x / factor[0], y / factor[1], 0});
+      for(size_t z = 0; z < new_size[2]; ++z)
+        result._contained_data[pos++] =
+            _contained_data[old_row_begin + z / factor[2]];
+    }
+  }
+  return result;
+}
+
 }
 }
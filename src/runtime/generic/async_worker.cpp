@@ -141,5 +141,91 @@ std::size_t worker_thread::queue_size() const
 }
 
 
+priority_arbiter::priority_arbiter(clock::duration aging_interval)
+: _aging_interval{aging_interval} {}
+
+priority_arbiter::guard priority_arbiter::acquire(int priority) {
+  // Without prioritized queues, all work has the same priority and
+  // there is nothing to arbitrate.
+  if(_num_prioritized_queues.load(std::memory_order_acquire) == 0)
+    return guard{nullptr, priority};
+
+  std::unique_lock<std::mutex> lock{_mutex};
+
+  const clock::time_point enqueue_time = clock::now();
+  const std::uint64_t id = _next_id++;
+  std::deque<waiting_work>& ready_list = _waiting[priority];
+  ready_list.push_back(waiting_work{id, enqueue_time});
+
+  // Effective priorities change over time, so re-evaluate periodically
+  // even if nobody notifies us.
+  while(!can_start(priority, enqueue_time, clock::now()))
+    _condition_wait.wait_for(lock, _aging_interval);
+
+  std::deque<waiting_work>& list = _waiting[priority];
+  for(auto it = list.begin(); it != list.end(); ++it) {
+    if(it->id == id) {
+      list.erase(it);
+      break;
+    }
+  }
+  if(list.empty())
+    _waiting.erase(priority);
+  ++_num_running[priority];
+
+  lock.unlock();
+  // Work that was waiting behind us might be able to start now
+  _condition_wait.notify_all();
+
+  return guard{this, priority};
+}
+
+void priority_arbiter::release(int priority) {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _num_running.find(priority);
+    assert(it != _num_running.end());
+    if(--(it->second) == 0)
+      _num_running.erase(it);
+  }
+  _condition_wait.notify_all();
+}
+
+void priority_arbiter::register_prioritized_queue() {
+  _num_prioritized_queues.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void priority_arbiter::unregister_prioritized_queue() {
+  std::size_t previous =
+      _num_prioritized_queues.fetch_sub(1, std::memory_order_acq_rel);
+  assert(previous > 0);
+  (void)previous;
+}
+
+bool priority_arbiter::can_start(int priority, clock::time_point enqueue_time,
+                                 clock::time_point now) const {
+  const int effective_priority =
+      get_effective_priority(priority, enqueue_time, now);
+
+  // Running work does not age
+  for(const auto& running : _num_running)
+    if(running.first < effective_priority)
+      return false;
+  // The oldest work of each ready list has the highest effective priority
+  for(const auto& ready_list : _waiting) {
+    const waiting_work& oldest = ready_list.second.front();
+    if(get_effective_priority(ready_list.first, oldest.enqueue_time, now) <
+       effective_priority)
+      return false;
+  }
+  return true;
+}
+
+int priority_arbiter::get_effective_priority(int priority,
+                                             clock::time_point enqueue_time,
+                                             clock::time_point now) const {
+  return priority - static_cast<int>((now - enqueue_time) / _aging_interval);
+}
+
 }
 }
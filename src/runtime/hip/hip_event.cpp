@@ -34,8 +34,19 @@ namespace hipsycl {
 namespace rt {
 
 
-hip_node_event::hip_node_event(device_id dev, hipEvent_t evt, hip_event_pool* pool)
-: _dev{dev}, _evt{evt}, _pool{pool}
+namespace {
+
+void invoke_completion_callback(void* user_data) {
+  auto* callback = static_cast<std::function<void()>*>(user_data);
+  (*callback)();
+  delete callback;
+}
+
+}
+
+hip_node_event::hip_node_event(device_id dev, hipEvent_t evt,
+                               hip_event_pool *pool, hipStream_t stream)
+: _dev{dev}, _evt{evt}, _pool{pool}, _stream{stream}
 {}
 
 hip_node_event::~hip_node_event() {
@@ -65,6 +76,26 @@ void hip_node_event::wait()
   }
 }
 
+bool hip_node_event::notify_on_completion(std::function<void()> callback)
+{
+  if(!_stream)
+    return false;
+
+  // The stream is in-order, so the host function runs once the
+  // operation that this event was recorded after has completed.
+  // Host functions must not call into the HIP API.
+  auto* user_data = new std::function<void()>{std::move(callback)};
+  auto err = hipLaunchHostFunc(_stream, invoke_completion_callback, user_data);
+  if (err != hipSuccess) {
+    delete user_data;
+    register_error(__hipsycl_here(),
+                   error_info{"hip_node_event: hipLaunchHostFunc() failed",
+                              error_code{"HIP", err}});
+    return false;
+  }
+  return true;
+}
+
 hipEvent_t hip_node_event::get_event() const
 {
   return _evt;
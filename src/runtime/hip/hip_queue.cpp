@@ -222,8 +222,8 @@ std::shared_ptr<dag_node_event> hip_queue::insert_event() {
     return nullptr;
   }
 
-  return std::make_shared<hip_node_event>(_dev, std::move(evt),
-                                          _backend->get_event_pool(_dev));
+  return std::make_shared<hip_node_event>(
+      _dev, std::move(evt), _backend->get_event_pool(_dev), get_stream());
 }
 
 std::shared_ptr<dag_node_event> hip_queue::create_queue_completion_event() {
@@ -398,6 +398,13 @@ result hip_queue::submit_prefetch(prefetch_operation& op, dag_node_ptr node) {
 
 result hip_queue::submit_memset(memset_operation &op, dag_node_ptr node) {
 
+  if (op.get_pattern_size() != 1) {
+    return make_error(
+        __hipsycl_here(),
+        error_info{"hip_queue: memset with multi-byte patterns is unsupported",
+                   error_type::feature_not_supported});
+  }
+
   hip_instrumentation_guard instrumentation{this, op, node};
   hipError_t err = hipMemsetAsync(op.get_pointer(), op.get_pattern(),
                                   op.get_num_bytes(), get_stream());
@@ -481,6 +488,10 @@ void *hip_queue::get_native_type() const {
   return static_cast<void*>(get_stream());
 }
 
+sscp_code_object_invoker* hip_queue::get_sscp_code_object_invoker() {
+  return &_sscp_code_object_invoker;
+}
+
 result hip_queue::submit_multipass_kernel_from_code_object(
       const kernel_operation &op, hcf_object_id hcf_object,
       const std::string &backend_kernel_name, const rt::range<3> &grid_size,
@@ -583,26 +594,18 @@ result hip_queue::submit_multipass_kernel_from_code_object(
       kernel_args, arg_sizes, num_args);
 }
 
-result hip_queue::submit_sscp_kernel_from_code_object(
-      const kernel_operation &op, hcf_object_id hcf_object,
-      const std::string &kernel_name, const rt::range<3> &num_groups,
-      const rt::range<3> &group_size, unsigned local_mem_size, void **args,
-      std::size_t *arg_sizes, std::size_t num_args,
-      const glue::kernel_configuration &config) {
+result hip_queue::get_sscp_code_object(
+    const sscp_kernel_id &kernel_id, const glue::kernel_configuration &config,
+    const code_object *&obj_out) {
 #ifdef HIPSYCL_WITH_SSCP_COMPILER
-  this->activate_device();
-  
-  std::string global_kernel_name = op.get_global_kernel_name();
-  const kernel_cache::kernel_name_index_t *kidx =
-      kernel_cache::get().get_global_kernel_index(global_kernel_name);
 
-  if(!kidx) {
-    return make_error(
-        __hipsycl_here(),
-        error_info{"hip_queue: Could not obtain kernel index for kernel " +
-                   global_kernel_name});
-  }
+  const hcf_object_id hcf_object = kernel_id.hcf_object;
+  const std::string &kernel_name = kernel_id.kernel_name;
+  const hcf_kernel_info *kernel_info = kernel_id.kernel_info;
 
+  // May be called from threads other than the submitting thread
+  this->activate_device();
+  
   auto configuration_id = config.generate_id();
   int device = _dev.get_id();
 
@@ -611,15 +614,6 @@ result hip_queue::submit_sscp_kernel_from_code_object(
 
   std::string target_arch_name = ctx->get_device_arch();
 
-  const hcf_kernel_info *kernel_info =
-      rt::hcf_cache::get().get_kernel_info(hcf_object, kernel_name);
-  if(!kernel_info) {
-    return make_error(
-        __hipsycl_here(),
-        error_info{"hip_queue: Could not obtain hcf kernel info for kernel " +
-            global_kernel_name});
-  }
-
   auto code_object_selector = [&](const code_object* candidate) -> bool {
     
     if ((candidate->managing_backend() != backend_id::hip) ||
@@ -679,21 +673,45 @@ result hip_queue::submit_sscp_kernel_from_code_object(
   };
 
   const code_object *obj = kernel_cache::get().get_or_construct_code_object(
-      *kidx, kernel_name, backend_id::hip, hcf_object,
-      code_object_selector, code_object_constructor);
+      kernel_id.kernel_index, kernel_name, backend_id::hip, hcf_object,
+      configuration_id, code_object_selector, code_object_constructor);
 
-  
   if(!obj) {
     return make_error(__hipsycl_here(),
                       error_info{"hip_queue: Code object construction failed"});
   }
 
+  obj_out = obj;
+  return make_success();
+#else
+  return make_error(
+      __hipsycl_here(),
+      error_info{
+          "hip_queue: SSCP kernel compilation was requested, but hipSYCL was "
+          "not built with HIP SSCP support."});
+#endif
+}
+
+result hip_queue::submit_sscp_kernel_from_code_object(
+      const kernel_operation &op, const sscp_kernel_id &kernel_id,
+      const rt::range<3> &num_groups, const rt::range<3> &group_size,
+      unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+      std::size_t num_args,
+      const glue::kernel_configuration &config) {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  this->activate_device();
+
+  const code_object *obj = nullptr;
+  result err = get_sscp_code_object(kernel_id, config, obj);
+  if(!err.is_success())
+    return err;
+
   ihipModule_t *module =
       static_cast<const hip_executable_object *>(obj)->get_module();
   assert(module);
 
-  glue::jit::cxx_argument_mapper arg_mapper{*kernel_info, args, arg_sizes,
-                                            num_args};
+  glue::jit::cxx_argument_mapper arg_mapper{*kernel_id.kernel_info, args,
+                                            arg_sizes, num_args};
   if(!arg_mapper.mapping_available()) {
     return make_error(
         __hipsycl_here(),
@@ -702,8 +720,8 @@ result hip_queue::submit_sscp_kernel_from_code_object(
   }
 
   return launch_kernel_from_module(
-      module, kernel_name, num_groups, group_size, local_mem_size, _stream,
-      arg_mapper.get_mapped_args(),
+      module, kernel_id.kernel_name, num_groups, group_size, local_mem_size,
+      _stream, arg_mapper.get_mapped_args(),
       const_cast<std::size_t *>(arg_mapper.get_mapped_arg_sizes()),
       arg_mapper.get_mapped_num_args());
 #else
@@ -741,15 +759,29 @@ result hip_multipass_code_object_invoker::submit_kernel(
 }
 
 result hip_sscp_code_object_invoker::submit_kernel(
-    const kernel_operation &op, hcf_object_id hcf_object,
+    const kernel_operation &op, const sscp_kernel_id &kernel_id,
     const rt::range<3> &num_groups, const rt::range<3> &group_size,
     unsigned local_mem_size, void **args, std::size_t *arg_sizes,
-    std::size_t num_args, const std::string &kernel_name,
-    const glue::kernel_configuration &config) {
+    std::size_t num_args, const glue::kernel_configuration &config) {
 
   return _queue->submit_sscp_kernel_from_code_object(
-      op, hcf_object, kernel_name, num_groups, group_size, local_mem_size, args,
-      arg_sizes, num_args, config);
+      op, kernel_id, num_groups, group_size, local_mem_size, args, arg_sizes,
+      num_args, config);
+}
+
+result hip_sscp_code_object_invoker::prepare_kernel(
+    hcf_object_id hcf_object, const std::string &global_kernel_name,
+    const std::string &kernel_name, unsigned local_mem_size,
+    const glue::kernel_configuration &config) {
+
+  sscp_kernel_id kernel_id;
+  result err = resolve_sscp_kernel(hcf_object, global_kernel_name,
+                                   kernel_name, kernel_id);
+  if(!err.is_success())
+    return err;
+
+  const code_object *obj = nullptr;
+  return _queue->get_sscp_code_object(kernel_id, config, obj);
 }
 
 }
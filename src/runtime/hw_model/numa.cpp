@@ -0,0 +1,163 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/hw_model/numa.hpp"
+#include "hipSYCL/common/config.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include HIPSYCL_CXX_FILESYSTEM_HEADER
+namespace fs = HIPSYCL_CXX_FILESYSTEM_NAMESPACE;
+
+namespace hipsycl {
+namespace rt {
+
+numa_topology::numa_topology(std::size_t num_cpus) {
+  domain d;
+  d.node_id = 0;
+  for(std::size_t i = 0; i < num_cpus; ++i)
+    d.cpus.push_back(static_cast<int>(i));
+  _domains.push_back(d);
+}
+
+numa_topology numa_topology::from_sysfs(const std::string &sysfs_node_dir) {
+  numa_topology result;
+
+  std::error_code ec;
+  if(fs::is_directory(sysfs_node_dir, ec)) {
+    for(const auto& entry : fs::directory_iterator(sysfs_node_dir, ec)) {
+      std::string name = entry.path().filename().string();
+      if(name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+         !std::all_of(name.begin() + 4, name.end(), ::isdigit))
+        continue;
+
+      std::ifstream cpulist_file{(entry.path() / "cpulist").string()};
+      std::string cpulist;
+      if(!cpulist_file.is_open() || !std::getline(cpulist_file, cpulist))
+        continue;
+
+      domain d;
+      d.node_id = std::stoi(name.substr(4));
+      if(!parse_cpu_list(cpulist, d.cpus)) {
+        HIPSYCL_DEBUG_WARNING << "numa_topology: Could not parse cpulist '"
+                              << cpulist << "' of NUMA node " << d.node_id
+                              << ", ignoring topology information"
+                              << std::endl;
+        result._domains.clear();
+        break;
+      }
+      // Memory-only nodes (e.g. HBM or CXL expanders) do not have CPUs
+      // that could run kernels
+      if(!d.cpus.empty())
+        result._domains.push_back(d);
+    }
+  }
+
+  if(result._domains.empty())
+    return numa_topology{std::max(1u, std::thread::hardware_concurrency())};
+
+  std::sort(result._domains.begin(), result._domains.end(),
+            [](const domain &a, const domain &b) {
+              return a.node_id < b.node_id;
+            });
+  return result;
+}
+
+std::size_t numa_topology::get_num_cpus() const {
+  std::size_t n = 0;
+  for(const auto& d : _domains)
+    n += d.cpus.size();
+  return n;
+}
+
+bool numa_topology::bind_current_thread(std::size_t domain) const {
+#ifdef __linux__
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for(int cpu : _domains[domain].cpus) {
+    if(cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &cpus);
+  }
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+  return false;
+#endif
+}
+
+bool numa_topology::parse_cpu_list(const std::string &cpu_list,
+                                   std::vector<int> &out) {
+  std::vector<int> result;
+  std::size_t pos = 0;
+
+  auto parse_int = [&](int& value) -> bool {
+    std::size_t begin = pos;
+    while(pos < cpu_list.size() && ::isdigit(cpu_list[pos]))
+      ++pos;
+    if(pos == begin)
+      return false;
+    value = std::stoi(cpu_list.substr(begin, pos - begin));
+    return true;
+  };
+
+  while(pos < cpu_list.size()) {
+    if(::isspace(cpu_list[pos])) {
+      ++pos;
+      continue;
+    }
+    int first = 0;
+    if(!parse_int(first))
+      return false;
+    int last = first;
+    if(pos < cpu_list.size() && cpu_list[pos] == '-') {
+      ++pos;
+      if(!parse_int(last) || last < first)
+        return false;
+    }
+    for(int i = first; i <= last; ++i)
+      result.push_back(i);
+
+    if(pos < cpu_list.size()) {
+      if(cpu_list[pos] == ',')
+        ++pos;
+      else if(!::isspace(cpu_list[pos]))
+        return false;
+    }
+  }
+
+  out = result;
+  return true;
+}
+
+}
+}
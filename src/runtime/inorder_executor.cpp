@@ -30,6 +30,7 @@
 #include "hipSYCL/runtime/inorder_executor.hpp"
 #include "hipSYCL/runtime/inorder_queue.hpp"
 #include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/performance_counters.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
 
 namespace hipsycl {
@@ -48,12 +49,16 @@ public:
 
   virtual result dispatch_kernel(kernel_operation *op,
                                  dag_node_ptr node) final override {
-
+    if(auto *counters = op->get_performance_counters())
+      counters->kernel_launched();
     return _queue->submit_kernel(*op, node);
   }
 
   virtual result dispatch_memcpy(memcpy_operation *op,
                                  dag_node_ptr node) final override {
+    performance_counters::get().memcpy_submitted(
+        op->source().get_device(), op->dest().get_device(),
+        op->get_num_transferred_bytes());
     return _queue->submit_memcpy(*op, node);
   }
 
@@ -0,0 +1,211 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/jit_compilation_service.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+
+namespace hipsycl {
+namespace rt {
+
+std::size_t jit_warm_up_handle::get_num_tasks() const {
+  return _state ? _state->num_tasks : 0;
+}
+
+std::size_t jit_warm_up_handle::get_num_completed() const {
+  return _state ? _state->num_completed.load(std::memory_order_acquire) : 0;
+}
+
+std::size_t jit_warm_up_handle::get_num_failed() const {
+  return _state ? _state->num_failed.load(std::memory_order_acquire) : 0;
+}
+
+bool jit_warm_up_handle::is_complete() const {
+  return get_num_completed() == get_num_tasks();
+}
+
+void jit_warm_up_handle::wait() const {
+  if(!_state)
+    return;
+  std::unique_lock<std::mutex> lock{_state->mutex};
+  _state->completion_cv.wait(lock, [this]() { return is_complete(); });
+}
+
+std::vector<result> jit_warm_up_handle::get_errors() const {
+  if(!_state)
+    return {};
+  std::lock_guard<std::mutex> lock{_state->mutex};
+  return _state->errors;
+}
+
+jit_compilation_service::jit_compilation_service(std::size_t num_threads)
+: _num_threads{num_threads} {
+  if(_num_threads == 0)
+    _num_threads =
+        std::max(1u, std::thread::hardware_concurrency() / 2);
+}
+
+jit_compilation_service::~jit_compilation_service() {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _shutdown = true;
+  }
+  _task_available.notify_all();
+  for(auto& worker : _workers)
+    worker.join();
+}
+
+jit_compilation_service& jit_compilation_service::get() {
+  static jit_compilation_service service{
+      application::get_settings().get<setting::sscp_jit_threads>()};
+  return service;
+}
+
+std::shared_future<result> jit_compilation_service::submit(task t) {
+  std::packaged_task<result()> pt{std::move(t)};
+  std::shared_future<result> f = pt.get_future().share();
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    // During shutdown(), the exiting workers process the task or
+    // new workers are started afterwards.
+    if(_workers.empty() && !_shutdown)
+      start_workers();
+    _tasks.push(std::move(pt));
+    ++_num_pending;
+  }
+  _task_available.notify_one();
+  return f;
+}
+
+jit_warm_up_handle
+jit_compilation_service::warm_up(std::vector<task> tasks,
+                                 progress_callback callback) {
+  auto s = std::make_shared<jit_warm_up_handle::state>();
+  s->num_tasks = tasks.size();
+  s->progress_callback = std::move(callback);
+
+  HIPSYCL_DEBUG_INFO << "jit_compilation_service: Warming up "
+                     << tasks.size() << " kernels in the background"
+                     << std::endl;
+
+  for(auto& t : tasks) {
+    submit([s, t = std::move(t)]() -> result {
+      result res = t();
+      if(!res.is_success()) {
+        std::lock_guard<std::mutex> lock{s->mutex};
+        s->errors.push_back(res);
+        s->num_failed.fetch_add(1, std::memory_order_acq_rel);
+      }
+
+      std::size_t num_completed =
+          s->num_completed.fetch_add(1, std::memory_order_acq_rel) + 1;
+      if(s->progress_callback)
+        s->progress_callback(num_completed, s->num_tasks);
+
+      if(num_completed == s->num_tasks) {
+        // Lock to avoid missed wakeups in jit_warm_up_handle::wait()
+        std::lock_guard<std::mutex> lock{s->mutex};
+        s->completion_cv.notify_all();
+      }
+      return res;
+    });
+  }
+  return jit_warm_up_handle{s};
+}
+
+void jit_compilation_service::wait() {
+  std::unique_lock<std::mutex> lock{_mutex};
+  _all_tasks_done.wait(lock, [this]() { return _num_pending == 0; });
+}
+
+void jit_compilation_service::shutdown() {
+  std::lock_guard<std::mutex> shutdown_lock{_shutdown_mutex};
+
+  std::vector<std::thread> workers;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _shutdown = true;
+    workers.swap(_workers);
+  }
+  _task_available.notify_all();
+  for(auto& worker : workers)
+    worker.join();
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  _shutdown = false;
+  // Tasks that were submitted after the workers had exited
+  if(!_tasks.empty())
+    start_workers();
+}
+
+std::size_t jit_compilation_service::get_num_threads() const {
+  return _num_threads;
+}
+
+std::size_t jit_compilation_service::get_num_pending_tasks() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _num_pending;
+}
+
+void jit_compilation_service::start_workers() {
+  HIPSYCL_DEBUG_INFO << "jit_compilation_service: Starting " << _num_threads
+                     << " worker threads" << std::endl;
+  for(std::size_t i = 0; i < _num_threads; ++i)
+    _workers.emplace_back([this]() { work(); });
+}
+
+void jit_compilation_service::work() {
+  for(;;) {
+    std::packaged_task<result()> t;
+    {
+      std::unique_lock<std::mutex> lock{_mutex};
+      _task_available.wait(lock,
+                           [this]() { return _shutdown || !_tasks.empty(); });
+      // Finish outstanding tasks before shutting down, since submitters
+      // may be waiting on their results.
+      if(_tasks.empty())
+        return;
+      t = std::move(_tasks.front());
+      _tasks.pop();
+    }
+
+    t();
+
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      --_num_pending;
+      if(_num_pending == 0)
+        _all_tasks_done.notify_all();
+    }
+  }
+}
+
+}
+}
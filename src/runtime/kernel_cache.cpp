@@ -29,16 +29,24 @@
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/common/hcf_container.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <fstream>
 #include <memory>
 #include <mutex>
+#include <unordered_set>
 
 namespace hipsycl {
 namespace rt {
 
 namespace {
 
+std::uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
 template<class F>
 void for_each_device_image(const common::hcf_container& hcf, F&& handler) {
   if(hcf.root_node()->has_subnode("images")) {
@@ -154,7 +162,9 @@ const std::string& hcf_image_info::get_variant() const {
 }
 
 hcf_image_info::hcf_image_info(const common::hcf_container *hcf,
-                               const common::hcf_container::node *image_node) {
+                               const common::hcf_container::node *image_node,
+                               std::vector<std::string> contained_kernels)
+    : _contained_kernels{std::move(contained_kernels)} {
   assert(hcf);
   assert(image_node);
   if(!image_node->has_key("format"))
@@ -165,22 +175,6 @@ hcf_image_info::hcf_image_info(const common::hcf_container *hcf,
   _format = *image_node->get_value("format");
   _variant = *image_node->get_value("variant");
 
-  // Currently we need to obtain contained kernels list
-  // by walking through all kernels, and matching against their image-providers.
-  auto* kernels = hcf->root_node()->get_subnode("kernels");
-  if(!kernels)
-    return;
-  
-  std::string image_name = image_node->node_id;
-  for(const auto& kernel : kernels->get_subnodes()) {
-    std::vector<std::string> image_providers =
-        kernels->get_subnode(kernel)->get_as_list("image-providers");
-    for(const std::string& provider : image_providers) {
-      if(provider == image_name)
-        _contained_kernels.push_back(kernel);
-    }
-  }
-
   _parsing_successful = true;
 
 }
@@ -204,8 +198,77 @@ hcf_cache& hcf_cache::get() {
 }
 
 hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
+  return register_hcf_object(common::hcf_container{obj});
+}
+
+hcf_object_id hcf_cache::register_hcf_object(common::hcf_container &&obj) {
+  auto start = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  hcf_object_id id = register_hcf_object_impl(std::move(obj));
+
+  ++_statistics.num_registered_objects;
+  _statistics.registration_time_ns += elapsed_ns(start);
+  return id;
+}
+
+hcf_object_id hcf_cache::register_hcf_object(hcf_object_id id, const char *data,
+                                             std::size_t size) {
+  auto start = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  if(_pending_objects.count(id) > 0 || _hcf_objects.count(id) > 0) {
+    HIPSYCL_DEBUG_ERROR
+        << "hcf_cache: Detected hcf object id collision " << id
+        << ", this should not happen. Some kernels might be unavailable."
+        << std::endl;
+  } else {
+    _pending_objects[id] = pending_hcf_object{data, size};
+    ++_statistics.num_registered_objects;
+  }
+
+  // Dumping requires the parsed object
+  if(!application::get_settings().get<setting::hcf_dump_directory>().empty())
+    load_pending_object(id);
+
+  _statistics.registration_time_ns += elapsed_ns(start);
+  return id;
+}
+
+void hcf_cache::load_pending_object(hcf_object_id id) {
+  auto it = _pending_objects.find(id);
+  if(it == _pending_objects.end())
+    return;
+
+  auto start = std::chrono::steady_clock::now();
+  HIPSYCL_DEBUG_INFO << "hcf_cache: Loading deferred HCF object " << id
+                     << std::endl;
+  pending_hcf_object pending = it->second;
+  _pending_objects.erase(it);
+  hcf_object_id loaded_id = register_hcf_object_impl(
+      common::hcf_container{pending.data, pending.size});
+  if(loaded_id != id) {
+    HIPSYCL_DEBUG_ERROR << "hcf_cache: HCF object registered as " << id
+                        << " has object id " << loaded_id
+                        << ", kernels might be unavailable." << std::endl;
+  }
+
+  _statistics.deferred_loading_time_ns += elapsed_ns(start);
+}
 
+void hcf_cache::load_all_pending_objects() {
+  while(!_pending_objects.empty())
+    load_pending_object(_pending_objects.begin()->first);
+}
+
+hcf_cache::registration_statistics
+hcf_cache::get_registration_statistics() const {
   std::lock_guard<std::mutex> lock{_mutex};
+  return _statistics;
+}
+
+hcf_object_id hcf_cache::register_hcf_object_impl(common::hcf_container &&obj) {
 
   if (!obj.root_node()->has_key("object-id")) {
     HIPSYCL_DEBUG_ERROR
@@ -217,13 +280,19 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
   hcf_object_id id = std::stoull(*data);
   HIPSYCL_DEBUG_INFO << "hcf_cache: Registering HCF object " << id << "..." << std::endl;
 
+  const common::hcf_container* registered_obj = &obj;
+
   if (_hcf_objects.count(id) > 0) {
     HIPSYCL_DEBUG_ERROR
         << "hcf_cache: Detected hcf object id collision " << id
         << ", this should not happen. Some kernels might be unavailable."
         << std::endl;
   } else {
-    common::hcf_container* stored_obj = new common::hcf_container{obj};
+    // Binary attachments are typically referenced in place, so this
+    // only moves the node tree.
+    common::hcf_container* stored_obj =
+        new common::hcf_container{std::move(obj)};
+    registered_obj = stored_obj;
     _hcf_objects[id] = std::unique_ptr<common::hcf_container>{stored_obj};
     // Check if the HCF exports some symbols
     for_each_exported_symbol_list(
@@ -244,9 +313,18 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
                                << " @" << image_node << std::endl;
           }
         });
+    ++_statistics.num_loaded_objects;
+    // Images do not store which kernels they contain, so collect this
+    // information in a single pass over the kernels.
+    std::unordered_map<std::string, std::vector<std::string>> kernels_by_image;
     // See if stored object has kernel nodes that we can parse
     if(auto* kernels_node = stored_obj->root_node()->get_subnode("kernels")) {
       for(const auto& kernel_name : kernels_node->get_subnodes()) {
+        for(const auto &provider :
+            kernels_node->get_subnode(kernel_name)->get_as_list(
+                "image-providers"))
+          kernels_by_image[provider].push_back(kernel_name);
+
         std::unique_ptr<hcf_kernel_info> kernel_info{
             new hcf_kernel_info{id, kernels_node->get_subnode(kernel_name)}};
         if(kernel_info->is_valid()) {
@@ -272,7 +350,8 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
     if(auto* images_node = stored_obj->root_node()->get_subnode("images")) {
       for(const auto& image_name : images_node->get_subnodes()) {
         std::unique_ptr<hcf_image_info> image_info{new hcf_image_info{
-            stored_obj, images_node->get_subnode(image_name)}};
+            stored_obj, images_node->get_subnode(image_name),
+            kernels_by_image[image_name]}};
         
         if(image_info->is_valid()) {
           HIPSYCL_DEBUG_INFO << "hcf_cache: Registering image info for image "
@@ -301,7 +380,7 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
                           << " for writing." << std::endl;
 
     } else {
-      std::string hcf_data = obj.serialize();
+      std::string hcf_data = registered_obj->serialize_binary();
       out_file.write(hcf_data.c_str(), hcf_data.size());
     }
   }
@@ -312,6 +391,9 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
 void hcf_cache::unregister_hcf_object(hcf_object_id id) {
   std::lock_guard<std::mutex> lock{_mutex};
 
+  if(_pending_objects.erase(id) > 0)
+    return;
+
   auto it = _hcf_objects.find(id);
   if(it != _hcf_objects.end()) {
     // First remove the HCF object as a symbol provider for runtime linking and
@@ -343,8 +425,9 @@ void hcf_cache::unregister_hcf_object(hcf_object_id id) {
   }
 }
 
-const common::hcf_container* hcf_cache::get_hcf(hcf_object_id obj) const {
+const common::hcf_container* hcf_cache::get_hcf(hcf_object_id obj) {
   std::lock_guard<std::mutex> lock{_mutex};
+  load_pending_object(obj);
 
   auto it = _hcf_objects.find(obj);
   if(it == _hcf_objects.end())
@@ -352,10 +435,43 @@ const common::hcf_container* hcf_cache::get_hcf(hcf_object_id obj) const {
   return it->second.get();
 }
 
+std::vector<hcf_object_id>
+hcf_cache::get_symbol_providers(const std::vector<std::string> &names,
+                                const std::string &image_name) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  load_all_pending_objects();
+
+  std::vector<hcf_object_id> result;
+  std::unordered_set<std::string> visited_symbols{names.begin(), names.end()};
+  std::vector<std::string> pending_symbols = names;
+  while(!pending_symbols.empty()) {
+    std::string symbol = std::move(pending_symbols.back());
+    pending_symbols.pop_back();
+
+    auto it = _exported_symbol_providers.find(symbol);
+    if(it == _exported_symbol_providers.end())
+      continue;
+    for(const auto& img : it->second) {
+      if(img.image_node->node_id != image_name ||
+         std::find(result.begin(), result.end(), img.hcf_id) != result.end())
+        continue;
+      result.push_back(img.hcf_id);
+      for(const auto& imported :
+          img.image_node->get_as_list("imported-symbols")) {
+        if(visited_symbols.insert(imported).second)
+          pending_symbols.push_back(imported);
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
 const hcf_kernel_info *
 hcf_cache::get_kernel_info(hcf_object_id obj,
-                           const std::string &kernel_name) const {
+                           const std::string &kernel_name) {
   std::lock_guard<std::mutex> lock{_mutex};
+  load_pending_object(obj);
   auto it = _hcf_kernel_info.find(std::make_pair(obj, kernel_name));
   if(it == _hcf_kernel_info.end())
     return nullptr;
@@ -364,8 +480,9 @@ hcf_cache::get_kernel_info(hcf_object_id obj,
 
 const hcf_image_info *
 hcf_cache::get_image_info(hcf_object_id obj,
-                          const std::string &image_name) const {
+                          const std::string &image_name) {
   std::lock_guard<std::mutex> lock{_mutex};
+  load_pending_object(obj);
   auto it = _hcf_image_info.find(std::make_pair(obj, image_name));
   if(it == _hcf_image_info.end())
     return nullptr;
@@ -381,9 +498,32 @@ kernel_cache::get_global_kernel_index(const std::string &kernel_name) const {
 }
 
 
+kernel_cache::kernel_statistics
+kernel_cache::get_statistics(kernel_name_index_t kernel_index) const {
+  kernel_statistics result;
+  if(kernel_index < _kernel_statistics.size()) {
+    const auto& counters = _kernel_statistics[kernel_index];
+    result.hits = counters.hits.load(std::memory_order_relaxed);
+    result.misses = counters.misses.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
 void kernel_cache::unload() {
   std::lock_guard<std::mutex> lock{_mutex};
 
+  for(kernel_name_index_t i = 0; i < _kernel_statistics.size(); ++i) {
+    kernel_statistics stats = get_statistics(i);
+    if(stats.hits > 0 || stats.misses > 0) {
+      HIPSYCL_DEBUG_INFO << "kernel_cache: " << _kernel_names[i] << ": "
+                         << stats.hits << " hits, " << stats.misses
+                         << " misses" << std::endl;
+    }
+  }
+
+  // Lock-free readers might still be probing the lookup tables, so they
+  // are only released together with the cache itself.
+  _lookup_table.store(nullptr, std::memory_order_release);
   _kernel_code_objects.clear();
   _code_objects.clear();
 }
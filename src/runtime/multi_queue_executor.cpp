@@ -34,6 +34,7 @@
 #include "hipSYCL/runtime/generic/multi_event.hpp"
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 
 #include <algorithm>
 #include <limits>
@@ -230,6 +231,7 @@ void multi_queue_executor::submit_directly(
   }
   _device_data[node->get_assigned_device().get_id()]
       .submission_statistics.insert(op_target_lane);
+  tracer::get().record_instant("executor", "select_lane", op_target_lane);
   
   inorder_executor *executor = _device_data[node->get_assigned_device().get_id()]
                          .executors[op_target_lane]
@@ -31,17 +31,50 @@
 #include "hipSYCL/runtime/omp/omp_allocator.hpp"
 #include "hipSYCL/runtime/util.hpp"
 
+#include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
+
+#include <omp.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace hipsycl {
 namespace rt {
 
-omp_allocator::omp_allocator(const device_id &my_device)
-    : _my_device{my_device} {}
+namespace {
+
+std::size_t get_page_size() {
+#ifndef _WIN32
+  long page_size = sysconf(_SC_PAGESIZE);
+  if(page_size > 0)
+    return static_cast<std::size_t>(page_size);
+#endif
+  return 4096;
+}
+
+}
+
+omp_allocator::omp_allocator(const device_id &my_device,
+                             const numa_topology *numa_topology)
+    : _my_device{my_device}, _page_size{get_page_size()} {
+  if(numa_topology) {
+    _first_touch_worker = std::make_unique<worker_thread>();
+    (*_first_touch_worker)([topology = *numa_topology]() {
+      bind_omp_team_to_numa_domains(topology);
+    });
+  }
+}
 
 void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+  void *mem = nullptr;
 #ifndef _WIN32
   // posix requires alignment to be a multiple of sizeof(void*)
-  if (min_alignment < sizeof(void*))
-    return malloc(size_bytes);
+  if (min_alignment < sizeof(void*)) {
+    mem = malloc(size_bytes);
+    first_touch(mem, size_bytes);
+    return mem;
+  }
 #else
   min_alignment = std::max(min_alignment, 1ULL);
 #endif
@@ -52,13 +85,40 @@ void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
   // ToDo: Mac OS CI has a problem with std::aligned_alloc
   // but it's unclear if it's a Mac, or libc++, or toolchain issue
 #ifdef __APPLE__
-  return aligned_alloc(min_alignment, size_bytes);
+  mem = aligned_alloc(min_alignment, size_bytes);
 #elif !defined(_WIN32)
-  return std::aligned_alloc(min_alignment, size_bytes);
+  mem = std::aligned_alloc(min_alignment, size_bytes);
 #else
   min_alignment = power_of_2_ceil(min_alignment);
-  return _aligned_malloc(size_bytes, min_alignment);
+  mem = _aligned_malloc(size_bytes, min_alignment);
 #endif
+  first_touch(mem, size_bytes);
+  return mem;
+}
+
+void omp_allocator::first_touch(void *mem, std::size_t size_bytes) const {
+  if(!_first_touch_worker || !mem)
+    return;
+
+  // Allocation is typically triggered lazily from the scheduler thread,
+  // so without this all pages would end up in the NUMA domain of that thread.
+  // Touch pages with a static schedule, like kernels use
+  // (see omp_dispatch::iterate_range_omp_for). The worker's team is bound
+  // like those of the omp_queue workers, so thread t touches the pages
+  // that thread t of a kernel will mostly access, in the same domain.
+  const std::size_t page_size = _page_size;
+  const std::size_t num_pages = size_bytes / page_size;
+  if(num_pages < static_cast<std::size_t>(omp_get_max_threads()))
+    return;
+
+  char* base = static_cast<char*>(mem);
+  (*_first_touch_worker)([=]() {
+#pragma omp parallel for schedule(static)
+    for(std::size_t page = 0; page < num_pages; ++page) {
+      base[page * page_size] = 0;
+    }
+  });
+  _first_touch_worker->wait();
 }
 
 void *omp_allocator::allocate_optimized_host(size_t min_alignment,
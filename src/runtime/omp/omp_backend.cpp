@@ -27,6 +27,7 @@
 
 #include "hipSYCL/runtime/backend_loader.hpp"
 #include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/inorder_executor.hpp"
 #include "hipSYCL/runtime/omp/omp_backend.hpp"
 #include "hipSYCL/runtime/omp/omp_queue.hpp"
 #include "hipSYCL/runtime/application.hpp"
@@ -55,20 +56,36 @@ namespace rt {
 
 namespace {
 
-std::unique_ptr<inorder_queue> make_omp_queue(device_id dev) {
-  return std::make_unique<omp_queue>(dev.get_backend());
+std::unique_ptr<inorder_queue>
+make_omp_queue(device_id dev, priority_arbiter *arbiter, int priority,
+               const numa_topology *numa_topology) {
+  return std::make_unique<omp_queue>(dev.get_backend(), arbiter, priority,
+                                     numa_topology);
+}
+
+std::optional<numa_topology> make_numa_topology() {
+  if(!application::get_settings().get<setting::omp_numa_first_touch>())
+    return {};
+  return numa_topology::from_sysfs();
 }
 
 }
 
 omp_backend::omp_backend()
-    : _allocator{device_id{
-          backend_descriptor{get_hardware_platform(), get_api_platform()}, 0}},
+    : _numa_topology{make_numa_topology()},
+      _allocator{device_id{backend_descriptor{get_hardware_platform(),
+                                              get_api_platform()},
+                           0},
+                 get_numa_topology()},
       _hw{},
-      _executor(*this, [](device_id dev) -> std::unique_ptr<inorder_queue> {
-        return make_omp_queue(dev);
+      _executor(*this, [this](device_id dev) -> std::unique_ptr<inorder_queue> {
+        return make_omp_queue(dev, &_priority_arbiter, 0, get_numa_topology());
       }) {}
 
+const numa_topology *omp_backend::get_numa_topology() const {
+  return _numa_topology ? &(*_numa_topology) : nullptr;
+}
+
 api_platform omp_backend::get_api_platform() const {
   return api_platform::omp;
 }
@@ -112,7 +129,13 @@ std::string omp_backend::get_name() const {
 
 std::unique_ptr<backend_executor>
 omp_backend::create_inorder_executor(device_id dev, int priority){
-  return nullptr;
+  // Queues with default priority can share the lanes of the
+  // multi-queue executor.
+  if(priority == 0)
+    return nullptr;
+
+  return std::make_unique<inorder_executor>(
+      make_omp_queue(dev, &_priority_arbiter, priority, get_numa_topology()));
 }
 
 }
@@ -0,0 +1,134 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/omp/omp_code_object.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/HostJIT.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+omp_sscp_executable_object::omp_sscp_executable_object(
+    const std::string &object_file, hcf_object_id hcf_source,
+    const std::vector<std::string> &kernel_names,
+    const glue::kernel_configuration &config)
+    : _hcf{hcf_source}, _kernel_names{kernel_names},
+      _id{config.generate_id()} {
+  _build_result = build(object_file);
+}
+
+omp_sscp_executable_object::~omp_sscp_executable_object() {}
+
+result omp_sscp_executable_object::get_build_result() const {
+  return _build_result;
+}
+
+code_object_state omp_sscp_executable_object::state() const {
+  return _module ? code_object_state::executable : code_object_state::invalid;
+}
+
+code_format omp_sscp_executable_object::format() const {
+  return code_format::native_isa;
+}
+
+backend_id omp_sscp_executable_object::managing_backend() const {
+  return backend_id::omp;
+}
+
+hcf_object_id omp_sscp_executable_object::hcf_source() const {
+  return _hcf;
+}
+
+std::string omp_sscp_executable_object::target_arch() const {
+  return "host";
+}
+
+compilation_flow omp_sscp_executable_object::source_compilation_flow() const {
+  return compilation_flow::sscp;
+}
+
+glue::kernel_configuration::id_type
+omp_sscp_executable_object::configuration_id() const {
+  return _id;
+}
+
+std::vector<std::string>
+omp_sscp_executable_object::supported_backend_kernel_names() const {
+  return _kernel_names;
+}
+
+bool omp_sscp_executable_object::contains(
+    const std::string &backend_kernel_name) const {
+  return _kernels.find(backend_kernel_name) != _kernels.end();
+}
+
+const omp_sscp_executable_object::kernel_entry *
+omp_sscp_executable_object::get_kernel(const std::string &kernel_name) const {
+  auto it = _kernels.find(kernel_name);
+  if(it == _kernels.end())
+    return nullptr;
+  return &(it->second);
+}
+
+result omp_sscp_executable_object::build(const std::string &object_file) {
+  std::string err;
+  _module = compiler::host::HostJITModule::load(object_file, err);
+  if(!_module) {
+    return make_error(__hipsycl_here(),
+                      error_info{"omp_sscp_executable_object: " + err});
+  }
+
+  // Resolve all symbols now, so that kernel launches do not need to
+  // go through the JIT.
+  for(const auto& name : _kernel_names) {
+    void *entry =
+        _module->getSymbol(compiler::host::getEntrypointName(name), err);
+    void *local_mem_size =
+        _module->getSymbol(compiler::host::getLocalMemSizeSymbolName(name), err);
+
+    if(!entry || !local_mem_size) {
+      _module.reset();
+      return make_error(__hipsycl_here(),
+                        error_info{"omp_sscp_executable_object: " + err});
+    }
+
+    kernel_entry k;
+    k.entrypoint = reinterpret_cast<compiler::host::KernelEntrypoint>(entry);
+    k.static_local_mem_size = *static_cast<const std::size_t *>(local_mem_size);
+    _kernels[name] = k;
+
+    HIPSYCL_DEBUG_INFO << "omp_sscp_executable_object: Loaded kernel " << name
+                       << " at " << entry << ", static local memory: "
+                       << k.static_local_mem_size << " bytes" << std::endl;
+  }
+
+  return make_success();
+}
+
+}
+}
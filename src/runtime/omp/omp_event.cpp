@@ -46,6 +46,13 @@ void omp_node_event::wait() {
   _signal_channel->wait();
 }
 
+bool omp_node_event::notify_on_completion(std::function<void()> callback) {
+  // The omp queue worker thread invokes the callback when it
+  // signals the channel.
+  _signal_channel->on_signal(std::move(callback));
+  return true;
+}
+
 std::shared_ptr<signal_channel>
 omp_node_event::get_signal_channel() const {
   return _signal_channel;
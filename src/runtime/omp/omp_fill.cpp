@@ -0,0 +1,151 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/omp/omp_fill.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HIPSYCL_OMP_FILL_STREAMING_STORES
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+constexpr std::size_t block_size = 16;
+// Granularity of the work decomposition. Chunks that are aligned to the
+// start of the fill only line up with pages if the fill is page-aligned.
+constexpr std::size_t chunk_size = 4096;
+// Below this, waking up the OpenMP threads costs more than it gains
+constexpr std::size_t min_parallel_size = 1024 * 1024;
+
+// A block of the pattern, repeated and rotated such that it can be
+// stored at an address that is \c phase bytes into the pattern.
+struct pattern_block {
+  pattern_block(const unsigned char *pattern, std::size_t pattern_size,
+                std::size_t phase) {
+    for(std::size_t i = 0; i < block_size; ++i)
+      data[i] = pattern[(phase + i) % pattern_size];
+  }
+
+  alignas(block_size) unsigned char data[block_size];
+};
+
+void fill_bytes(char *begin, std::size_t num_bytes, std::size_t offset,
+                const unsigned char *pattern, std::size_t pattern_size) {
+  for(std::size_t i = 0; i < num_bytes; ++i)
+    begin[i] = pattern[(offset + i) % pattern_size];
+}
+
+// Fills [begin, begin+num_bytes), which starts \c offset bytes after
+// the start of the fill.
+void fill_range(char *begin, std::size_t num_bytes, std::size_t offset,
+                const unsigned char *pattern, std::size_t pattern_size,
+                bool use_streaming_stores) {
+  if(pattern_size == 1 && !use_streaming_stores) {
+    std::memset(begin, pattern[0], num_bytes);
+    return;
+  }
+
+  std::size_t head = std::min(
+      num_bytes,
+      (block_size - reinterpret_cast<std::uintptr_t>(begin) % block_size) %
+          block_size);
+  fill_bytes(begin, head, offset, pattern, pattern_size);
+
+  char *aligned_begin = begin + head;
+  std::size_t num_blocks = (num_bytes - head) / block_size;
+  pattern_block block{pattern, pattern_size, (offset + head) % pattern_size};
+
+#ifdef HIPSYCL_OMP_FILL_STREAMING_STORES
+  if(use_streaming_stores) {
+    __m128i value =
+        _mm_load_si128(reinterpret_cast<const __m128i *>(block.data));
+    for(std::size_t i = 0; i < num_blocks; ++i)
+      _mm_stream_si128(
+          reinterpret_cast<__m128i *>(aligned_begin + i * block_size), value);
+  } else
+#endif
+  {
+    for(std::size_t i = 0; i < num_blocks; ++i)
+      std::memcpy(aligned_begin + i * block_size, block.data, block_size);
+  }
+
+  std::size_t tail_offset = head + num_blocks * block_size;
+  fill_bytes(begin + tail_offset, num_bytes - tail_offset,
+             offset + tail_offset, pattern, pattern_size);
+}
+
+}
+
+void omp_fill(void *ptr, std::size_t num_bytes, const unsigned char *pattern,
+              std::size_t pattern_size, std::size_t streaming_threshold) {
+  assert(pattern_size > 0 && block_size % pattern_size == 0);
+
+  char *base = static_cast<char *>(ptr);
+  const std::size_t num_chunks = (num_bytes + chunk_size - 1) / chunk_size;
+
+  if(num_bytes < min_parallel_size ||
+     num_chunks < static_cast<std::size_t>(omp_get_max_threads())) {
+    fill_range(base, num_bytes, 0, pattern, pattern_size, false);
+    return;
+  }
+
+  const bool use_streaming_stores = num_bytes >= streaming_threshold;
+
+#pragma omp parallel
+  {
+    // A static schedule assigns contiguous ranges to threads in
+    // thread order. omp_queue runs both fills and kernels on its worker
+    // thread's OpenMP team, so with pinned threads, pages touched first
+    // by a fill are placed close to the threads that process the
+    // corresponding part of a 1D kernel with a static schedule.
+#pragma omp for schedule(static)
+    for(std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      std::size_t offset = chunk * chunk_size;
+      fill_range(base + offset, std::min(chunk_size, num_bytes - offset),
+                 offset, pattern, pattern_size, use_streaming_stores);
+    }
+#ifdef HIPSYCL_OMP_FILL_STREAMING_STORES
+    // Non-temporal stores are weakly ordered; make them visible before
+    // the fill is reported as complete.
+    if(use_streaming_stores)
+      _mm_sfence();
+#endif
+  }
+}
+
+}
+}
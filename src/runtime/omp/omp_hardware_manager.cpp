@@ -27,15 +27,45 @@
 
 
 #include <omp.h>
+#include <atomic>
 #include <limits>
 
 #include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
+#include "hipSYCL/runtime/hw_model/numa.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/common/debug.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+void bind_omp_team_to_numa_domains(const numa_topology &topology) {
+  if(topology.get_num_domains() < 2)
+    return;
+
+  std::atomic<std::size_t> num_failures{0};
+#pragma omp parallel
+  {
+    std::size_t domain = topology.get_domain_of_thread(
+        omp_get_thread_num(), omp_get_num_threads());
+    if(!topology.bind_current_thread(domain))
+      ++num_failures;
+  }
+  if(num_failures > 0) {
+    HIPSYCL_DEBUG_WARNING << "omp: Could not bind " << num_failures
+                          << " OpenMP thread(s) to their NUMA domain"
+                          << std::endl;
+  }
+}
+
+omp_hardware_context::omp_hardware_context() {
+  numa_topology topology = numa_topology::from_sysfs();
+  HIPSYCL_DEBUG_INFO << "omp_hardware_context: Found "
+                     << topology.get_num_domains()
+                     << " NUMA domain(s) with a total of "
+                     << topology.get_num_cpus() << " CPUs" << std::endl;
+}
+
 
 bool omp_hardware_context::is_cpu() const {
   return true;
@@ -122,7 +152,11 @@ bool omp_hardware_context::has(device_support_aspect aspect) const {
     return true;
     break;
   case device_support_aspect::sscp_kernels:
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+    return true;
+#else
     return false;
+#endif
     break;
   }
   assert(false && "Unknown device aspect");
@@ -33,14 +33,30 @@
 #include "hipSYCL/runtime/inorder_queue.hpp"
 #include "hipSYCL/runtime/instrumentation.hpp"
 #include "hipSYCL/runtime/omp/omp_event.hpp"
+#include "hipSYCL/runtime/omp/omp_fill.hpp"
+#include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/kernel_launcher.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/queue_completion_event.hpp"
 #include "hipSYCL/runtime/signal_channel.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
+#include "hipSYCL/runtime/performance_counters.hpp"
 
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/omp/omp_code_object.hpp"
+
+#endif
+
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace hipsycl {
 namespace rt {
@@ -111,19 +127,30 @@ using omp_execution_finish_timestamp =
 class instrumentation_task_guard {
 public:
   instrumentation_task_guard(std::shared_ptr<omp_execution_start_timestamp> start,
-             std::shared_ptr<omp_execution_finish_timestamp> finish)
-      : _finish{finish} {
+             std::shared_ptr<omp_execution_finish_timestamp> finish,
+             performance_counters::kernel_counters* kernel_counters)
+      : _finish{finish}, _kernel_counters{kernel_counters} {
     if(start)
       start->record_time();
+    if(_kernel_counters)
+      _kernel_start = profiler_clock::now();
   }
 
   ~instrumentation_task_guard() {
     if(_finish)
       _finish->record_time();
+    if(_kernel_counters) {
+      _kernel_counters->kernel_executed(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              profiler_clock::now() - _kernel_start)
+              .count());
+    }
   }
 
 private:
   std::shared_ptr<omp_execution_finish_timestamp> _finish;
+  performance_counters::kernel_counters* _kernel_counters;
+  profiler_clock::time_point _kernel_start;
 };
 
 class omp_instrumentation_setup {
@@ -157,23 +184,43 @@ public:
     }
   }
 
+  // Kernels are additionally timed for the performance counters
+  omp_instrumentation_setup(kernel_operation &op, dag_node_ptr node)
+      : omp_instrumentation_setup{static_cast<operation &>(op), node} {
+    _kernel_counters = op.get_performance_counters();
+  }
+
   instrumentation_task_guard instrument_task() const {
-    return instrumentation_task_guard{_start, _finish};
+    return instrumentation_task_guard{_start, _finish, _kernel_counters};
   }
 
 private:
   std::shared_ptr<omp_execution_start_timestamp> _start;
   std::shared_ptr<omp_execution_finish_timestamp> _finish;
+  performance_counters::kernel_counters* _kernel_counters = nullptr;
 };
 
 }
 
 
-omp_queue::omp_queue(backend_id id)
-: _backend_id(id) {}
+omp_queue::omp_queue(backend_id id, priority_arbiter *arbiter, int priority,
+                     const numa_topology *numa_topology)
+: _backend_id(id), _arbiter{arbiter}, _priority{priority},
+  _sscp_code_object_invoker{this} {
+  if(_arbiter && _priority != 0)
+    _arbiter->register_prioritized_queue();
+  // Operations run on the worker thread's OpenMP team, so bind
+  // it before anything else is executed.
+  if(numa_topology)
+    _worker([topology = *numa_topology]() {
+      bind_omp_team_to_numa_domains(topology);
+    });
+}
 
 omp_queue::~omp_queue() {
   _worker.halt();
+  if(_arbiter && _priority != 0)
+    _arbiter->unregister_prioritized_queue();
 }
 
 std::shared_ptr<dag_node_event> omp_queue::insert_event() {
@@ -226,6 +273,7 @@ result omp_queue::submit_memcpy(memcpy_operation &op, dag_node_ptr node) {
 
     _worker([=]() {
       auto instrumentation_guard = instrumentation_setup.instrument_task();
+      trace_scope trace{"omp", "memcpy", total_num_bytes};
 
       auto linear_index = [](id<3> id, range<3> allocation_shape) {
         return id[2] + allocation_shape[2] * id[1] +
@@ -307,13 +355,24 @@ result omp_queue::submit_kernel(kernel_operation &op, dag_node_ptr node) {
   }
 
   
+  rt::backend_kernel_launch_capabilities cap;
+  cap.provide_sscp_invoker(&_sscp_code_object_invoker);
+  launcher->set_backend_capabilities(cap);
+
   rt::dag_node* node_ptr = node.get();
   const glue::kernel_configuration *config =
       &(op.get_launcher().get_kernel_configuration());
 
   omp_instrumentation_setup instrumentation_setup{op, node};
+  priority_arbiter* arbiter = _arbiter;
+  int priority = _priority;
   _worker([=]() {
+    std::optional<priority_arbiter::guard> priority_guard;
+    if(arbiter)
+      priority_guard.emplace(arbiter->acquire(priority));
+
     auto instrumentation_guard = instrumentation_setup.instrument_task();
+    trace_scope trace{"omp", "kernel"};
 
     HIPSYCL_DEBUG_INFO << "omp_queue [async]: Invoking kernel!" << std::endl;
     launcher->invoke(node_ptr, *config);
@@ -341,7 +400,6 @@ result omp_queue::submit_prefetch(prefetch_operation &op, dag_node_ptr node) {
 result omp_queue::submit_memset(memset_operation & op, dag_node_ptr node) {
   void *ptr = op.get_pointer();
   std::size_t bytes = op.get_num_bytes();
-  int pattern = op.get_pattern();
   
   if (!ptr) {
     return register_error(
@@ -350,12 +408,28 @@ result omp_queue::submit_memset(memset_operation & op, dag_node_ptr node) {
             "omp_queue: submit_memset(): Invalid argument, pointer is null."});
   }
 
+  std::size_t pattern_size = op.get_pattern_size();
+  std::array<unsigned char, memset_operation::max_pattern_size> pattern;
+  std::copy(op.get_pattern_data(), op.get_pattern_data() + pattern_size,
+            pattern.begin());
+  std::size_t streaming_threshold =
+      application::get_settings()
+          .get<setting::omp_streaming_fill_threshold>() *
+      1024 * 1024;
 
   omp_instrumentation_setup instrumentation_setup{op, node};
+  priority_arbiter* arbiter = _arbiter;
+  int priority = _priority;
   _worker([=]() {
+    // Large fills occupy all OpenMP threads, just like kernels
+    std::optional<priority_arbiter::guard> priority_guard;
+    if(arbiter)
+      priority_guard.emplace(arbiter->acquire(priority));
+
     auto instrumentation_guard = instrumentation_setup.instrument_task();
+    trace_scope trace{"omp", "memset", bytes};
 
-    memset(ptr, pattern, bytes);
+    omp_fill(ptr, bytes, pattern.data(), pattern_size, streaming_threshold);
   });
 
   return make_success();
@@ -420,5 +494,192 @@ void *omp_queue::get_native_type() const {
   return nullptr;
 }
 
+sscp_code_object_invoker* omp_queue::get_sscp_code_object_invoker() {
+  return &_sscp_code_object_invoker;
+}
+
+result omp_queue::get_sscp_code_object(
+    const sscp_kernel_id &kernel_id, const glue::kernel_configuration &config,
+    const code_object *&obj_out) {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+
+  const hcf_object_id hcf_object = kernel_id.hcf_object;
+  const std::string &kernel_name = kernel_id.kernel_name;
+  const hcf_kernel_info *kernel_info = kernel_id.kernel_info;
+
+  auto configuration_id = config.generate_id();
+
+  auto code_object_selector = [&](const code_object *candidate) -> bool {
+    if ((candidate->managing_backend() != backend_id::omp) ||
+        (candidate->source_compilation_flow() != compilation_flow::sscp) ||
+        (candidate->state() != code_object_state::executable))
+      return false;
+
+    return candidate->configuration_id() == configuration_id;
+  };
+
+  auto code_object_constructor = [&]() -> code_object* {
+    const common::hcf_container* hcf = rt::hcf_cache::get().get_hcf(hcf_object);
+
+    std::vector<std::string> kernel_names;
+    std::string selected_image_name =
+        glue::jit::select_image(kernel_info, &kernel_names);
+
+    // Construct host translator to compile the specified kernels
+    std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+      compiler::createLLVMToHostTranslator(kernel_names);
+
+    // Lower kernels to a native object file
+    std::string object_file;
+    auto err = glue::jit::compile(translator.get(),
+        hcf, selected_image_name, config, object_file);
+
+    if(!err.is_success()) {
+      register_error(err);
+      return nullptr;
+    }
+
+    omp_sscp_executable_object *exec_obj = new omp_sscp_executable_object{
+        object_file, hcf_object, kernel_names, config};
+    result r = exec_obj->get_build_result();
+
+    if(!r.is_success()) {
+      register_error(r);
+      delete exec_obj;
+      return nullptr;
+    }
+
+    HIPSYCL_DEBUG_INFO
+        << "omp_queue: Successfully compiled SSCP kernels to native code"
+        << std::endl;
+
+    return exec_obj;
+  };
+
+  const code_object *obj = kernel_cache::get().get_or_construct_code_object(
+      kernel_id.kernel_index, kernel_name, backend_id::omp, hcf_object,
+      configuration_id, code_object_selector, code_object_constructor);
+
+  if(!obj) {
+    return make_error(__hipsycl_here(),
+                      error_info{"omp_queue: Code object construction failed"});
+  }
+
+  obj_out = obj;
+  return make_success();
+#else
+  return make_error(
+      __hipsycl_here(),
+      error_info{
+          "omp_queue: SSCP kernel compilation was requested, but hipSYCL was "
+          "not built with host SSCP support."});
+#endif
+}
+
+result omp_queue::submit_sscp_kernel_from_code_object(
+    const kernel_operation &op, const sscp_kernel_id &kernel_id,
+    const rt::range<3> &num_groups, const rt::range<3> &group_size,
+    unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+    std::size_t num_args,
+    const glue::kernel_configuration &config) {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+
+  const code_object *obj = nullptr;
+  result err = get_sscp_code_object(kernel_id, config, obj);
+  if(!err.is_success())
+    return err;
+
+  const omp_sscp_executable_object::kernel_entry *kernel =
+      static_cast<const omp_sscp_executable_object *>(obj)->get_kernel(
+          kernel_id.kernel_name);
+  if(!kernel) {
+    return make_error(
+        __hipsycl_here(),
+        error_info{"omp_queue: Code object does not contain kernel " +
+                   kernel_id.kernel_name});
+  }
+
+  glue::jit::cxx_argument_mapper arg_mapper{*kernel_id.kernel_info, args,
+                                            arg_sizes, num_args};
+  if(!arg_mapper.mapping_available()) {
+    return make_error(
+        __hipsycl_here(),
+        error_info{
+            "omp_queue: Could not map C++ arguments to kernel arguments"});
+  }
+
+  // The host kernel ABI expects the fastest moving dimension last,
+  // while rt::range<3> stores it first.
+  const std::size_t local_size[3] = {group_size[2], group_size[1],
+                                     group_size[0]};
+  const std::size_t group_count[3] = {num_groups[2], num_groups[1],
+                                      num_groups[0]};
+  const std::size_t total_num_groups = num_groups.size();
+  const std::size_t local_mem_bytes =
+      kernel->static_local_mem_size + local_mem_size;
+
+  compiler::host::KernelEntrypoint entrypoint = kernel->entrypoint;
+  void **mapped_args = arg_mapper.get_mapped_args();
+
+  struct alignas(compiler::host::LocalMemoryAlignment) local_mem_block {
+    unsigned char data[compiler::host::LocalMemoryAlignment];
+  };
+  const std::size_t num_local_mem_blocks =
+      (local_mem_bytes + sizeof(local_mem_block) - 1) / sizeof(local_mem_block);
+
+#pragma omp parallel
+  {
+    // Each thread executes entire groups, so local memory
+    // can be reused across the groups of one thread.
+    std::vector<local_mem_block> local_mem(num_local_mem_blocks);
+
+#pragma omp for schedule(static)
+    for(std::size_t g = 0; g < total_num_groups; ++g) {
+      std::size_t group_id[3];
+      group_id[2] = g % group_count[2];
+      group_id[1] = (g / group_count[2]) % group_count[1];
+      group_id[0] = g / (group_count[2] * group_count[1]);
+
+      entrypoint(mapped_args, local_size, group_id, group_count,
+                 local_mem.data());
+    }
+  }
+
+  return make_success();
+#else
+  return make_error(
+      __hipsycl_here(),
+      error_info{
+          "omp_queue: SSCP kernel launch was requested, but hipSYCL was "
+          "not built with host SSCP support."});
+#endif
+}
+
+result omp_sscp_code_object_invoker::submit_kernel(
+    const kernel_operation &op, const sscp_kernel_id &kernel_id,
+    const rt::range<3> &num_groups, const rt::range<3> &group_size,
+    unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+    std::size_t num_args, const glue::kernel_configuration &config) {
+
+  return _queue->submit_sscp_kernel_from_code_object(
+      op, kernel_id, num_groups, group_size, local_mem_size, args, arg_sizes,
+      num_args, config);
+}
+
+result omp_sscp_code_object_invoker::prepare_kernel(
+    hcf_object_id hcf_object, const std::string &global_kernel_name,
+    const std::string &kernel_name, unsigned local_mem_size,
+    const glue::kernel_configuration &config) {
+
+  sscp_kernel_id kernel_id;
+  result err = resolve_sscp_kernel(hcf_object, global_kernel_name,
+                                   kernel_name, kernel_id);
+  if(!err.is_success())
+    return err;
+
+  const code_object *obj = nullptr;
+  return _queue->get_sscp_code_object(kernel_id, config, obj);
+}
+
 }
 }
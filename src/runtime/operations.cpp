@@ -29,6 +29,9 @@
 #include "hipSYCL/runtime/dag_node.hpp"
 #include "hipSYCL/runtime/instrumentation.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 namespace hipsycl {
 namespace rt {
 
@@ -42,8 +45,10 @@ const instrumentation_set &operation::get_instrumentations() const {
 
 kernel_operation::kernel_operation(
     const std::string &kernel_name, std::vector<std::unique_ptr<backend_kernel_launcher>> kernels,
-    const requirements_list& reqs)
-    : _kernel_name{kernel_name}, _launcher{std::move(kernels)}
+    const requirements_list& reqs,
+    performance_counters::kernel_counters* counters)
+    : _kernel_name{kernel_name}, _launcher{std::move(kernels)},
+      _performance_counters{counters}
 {
   for(auto req_node : reqs.get()){
     operation* op = req_node->get_operation();
@@ -61,10 +66,50 @@ kernel_launcher&
 kernel_operation::get_launcher()
 { return _launcher; }
 
+void kernel_operation::release_dependencies() {
+  // Embedded pointers have been initialized when the kernel
+  // was launched, so the requirement nodes are no longer needed.
+  _requirements.clear();
+}
+
 const kernel_launcher& 
 kernel_operation::get_launcher() const
 { return _launcher; }
 
+memset_operation::memset_operation(void *ptr, const void *pattern,
+                                   std::size_t pattern_size,
+                                   std::size_t num_bytes)
+    : _ptr{ptr}, _pattern_size{pattern_size}, _num_bytes{num_bytes} {
+  assert(pattern_size > 0 && max_pattern_size % pattern_size == 0);
+  std::memcpy(_pattern, pattern, pattern_size);
+}
+
+memset_operation::memset_operation(dag_node_ptr buffer_requirement,
+                                   const void *pattern,
+                                   std::size_t pattern_size,
+                                   std::size_t num_bytes)
+    : memset_operation{nullptr, pattern, pattern_size, num_bytes} {
+  assert(buffer_requirement->get_operation()->is_requirement());
+  _buffer_requirement = buffer_requirement;
+}
+
+void *memset_operation::get_pointer() const {
+  if(!_buffer_requirement)
+    return _ptr;
+
+  auto *req = cast<buffer_memory_requirement>(
+      _buffer_requirement->get_operation());
+  if(!req->has_device_ptr())
+    return nullptr;
+
+  return static_cast<char *>(req->get_device_ptr()) +
+         req->get_data_region()->get_byte_offset(req->get_access_offset3d());
+}
+
+void memset_operation::release_dependencies() {
+  _buffer_requirement = nullptr;
+}
+
 
 
 void requirements_list::add_requirement(std::unique_ptr<requirement> req)
@@ -75,6 +120,7 @@ void requirements_list::add_requirement(std::unique_ptr<requirement> req)
     std::move(req),
     _rt);
   
+  _own_reqs.push_back(node.get());
   add_node_requirement(node);
 }
 
@@ -88,6 +134,11 @@ void requirements_list::add_node_requirement(dag_node_ptr node)
 const std::vector<dag_node_ptr>& requirements_list::get() const
 { return _reqs; }
 
+bool requirements_list::is_own_requirement(const dag_node_ptr &node) const {
+  return std::find(_own_reqs.begin(), _own_reqs.end(), node.get()) !=
+         _own_reqs.end();
+}
+
 memory_location::memory_location(
     device_id d, id<3> access_offset,
     std::shared_ptr<buffer_data_region> data_region)
@@ -0,0 +1,305 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/performance_counters.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+int find_highest_bit(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 63 - __builtin_clzll(x);
+#else
+  int result = 0;
+  while(x >>= 1)
+    ++result;
+  return result;
+#endif
+}
+
+void atomic_max(std::atomic<uint64_t> &target, uint64_t value) {
+  uint64_t current = target.load(std::memory_order_relaxed);
+  while(value > current &&
+        !target.compare_exchange_weak(current, value,
+                                      std::memory_order_relaxed))
+    ;
+}
+
+}
+
+int duration_histogram::get_bucket(uint64_t ns) {
+  if(ns < sub_buckets)
+    return static_cast<int>(ns);
+  int exponent = find_highest_bit(ns);
+  // The two bits below the highest bit select the sub-bucket
+  int sub_bucket = static_cast<int>((ns >> (exponent - 2)) & (sub_buckets - 1));
+  return exponent * sub_buckets + sub_bucket;
+}
+
+uint64_t duration_histogram::get_bucket_upper_bound(int bucket) {
+  if(bucket < sub_buckets)
+    return bucket;
+  int exponent = bucket / sub_buckets;
+  uint64_t sub_bucket = bucket % sub_buckets;
+  return ((sub_buckets + sub_bucket + 1) << (exponent - 2)) - 1;
+}
+
+void duration_histogram::add(uint64_t ns) {
+  _buckets[get_bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+  _count.fetch_add(1, std::memory_order_relaxed);
+  _total.fetch_add(ns, std::memory_order_relaxed);
+  atomic_max(_max, ns);
+}
+
+uint64_t duration_histogram::get_count() const {
+  return _count.load(std::memory_order_relaxed);
+}
+
+uint64_t duration_histogram::get_total() const {
+  return _total.load(std::memory_order_relaxed);
+}
+
+uint64_t duration_histogram::get_max() const {
+  return _max.load(std::memory_order_relaxed);
+}
+
+uint64_t duration_histogram::get_percentile(double p) const {
+  uint64_t count = get_count();
+  if(count == 0)
+    return 0;
+
+  uint64_t threshold = static_cast<uint64_t>(p * count);
+  if(threshold == 0)
+    threshold = 1;
+
+  uint64_t cumulative = 0;
+  for(int i = 0; i < num_buckets; ++i) {
+    cumulative += _buckets[i].load(std::memory_order_relaxed);
+    if(cumulative >= threshold)
+      return std::min(get_bucket_upper_bound(i), get_max());
+  }
+  return get_max();
+}
+
+performance_counters::performance_counters(bool enabled)
+: _enabled{enabled} {}
+
+performance_counters &performance_counters::get() {
+  // Never destroyed, since worker threads might still update counters
+  // during static destruction.
+  static performance_counters *c = []() {
+    performance_counters *result = new performance_counters{
+        application::get_settings().get<setting::performance_counters>()};
+    if(result->is_enabled()) {
+      std::atexit([]() {
+        performance_counters &c = performance_counters::get();
+        if(!c._was_dumped) {
+          std::cerr << "[hipSYCL] Runtime performance counters:\n";
+          c.dump(std::cerr);
+        }
+      });
+    }
+    return result;
+  }();
+  return *c;
+}
+
+performance_counters::kernel_counters *
+performance_counters::get_kernel_counters(const std::string &kernel_name) {
+  if(!_enabled)
+    return nullptr;
+
+  std::unique_lock<std::shared_mutex> lock{_mutex};
+  auto it = _kernel_indices.find(kernel_name);
+  if(it != _kernel_indices.end())
+    return &_kernels[it->second];
+
+  _kernels.emplace_back();
+  _kernel_names.push_back(kernel_name);
+  _kernel_indices[kernel_name] = _kernels.size() - 1;
+  return &_kernels.back();
+}
+
+performance_counters::transfer_counters &
+performance_counters::get_transfer_counters(const device_id &source,
+                                            const device_id &dest) {
+  auto find = [&]() -> transfer_counters* {
+    for(auto &t : _transfers)
+      if(t.source == source && t.dest == dest)
+        return &t;
+    return nullptr;
+  };
+  {
+    std::shared_lock<std::shared_mutex> lock{_mutex};
+    if(transfer_counters *t = find())
+      return *t;
+  }
+  std::unique_lock<std::shared_mutex> lock{_mutex};
+  if(transfer_counters *t = find())
+    return *t;
+
+  _transfers.emplace_back();
+  _transfers.back().source = source;
+  _transfers.back().dest = dest;
+  return _transfers.back();
+}
+
+performance_counters::allocation_counters &
+performance_counters::get_allocation_counters(const device_id &dev) {
+  auto find = [&]() -> allocation_counters* {
+    for(auto &a : _allocations)
+      if(a.dev == dev)
+        return &a;
+    return nullptr;
+  };
+  {
+    std::shared_lock<std::shared_mutex> lock{_mutex};
+    if(allocation_counters *a = find())
+      return *a;
+  }
+  std::unique_lock<std::shared_mutex> lock{_mutex};
+  if(allocation_counters *a = find())
+    return *a;
+
+  _allocations.emplace_back();
+  _allocations.back().dev = dev;
+  return _allocations.back();
+}
+
+void performance_counters::memcpy_submitted(const device_id &source,
+                                            const device_id &dest,
+                                            std::size_t num_bytes) {
+  if(!_enabled)
+    return;
+  transfer_counters &t = get_transfer_counters(source, dest);
+  t.num_transfers.fetch_add(1, std::memory_order_relaxed);
+  t.num_bytes.fetch_add(num_bytes, std::memory_order_relaxed);
+}
+
+void performance_counters::memory_allocated(const device_id &dev,
+                                            std::size_t num_bytes) {
+  if(!_enabled)
+    return;
+  allocation_counters &a = get_allocation_counters(dev);
+  a.num_allocations.fetch_add(1, std::memory_order_relaxed);
+  a.num_bytes.fetch_add(num_bytes, std::memory_order_relaxed);
+}
+
+performance_counter_snapshot performance_counters::get_snapshot() const {
+  performance_counter_snapshot s;
+  auto load = [](const std::atomic<uint64_t> &v) {
+    return v.load(std::memory_order_relaxed);
+  };
+
+  s.dag_nodes_built = load(_dag_nodes_built);
+  s.dag_nodes_flushed = load(_dag_nodes_flushed);
+  s.requirement_edges_pruned = load(_requirement_edges_pruned);
+  s.kernel_cache_hits = load(_kernel_cache_hits);
+  s.kernel_cache_misses = load(_kernel_cache_misses);
+  s.persistent_kernel_cache_hits = load(_persistent_kernel_cache_hits);
+  s.persistent_kernel_cache_misses = load(_persistent_kernel_cache_misses);
+
+  std::shared_lock<std::shared_mutex> lock{_mutex};
+  for(std::size_t i = 0; i < _kernels.size(); ++i) {
+    const kernel_counters &k = _kernels[i];
+    kernel_performance_statistics stats;
+    stats.kernel_name = _kernel_names[i];
+    stats.num_launches = load(k._num_launches);
+    stats.num_timed_executions = k._execution_times.get_count();
+    stats.total_execution_time_ns = k._execution_times.get_total();
+    if(stats.num_timed_executions > 0)
+      stats.mean_execution_time_ns =
+          stats.total_execution_time_ns / stats.num_timed_executions;
+    stats.p99_execution_time_ns = k._execution_times.get_percentile(0.99);
+    stats.max_execution_time_ns = k._execution_times.get_max();
+    s.kernels.push_back(stats);
+  }
+  for(const transfer_counters &t : _transfers) {
+    s.transfers.push_back(transfer_performance_statistics{
+        t.source, t.dest, load(t.num_transfers), load(t.num_bytes)});
+  }
+  for(const allocation_counters &a : _allocations) {
+    s.allocations.push_back(allocation_performance_statistics{
+        a.dev, load(a.num_allocations), load(a.num_bytes)});
+  }
+  return s;
+}
+
+void performance_counters::dump(std::ostream &out) {
+  _was_dumped = true;
+  get_snapshot().dump(out);
+}
+
+void performance_counter_snapshot::dump(std::ostream &out) const {
+  out << "  DAG nodes built: " << dag_nodes_built << "\n";
+  out << "  DAG nodes flushed: " << dag_nodes_flushed << "\n";
+  out << "  Requirement edges pruned: " << requirement_edges_pruned << "\n";
+  out << "  Kernel cache hits/misses: " << kernel_cache_hits << "/"
+      << kernel_cache_misses << "\n";
+  out << "  Persistent kernel cache hits/misses: "
+      << persistent_kernel_cache_hits << "/" << persistent_kernel_cache_misses
+      << "\n";
+
+  for(const auto &k : kernels) {
+    out << "  Kernel " << k.kernel_name << ": " << k.num_launches
+        << " launches";
+    if(k.num_timed_executions > 0) {
+      out << ", " << k.num_timed_executions << " timed executions, total "
+          << k.total_execution_time_ns << "ns, mean "
+          << k.mean_execution_time_ns << "ns, p99 " << k.p99_execution_time_ns
+          << "ns, max " << k.max_execution_time_ns << "ns";
+    }
+    out << "\n";
+  }
+  for(const auto &t : transfers) {
+    out << "  Transfers ";
+    t.source.dump(out);
+    out << " -> ";
+    t.dest.dump(out);
+    out << ": " << t.num_transfers << " transfers, " << t.num_bytes
+        << " bytes\n";
+  }
+  for(const auto &a : allocations) {
+    out << "  Allocations on ";
+    a.dev.dump(out);
+    out << ": " << a.num_allocations << " allocations, " << a.num_bytes
+        << " bytes\n";
+  }
+  out << std::flush;
+}
+
+}
+}
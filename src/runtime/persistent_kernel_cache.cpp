@@ -0,0 +1,315 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/persistent_kernel_cache.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/performance_counters.hpp"
+#include "hipSYCL/common/config.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/common/stable_fast_hash.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include HIPSYCL_CXX_FILESYSTEM_HEADER
+namespace fs = HIPSYCL_CXX_FILESYSTEM_NAMESPACE;
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+constexpr const char* entry_extension = ".jit";
+constexpr const char* entry_magic = "HIPSYCL-JIT-CACHE-1";
+
+template<class T>
+void write_value(std::ostream& ostr, const T& val) {
+  ostr.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template<class T>
+bool read_value(std::istream& istr, T& val) {
+  istr.read(reinterpret_cast<char*>(&val), sizeof(T));
+  return static_cast<bool>(istr);
+}
+
+// remaining is the number of bytes left in the stream. It bounds the
+// string size, which cannot be trusted since it is read from the file.
+bool read_string(std::istream& istr, std::string& out, uint64_t& remaining) {
+  uint64_t size = 0;
+  if(remaining < sizeof(size) || !read_value(istr, size))
+    return false;
+  remaining -= sizeof(size);
+  if(size > remaining)
+    return false;
+  remaining -= size;
+  out.resize(size);
+  istr.read(out.data(), size);
+  return static_cast<bool>(istr);
+}
+
+void write_string(std::ostream& ostr, const std::string& s) {
+  write_value(ostr, static_cast<uint64_t>(s.size()));
+  ostr.write(s.data(), s.size());
+}
+
+// Suffix for temporary files that is unique across threads and,
+// with high probability, across processes sharing the cache directory.
+std::string generate_temporary_suffix() {
+  static const uint64_t process_salt = [](){
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+  }();
+  static std::atomic<uint64_t> counter = 0;
+
+  std::stringstream sstr;
+  sstr << ".tmp-" << std::hex << process_salt << "-" << counter++;
+  return sstr.str();
+}
+
+}
+
+persistent_kernel_cache::persistent_kernel_cache(const std::string &directory,
+                                                 std::size_t max_size)
+    : _directory{directory}, _max_size{max_size} {}
+
+persistent_kernel_cache& persistent_kernel_cache::get() {
+  static persistent_kernel_cache cache{
+      application::get_settings().get<setting::sscp_jit_cache_directory>(),
+      application::get_settings().get<setting::sscp_jit_cache_max_size>() *
+          1024 * 1024};
+  return cache;
+}
+
+std::string persistent_kernel_cache::get_entry_filename(const std::string& key) {
+  common::stable_fast_hash hash;
+  hash(key.data(), key.size());
+  auto h = hash.get_current_hash();
+  
+  std::stringstream sstr;
+  sstr << std::hex << std::setfill('0') << std::setw(16) << h[0]
+       << std::setw(16) << h[1] << entry_extension;
+  return sstr.str();
+}
+
+std::string persistent_kernel_cache::get_entry_path(const std::string& key) const {
+  return common::filesystem::join_path(_directory, get_entry_filename(key));
+}
+
+bool persistent_kernel_cache::load(const std::string &key,
+                                   std::string &out) const {
+  if(!is_enabled())
+    return false;
+
+  std::string path = get_entry_path(key);
+  std::ifstream file{path, std::ios::binary | std::ios::in};
+  if(!file.is_open())
+    return false;
+
+  std::error_code ec;
+  uint64_t remaining = fs::file_size(path, ec);
+  if(ec)
+    return false;
+
+  std::string magic;
+  std::string stored_key;
+  std::string data;
+  if (!read_string(file, magic, remaining) || magic != entry_magic ||
+      !read_string(file, stored_key, remaining) ||
+      !read_string(file, data, remaining)) {
+    HIPSYCL_DEBUG_WARNING << "persistent_kernel_cache: Ignoring invalid cache "
+                             "entry "
+                          << path << std::endl;
+    return false;
+  }
+  // Hash collision - this is not the entry we are looking for
+  if(stored_key != key)
+    return false;
+  
+  // Mark entry as recently used for LRU eviction
+  fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+  HIPSYCL_DEBUG_INFO << "persistent_kernel_cache: Loaded " << path
+                     << " from cache" << std::endl;
+  out = std::move(data);
+  return true;
+}
+
+bool persistent_kernel_cache::store(const std::string &key,
+                                    const std::string &data) {
+  if(!is_enabled())
+    return false;
+
+  std::error_code ec;
+  fs::create_directories(_directory, ec);
+  if(ec) {
+    HIPSYCL_DEBUG_WARNING << "persistent_kernel_cache: Could not create cache "
+                             "directory "
+                          << _directory << ": " << ec.message() << std::endl;
+    return false;
+  }
+
+  std::string path = get_entry_path(key);
+  std::string temporary_path = path + generate_temporary_suffix();
+  {
+    std::ofstream file{temporary_path,
+                       std::ios::binary | std::ios::out | std::ios::trunc};
+    if(!file.is_open()) {
+      HIPSYCL_DEBUG_WARNING << "persistent_kernel_cache: Could not open "
+                            << temporary_path << " for writing" << std::endl;
+      return false;
+    }
+    write_string(file, entry_magic);
+    write_string(file, key);
+    write_string(file, data);
+    file.close();
+    if(file.fail()) {
+      HIPSYCL_DEBUG_WARNING << "persistent_kernel_cache: Writing "
+                            << temporary_path << " failed" << std::endl;
+      fs::remove(temporary_path, ec);
+      return false;
+    }
+  }
+  // rename() is atomic, so other processes either see the old entry,
+  // no entry, or the complete new entry.
+  fs::rename(temporary_path, path, ec);
+  if(ec) {
+    HIPSYCL_DEBUG_WARNING << "persistent_kernel_cache: Could not move cache "
+                             "entry to "
+                          << path << ": " << ec.message() << std::endl;
+    fs::remove(temporary_path, ec);
+    return false;
+  }
+  HIPSYCL_DEBUG_INFO << "persistent_kernel_cache: Stored " << path
+                     << std::endl;
+  
+  if(_max_size > 0)
+    evict(_max_size);
+
+  return true;
+}
+
+result persistent_kernel_cache::get_or_compile(const std::string &key,
+                                               std::string &out,
+                                               const compiler_function &compiler) {
+  if(load(key, out)) {
+    performance_counters::get().persistent_kernel_cache_lookup(true);
+    return make_success();
+  }
+  performance_counters::get().persistent_kernel_cache_lookup(false);
+
+  result res = compiler(out);
+  if(res.is_success())
+    store(key, out);
+  
+  return res;
+}
+
+void persistent_kernel_cache::evict(std::size_t max_size) {
+  if(!is_enabled())
+    return;
+
+  struct entry {
+    fs::path path;
+    std::size_t size;
+    fs::file_time_type last_use;
+  };
+  
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  std::vector<entry> entries;
+  std::size_t total_size = 0;
+
+  std::error_code ec;
+  for(const auto& dir_entry : fs::directory_iterator{_directory, ec}) {
+    std::error_code entry_ec;
+    if(!dir_entry.is_regular_file(entry_ec) ||
+       dir_entry.path().extension() != entry_extension)
+      continue;
+    
+    entry e;
+    e.path = dir_entry.path();
+    e.size = dir_entry.file_size(entry_ec);
+    if(entry_ec)
+      continue;
+    e.last_use = dir_entry.last_write_time(entry_ec);
+    if(entry_ec)
+      continue;
+    
+    total_size += e.size;
+    entries.push_back(e);
+  }
+
+  if(total_size <= max_size)
+    return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const entry &a, const entry &b) {
+              return a.last_use < b.last_use;
+            });
+  
+  for(const auto& e : entries) {
+    if(total_size <= max_size)
+      break;
+    // Other processes may have removed the file in the meantime,
+    // so ignore errors.
+    if(fs::remove(e.path, ec)) {
+      HIPSYCL_DEBUG_INFO << "persistent_kernel_cache: Evicted "
+                         << e.path.string() << std::endl;
+    }
+    total_size -= e.size;
+  }
+}
+
+std::size_t persistent_kernel_cache::get_current_size() const {
+  if(!is_enabled())
+    return 0;
+
+  std::size_t total_size = 0;
+  std::error_code ec;
+  for(const auto& dir_entry : fs::directory_iterator{_directory, ec}) {
+    std::error_code entry_ec;
+    if(dir_entry.is_regular_file(entry_ec) &&
+       dir_entry.path().extension() == entry_extension) {
+      std::size_t size = dir_entry.file_size(entry_ec);
+      if(!entry_ec)
+        total_size += size;
+    }
+  }
+  return total_size;
+}
+
+}
+}
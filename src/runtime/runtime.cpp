@@ -26,6 +26,8 @@
  */
 
 #include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/jit_compilation_service.hpp"
 #include "hipSYCL/common/debug.hpp"
 
 namespace hipsycl {
@@ -42,6 +44,18 @@ runtime::~runtime()
 {
   HIPSYCL_DEBUG_INFO << "runtime: ******* rt shutdown ********"
                       << std::endl;
+
+  // Background compilations may still use the backends
+  jit_compilation_service::get().shutdown();
+
+  hcf_cache::registration_statistics hcf_stats =
+      hcf_cache::get().get_registration_statistics();
+  HIPSYCL_DEBUG_INFO << "runtime: HCF objects: "
+                     << hcf_stats.num_registered_objects << " registered in "
+                     << hcf_stats.registration_time_ns / 1000 << "us, "
+                     << hcf_stats.num_loaded_objects << " loaded in "
+                     << hcf_stats.deferred_loading_time_ns / 1000
+                     << "us (deferred)" << std::endl;
 }
 
 
@@ -131,8 +131,17 @@ void prefetch_operation::dump(std::ostream& ostr, int indentation) const {
 
 void memset_operation::dump(std::ostream &ostr, int indentation) const {
   ostr << get_indentation(indentation);
-  ostr << "Memset: @" << _ptr << " " << _num_bytes << " bytes of value "
-       << static_cast<int>(get_pattern());
+  ostr << "Memset: ";
+  if(_buffer_requirement)
+    ostr << "buffer requirement @" << _buffer_requirement.get();
+  else
+    ostr << "@" << _ptr;
+  ostr << " " << _num_bytes << " bytes of value ";
+  for(std::size_t i = 0; i < _pattern_size; ++i) {
+    if(i != 0)
+      ostr << " ";
+    ostr << static_cast<int>(_pattern[i]);
+  }
 }
 
 void memory_location::dump(std::ostream &ostr) const {
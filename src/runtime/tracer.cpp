@@ -0,0 +1,192 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/tracer.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+uint64_t steady_clock_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void write_json_string(std::ostream &out, const char *str) {
+  out << '"';
+  for(const char *c = str; c && *c; ++c) {
+    if(*c == '"' || *c == '\\')
+      out << '\\';
+    out << *c;
+  }
+  out << '"';
+}
+
+// Chrome trace timestamps are in microseconds
+void write_timestamp(std::ostream &out, uint64_t ns) {
+  out << ns / 1000 << '.';
+  uint64_t fraction = ns % 1000;
+  if(fraction < 100)
+    out << '0';
+  if(fraction < 10)
+    out << '0';
+  out << fraction;
+}
+
+}
+
+trace_buffer::trace_buffer(std::size_t thread_index)
+    : _thread_index{thread_index}, _head{0},
+      _records{new trace_record[capacity]} {}
+
+tracer::tracer(const std::string &filename)
+    : _enabled{!filename.empty()}, _filename{filename},
+      _start_ns{steady_clock_ns()} {
+  static std::atomic<uint64_t> next_id{1};
+  _id = next_id.fetch_add(1);
+}
+
+tracer &tracer::get() {
+  // Never destroyed, since worker threads might still record events
+  // during static destruction.
+  static tracer *t = [](){
+    tracer *result = new tracer{
+        application::get_settings().get<setting::trace_file>()};
+    if(result->is_enabled()) {
+      HIPSYCL_DEBUG_INFO << "tracer: Tracing enabled, writing trace to "
+                         << result->_filename << " on exit" << std::endl;
+      std::atexit([]() { tracer::get().write(); });
+    }
+    return result;
+  }();
+  return *t;
+}
+
+void tracer::record(const char *category, const char *name, uint64_t begin_ns,
+                    uint64_t end_ns, uint64_t arg) {
+  if(!is_enabled())
+    return;
+  get_thread_buffer()->push(trace_record{begin_ns, end_ns, category, name, arg,
+                                         trace_record::complete});
+}
+
+void tracer::record_instant(const char *category, const char *name,
+                            uint64_t arg) {
+  if(!is_enabled())
+    return;
+  uint64_t t = now();
+  get_thread_buffer()->push(
+      trace_record{t, t, category, name, arg, trace_record::instant});
+}
+
+uint64_t tracer::now() const {
+  return steady_clock_ns() - _start_ns;
+}
+
+trace_buffer *tracer::get_thread_buffer() {
+  // Usually there is only the global tracer. Other instances (e.g. in
+  // tests) get a new buffer whenever a thread switches between tracers.
+  thread_local uint64_t buffer_owner = 0;
+  thread_local trace_buffer *buffer = nullptr;
+
+  if(buffer_owner != _id) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _buffers.emplace_back(new trace_buffer{_buffers.size()});
+    buffer = _buffers.back().get();
+    buffer_owner = _id;
+  }
+  return buffer;
+}
+
+void tracer::write(std::ostream &out) {
+  // Records that are pushed concurrently might be torn,
+  // so stop recording first.
+  _enabled.store(false);
+
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool is_first = true;
+  auto begin_event = [&]() {
+    if(!is_first)
+      out << ",\n";
+    is_first = false;
+  };
+
+  for(const auto &buffer : _buffers) {
+    std::size_t tid = buffer->get_thread_index();
+
+    begin_event();
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid
+        << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+
+    buffer->for_each_record([&](const trace_record &r) {
+      begin_event();
+      out << "{\"name\":";
+      write_json_string(out, r.name);
+      out << ",\"cat\":";
+      write_json_string(out, r.category);
+      if(r.type == trace_record::instant) {
+        out << ",\"ph\":\"i\",\"s\":\"t\"";
+      } else {
+        out << ",\"ph\":\"X\",\"dur\":";
+        write_timestamp(out, r.end_ns - r.begin_ns);
+      }
+      out << ",\"ts\":";
+      write_timestamp(out, r.begin_ns);
+      out << ",\"pid\":0,\"tid\":" << tid << ",\"args\":{\"arg\":" << r.arg
+          << "}}";
+    });
+  }
+  out << "]}\n";
+}
+
+bool tracer::write() {
+  if(_filename.empty())
+    return false;
+
+  std::ofstream out{_filename, std::ios::trunc};
+  if(!out.is_open()) {
+    HIPSYCL_DEBUG_ERROR << "tracer: Could not open trace file " << _filename
+                        << std::endl;
+    return false;
+  }
+  write(out);
+  return out.good();
+}
+
+}
+}
@@ -62,17 +62,33 @@ result ze_multipass_code_object_invoker::submit_kernel(
 }
 
 result ze_sscp_code_object_invoker::submit_kernel(
-    const kernel_operation &op, hcf_object_id hcf_object,
+    const kernel_operation &op, const sscp_kernel_id &kernel_id,
     const rt::range<3> &num_groups, const rt::range<3> &group_size,
     unsigned int local_mem_size, void **args, std::size_t *arg_sizes,
-    std::size_t num_args, const std::string &kernel_name,
-    const glue::kernel_configuration &config) {
+    std::size_t num_args, const glue::kernel_configuration &config) {
 
   assert(_queue);
 
   return _queue->submit_sscp_kernel_from_code_object(
-      op, hcf_object, kernel_name, num_groups, group_size, local_mem_size, args,
-      arg_sizes, num_args, config);
+      op, kernel_id, num_groups, group_size, local_mem_size, args, arg_sizes,
+      num_args, config);
+}
+
+result ze_sscp_code_object_invoker::prepare_kernel(
+    hcf_object_id hcf_object, const std::string &global_kernel_name,
+    const std::string &kernel_name, unsigned local_mem_size,
+    const glue::kernel_configuration &config) {
+
+  assert(_queue);
+
+  sscp_kernel_id kernel_id;
+  result err = resolve_sscp_kernel(hcf_object, global_kernel_name,
+                                   kernel_name, kernel_id);
+  if(!err.is_success())
+    return err;
+
+  const code_object *obj = nullptr;
+  return _queue->get_sscp_code_object(kernel_id, local_mem_size, config, obj);
 }
 
 ze_executable_object::ze_executable_object(ze_context_handle_t ctx,
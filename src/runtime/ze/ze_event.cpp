@@ -29,13 +29,15 @@
 
 #include "hipSYCL/runtime/ze/ze_event.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/generic/async_worker.hpp"
 
 namespace hipsycl {
 namespace rt {
 
 ze_node_event::ze_node_event(ze_event_handle_t evt,
-                             std::shared_ptr<ze_event_pool_handle_t> pool)
-    : _evt{evt}, _pool{pool} {}
+                             std::shared_ptr<ze_event_pool_handle_t> pool,
+                             worker_thread *completion_notifier)
+    : _evt{evt}, _pool{pool}, _completion_notifier{completion_notifier} {}
 
 ze_node_event::~ze_node_event() {
   ze_result_t err = zeEventDestroy(_evt);
@@ -70,6 +72,21 @@ void ze_node_event::wait() {
   }
 }
 
+bool ze_node_event::notify_on_completion(std::function<void()> callback) {
+  if(!_completion_notifier)
+    return false;
+
+  // The notifier belongs to the in-order queue that signals this event,
+  // so waiting for events one after another in submission order
+  // does not delay notifications.
+  (*_completion_notifier)(
+      [self = shared_from_this(), callback = std::move(callback)]() {
+        self->wait();
+        callback();
+      });
+  return true;
+}
+
 ze_event_handle_t ze_node_event::get_event_handle() const {
   return _evt;
 }
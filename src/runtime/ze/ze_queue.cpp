@@ -186,6 +186,8 @@ ze_queue::ze_queue(ze_hardware_manager *hw_manager, std::size_t device_index)
 }
 
 ze_queue::~ze_queue() {
+  // Pending notifications wait for events from the command list
+  _completion_notifier.halt();
 
   ze_result_t err = zeCommandListDestroy(_command_list);
   if(err != ZE_RESULT_SUCCESS) {
@@ -224,7 +226,7 @@ std::shared_ptr<dag_node_event> ze_queue::create_event() {
     return nullptr;
   }
 
-  return std::make_shared<ze_node_event>(evt, pool);
+  return std::make_shared<ze_node_event>(evt, pool, &_completion_notifier);
 }
 
 std::shared_ptr<dag_node_event> ze_queue::create_queue_completion_event() {
@@ -384,6 +386,10 @@ void* ze_queue::get_native_type() const {
   return static_cast<void*>(_command_list);
 }
 
+sscp_code_object_invoker* ze_queue::get_sscp_code_object_invoker() {
+  return &_sscp_code_object_invoker;
+}
+
 const std::vector<std::shared_ptr<dag_node_event>>&
 ze_queue::get_enqueued_synchronization_ops() const {
   return _enqueued_synchronization_ops;
@@ -508,25 +514,15 @@ result ze_queue::submit_multipass_kernel_from_code_object(
   return make_success();
 }
 
-result ze_queue::submit_sscp_kernel_from_code_object(
-      const kernel_operation &op, hcf_object_id hcf_object,
-      const std::string &kernel_name, const rt::range<3> &num_groups,
-      const rt::range<3> &group_size, unsigned local_mem_size, void **args,
-      std::size_t *arg_sizes, std::size_t num_args,
-      const glue::kernel_configuration &initial_config) {
-
+result ze_queue::get_sscp_code_object(
+    const sscp_kernel_id &kernel_id, unsigned local_mem_size,
+    const glue::kernel_configuration &initial_config,
+    const code_object *&obj_out) {
 #ifdef HIPSYCL_WITH_SSCP_COMPILER
 
-  std::string global_kernel_name = op.get_global_kernel_name();
-  const kernel_cache::kernel_name_index_t* kidx =
-      kernel_cache::get().get_global_kernel_index(global_kernel_name);
-
-  if(!kidx) {
-    return make_error(
-        __hipsycl_here(),
-        error_info{"ze_queue: Could not obtain kernel index for kernel " +
-                   global_kernel_name});
-  }
+  const hcf_object_id hcf_object = kernel_id.hcf_object;
+  const std::string &kernel_name = kernel_id.kernel_name;
+  const hcf_kernel_info *kernel_info = kernel_id.kernel_info;
 
   ze_hardware_context *hw_ctx = static_cast<ze_hardware_context *>(
       _hw_manager->get_device(_device_index));
@@ -539,15 +535,6 @@ result ze_queue::submit_sscp_kernel_from_code_object(
   config.set("spirv-dynamic-local-mem-allocation-size", local_mem_size);
   auto configuration_id = config.generate_id();
 
-  const hcf_kernel_info *kernel_info =
-      rt::hcf_cache::get().get_kernel_info(hcf_object, kernel_name);
-  if(!kernel_info) {
-    return make_error(
-        __hipsycl_here(),
-        error_info{"ze_queue: Could not obtain hcf kernel info for kernel " +
-            global_kernel_name});
-  }
-
   auto code_object_selector = [&](const code_object *candidate) -> bool {
     if ((candidate->managing_backend() != backend_id::level_zero) ||
         (candidate->source_compilation_flow() != compilation_flow::sscp) ||
@@ -604,17 +591,43 @@ result ze_queue::submit_sscp_kernel_from_code_object(
   };
 
   const code_object *obj = kernel_cache::get().get_or_construct_code_object(
-      *kidx, kernel_name, backend_id::level_zero, hcf_object,
-      code_object_selector, code_object_constructor);
+      kernel_id.kernel_index, kernel_name, backend_id::level_zero, hcf_object,
+      configuration_id, code_object_selector, code_object_constructor);
 
   if(!obj) {
     return make_error(__hipsycl_here(),
                       error_info{"ze_queue: Code object construction failed"});
   }
 
+  obj_out = obj;
+  return make_success();
+#else
+  return make_error(
+      __hipsycl_here(),
+      error_info{
+          "ze_queue: SSCP kernel compilation was requested, but hipSYCL was "
+          "not built with Level Zero SSCP support."});
+#endif
+}
+
+result ze_queue::submit_sscp_kernel_from_code_object(
+      const kernel_operation &op, const sscp_kernel_id &kernel_id,
+      const rt::range<3> &num_groups, const rt::range<3> &group_size,
+      unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+      std::size_t num_args,
+      const glue::kernel_configuration &initial_config) {
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+
+  const code_object *obj = nullptr;
+  result err =
+      get_sscp_code_object(kernel_id, local_mem_size, initial_config, obj);
+  if(!err.is_success())
+    return err;
+
   ze_kernel_handle_t kernel;
   result res = static_cast<const ze_executable_object *>(obj)->get_kernel(
-      kernel_name, kernel);
+      kernel_id.kernel_name, kernel);
   
   if(!res.is_success())
     return res;
@@ -627,8 +640,8 @@ result ze_queue::submit_sscp_kernel_from_code_object(
                      << std::endl;
 
 
-  glue::jit::cxx_argument_mapper arg_mapper{*kernel_info, args, arg_sizes,
-                                            num_args};
+  glue::jit::cxx_argument_mapper arg_mapper{*kernel_id.kernel_info, args,
+                                            arg_sizes, num_args};
   if(!arg_mapper.mapping_available()) {
     return make_error(
         __hipsycl_here(),
@@ -641,7 +654,7 @@ result ze_queue::submit_sscp_kernel_from_code_object(
       static_cast<ze_node_event *>(completion_evt.get())->get_event_handle(),
       wait_events, group_size, num_groups, arg_mapper.get_mapped_args(),
       const_cast<std::size_t *>(arg_mapper.get_mapped_arg_sizes()),
-      arg_mapper.get_mapped_num_args(), kernel_info);
+      arg_mapper.get_mapped_num_args(), kernel_id.kernel_info);
 
   if(!submission_err.is_success())
     return submission_err;
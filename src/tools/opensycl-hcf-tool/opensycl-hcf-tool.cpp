@@ -30,13 +30,17 @@
 #include <iostream>
 #include <fstream>
 #include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/common/filesystem.hpp"
 
 void help() {
   std::cout <<
   "Usage: opensycl-hcf-tool <hcf-file> <-x|-r <file>|-p> root [subnode] [subsubnode] ...\n" <<
+  "       opensycl-hcf-tool <hcf-file> <--to-text|--to-binary>\n" <<
   "  -x: Extract binary attachment and print to stdout\n" <<
   "  -r <file>: Replace binary attachment with file content and print to stdout\n" << 
-  "  -p: Print node content" << std::endl;
+  "  -p: Print node content\n" <<
+  "  --to-text: Convert HCF to the text format and print to stdout\n" <<
+  "  --to-binary: Convert HCF to the binary format and print to stdout" << std::endl;
 }
 
 enum class mode {
@@ -73,11 +77,11 @@ void print_node(const hipsycl::common::hcf_container::node* n, int level = 0) {
   for(int i=0; i < level; ++i)
     prefix += ' ';
   
-  for(const auto& kv_pair : n->key_value_pairs) {
+  for(const auto& kv_pair : n->get_key_value_pairs()) {
     std::cout << prefix << kv_pair.first << " = " << kv_pair.second << std::endl;
   }
 
-  for(const auto& subnode : n->subnodes) {
+  for(const auto& subnode : n->get_children()) {
     std::cout << prefix << subnode.node_id << ":" << std::endl;
     print_node(&subnode, level+1);
   }
@@ -88,18 +92,19 @@ bool copy_node(const hipsycl::common::hcf_container::node *source,
                hipsycl::common::hcf_container::node *target,
                AttachmentHandler &&h) {
 
-  for (const auto &kv_pair : source->key_value_pairs) {
+  for (const auto &kv_pair : source->get_key_value_pairs()) {
     target->set(kv_pair.first, kv_pair.second);
   }
 
-  for (auto &subnode : source->subnodes) {
+  for (auto &subnode : source->get_children()) {
     if (!subnode.is_binary_content()) {
       auto* new_subnode = target->add_subnode(subnode.node_id);
 
       if(!new_subnode)
         return false;
 
-      return copy_node(&subnode, new_subnode, h);
+      if(!copy_node(&subnode, new_subnode, h))
+        return false;
     } else {
       if(!h(source, target))
         return false;
@@ -114,19 +119,41 @@ int main(int argc, char** argv) {
     args.push_back(std::string{argv[i]});
   }
 
-  if(args.size() < 3) {
+  if(args.size() < 2) {
     help();
     return -1;
   }
 
   std::string filename = args[0];
 
-  std::string hcf_content;
-  if(!read_file(filename, hcf_content)) {
+  auto hcf_file = hipsycl::common::filesystem::mapped_file::open(filename);
+  if(!hcf_file) {
     std::cout << "Could not read file: " << filename << std::endl;
     return -1;
   }
-  hipsycl::common::hcf_container hcf{hcf_content};
+  // Attachments are referenced directly from the mapped file
+  hipsycl::common::hcf_container hcf{hcf_file->data(), hcf_file->size(),
+                                     hcf_file};
+  const bool is_binary_input = hipsycl::common::hcf_container::is_binary_format(
+      hcf_file->data(), hcf_file->size());
+
+  // Output modified containers in the same format as the input
+  auto serialize = [&](const hipsycl::common::hcf_container &c) {
+    return is_binary_input ? c.serialize_binary() : c.serialize();
+  };
+
+  if(args[1] == "--to-text") {
+    std::cout << hcf.serialize();
+    return 0;
+  } else if(args[1] == "--to-binary") {
+    std::cout << hcf.serialize_binary();
+    return 0;
+  }
+
+  if(args.size() < 3) {
+    help();
+    return -1;
+  }
 
   mode m = mode::print_node_content;
   std::string replacement_filename;
@@ -208,7 +235,7 @@ int main(int argc, char** argv) {
 
     if(!current->has_binary_data_attached()) {
       hcf.attach_binary_content(current, content);
-      std::cout << hcf.serialize();
+      std::cout << serialize(hcf);
     } else {
       hipsycl::common::hcf_container new_container;
 
@@ -235,7 +262,7 @@ int main(int argc, char** argv) {
         return -1;
       }
 
-      std::cout << new_container.serialize();
+      std::cout << serialize(new_container);
     }
   }
 
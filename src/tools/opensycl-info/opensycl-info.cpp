@@ -57,6 +57,12 @@ void list_backends(rt::runtime* rt) {
                 << std::endl;
     }
   }
+
+  for(const auto& info : rt->backends().get_startup_info()) {
+    if(info.is_initialized && !info.creation_failed)
+      std::cout << "Backend '" << info.name << "' initialized in "
+                << info.initialization_time_ns / 1.e6 << " ms" << std::endl;
+  }
 }
 
 template<class T>
@@ -0,0 +1,48 @@
+// RUN: %syclcc %s -o %t --opensycl-targets=omp.library-only -Rpass=hipsycl-barrier-free-kernel-marker -Rpass-missed=hipsycl-barrier-free-kernel-marker 2>&1 | FileCheck %s --check-prefix=REMARK
+// RUN: %t | FileCheck %s
+// RUN: %syclcc %s -o %t --opensycl-targets=omp.library-only -O -Rpass=hipsycl-barrier-free-kernel-marker -Rpass-missed=hipsycl-barrier-free-kernel-marker 2>&1 | FileCheck %s --check-prefix=REMARK
+// RUN: %t | FileCheck %s
+
+// REMARK: remark: nd_range kernel is barrier-free and runs without fibers
+// REMARK-NOT: may reach a barrier
+
+#include <iostream>
+
+#include <CL/sycl.hpp>
+
+int main()
+{
+  constexpr size_t local_size = 256;
+  constexpr size_t global_size = 1024;
+
+  cl::sycl::queue queue;
+  std::vector<int> host_buf;
+  for(size_t i = 0; i < global_size; ++i)
+  {
+    host_buf.push_back(static_cast<int>(i));
+  }
+
+  {
+    cl::sycl::buffer<int, 1> buf{host_buf.data(), host_buf.size()};
+
+    queue.submit([&](cl::sycl::handler &cgh) {
+      using namespace cl::sycl::access;
+      auto acc = buf.get_access<mode::read_write>(cgh);
+
+      cgh.parallel_for<class barrier_free_kernel>(
+        cl::sycl::nd_range<1>{global_size, local_size},
+        [=](cl::sycl::nd_item<1> item) noexcept {
+          acc[item.get_global_id()] += static_cast<int>(item.get_local_id(0));
+        });
+    });
+  }
+  // The kernel does not contain barriers, so it must not use fibers.
+  for(size_t i = 0; i < global_size / local_size; ++i)
+  {
+    // CHECK: 2
+    // CHECK: 258
+    // CHECK: 514
+    // CHECK: 770
+    std::cout << host_buf[i * local_size + 1] << "\n";
+  }
+}
@@ -0,0 +1,55 @@
+// RUN: %syclcc %s -o %t --opensycl-targets=omp.library-only -Rpass=hipsycl-barrier-free-kernel-marker -Rpass-missed=hipsycl-barrier-free-kernel-marker 2>&1 | FileCheck %s --check-prefix=REMARK
+// RUN: %t | FileCheck %s
+// RUN: %syclcc %s -o %t --opensycl-targets=omp.library-only -O -Rpass=hipsycl-barrier-free-kernel-marker -Rpass-missed=hipsycl-barrier-free-kernel-marker 2>&1 | FileCheck %s --check-prefix=REMARK
+// RUN: %t | FileCheck %s
+
+// REMARK: remark: nd_range kernel may reach a barrier and runs on fibers
+// REMARK-NOT: is barrier-free
+
+#include <iostream>
+
+#include <CL/sycl.hpp>
+
+int main()
+{
+  constexpr size_t local_size = 256;
+  constexpr size_t global_size = 1024;
+
+  cl::sycl::queue queue;
+  std::vector<int> host_buf;
+  for(size_t i = 0; i < global_size; ++i)
+  {
+    host_buf.push_back(static_cast<int>(i));
+  }
+
+  {
+    cl::sycl::buffer<int, 1> buf{host_buf.data(), host_buf.size()};
+
+    queue.submit([&](cl::sycl::handler &cgh) {
+      using namespace cl::sycl::access;
+      auto acc = buf.get_access<mode::read_write>(cgh);
+      auto scratch = cl::sycl::accessor<int, 1, mode::read_write, target::local>{local_size, cgh};
+
+      cgh.parallel_for<class barrier_kernel>(
+        cl::sycl::nd_range<1>{global_size, local_size},
+        [=](cl::sycl::nd_item<1> item) noexcept {
+          const auto lid = item.get_local_id(0);
+          const auto group_size = item.get_local_range(0);
+
+          scratch[lid] = acc[item.get_global_id()];
+          cl::sycl::group_barrier(item.get_group());
+          // Requires the value written by another work item
+          acc[item.get_global_id()] = scratch[group_size - lid - 1];
+        });
+    });
+  }
+  // The kernel contains a barrier, so it must use fibers.
+  for(size_t i = 0; i < global_size / local_size; ++i)
+  {
+    // CHECK: 255
+    // CHECK: 511
+    // CHECK: 767
+    // CHECK: 1023
+    std::cout << host_buf[i * local_size] << "\n";
+  }
+}
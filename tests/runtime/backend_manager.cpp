@@ -0,0 +1,115 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <hipSYCL/runtime/backend.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+// Both fake plugins sleep for this long in their constructor,
+// see HIPSYCL_FAKE_BACKEND_LATENCY_MS in tests/CMakeLists.txt
+constexpr std::uint64_t fake_latency_ms = 300;
+
+template<class F>
+std::uint64_t measure_ms(F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+const rt::backend_startup_info *
+find_startup_info(const std::vector<rt::backend_startup_info> &infos,
+                  const std::string &name) {
+  for(const auto& info : infos)
+    if(info.name == name)
+      return &info;
+  return nullptr;
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(backend_manager, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(lazy_concurrent_initialization) {
+  rt::backend_manager manager{
+      std::vector<std::string>{HIPSYCL_FAKE_BACKEND_PLUGIN_DIR}};
+
+  auto infos = manager.get_startup_info();
+  BOOST_REQUIRE(find_startup_info(infos, "omp"));
+  BOOST_REQUIRE(find_startup_info(infos, "fake_slow_a"));
+  BOOST_REQUIRE(find_startup_info(infos, "fake_slow_b"));
+  for(const auto& info : infos)
+    BOOST_CHECK(!info.is_initialized);
+
+  // Requesting the CPU backend must not wait for the slow plugins
+  std::uint64_t omp_time = measure_ms([&]() {
+    BOOST_CHECK(manager.get(rt::backend_id::omp) != nullptr);
+  });
+  BOOST_CHECK_LT(omp_time, fake_latency_ms);
+
+  infos = manager.get_startup_info();
+  BOOST_CHECK(find_startup_info(infos, "omp")->is_initialized);
+  BOOST_CHECK(!find_startup_info(infos, "fake_slow_a")->is_initialized);
+  BOOST_CHECK(!find_startup_info(infos, "fake_slow_b")->is_initialized);
+
+  // The two remaining plugins are initialized concurrently
+  std::vector<std::string> names;
+  std::uint64_t all_time = measure_ms([&]() {
+    manager.for_each_backend(
+        [&](rt::backend *b) { names.push_back(b->get_name()); });
+  });
+  BOOST_CHECK_EQUAL(names.size(), infos.size());
+  BOOST_CHECK(all_time >= fake_latency_ms);
+  // Initializing them one after another would take at least
+  // 2 * fake_latency_ms. The remaining margin absorbs scheduling noise.
+  BOOST_CHECK_LT(all_time, 1.8 * fake_latency_ms);
+
+  infos = manager.get_startup_info();
+  for(const auto& info : infos) {
+    BOOST_CHECK(info.is_initialized);
+    BOOST_CHECK(!info.creation_failed);
+  }
+  BOOST_CHECK(find_startup_info(infos, "fake_slow_a")->initialization_time_ns >=
+              fake_latency_ms * 1000000);
+
+  // Already initialized backends are not created again
+  manager.for_each_backend([](rt::backend *) {});
+  BOOST_CHECK(find_startup_info(manager.get_startup_info(), "fake_slow_a")
+                  ->initialization_time_ns ==
+              find_startup_info(infos, "fake_slow_a")->initialization_time_ns);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
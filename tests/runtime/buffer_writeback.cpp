@@ -0,0 +1,107 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <vector>
+#include <sycl/sycl.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(buffer_writeback, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(uninitialized_buffer_skips_writeback) {
+  std::vector<int> out(64, -1);
+  {
+    sycl::buffer<int> buff{sycl::range{64}};
+    buff.set_final_data(out.data());
+  }
+  // Indeterminate content must not be copied to the final data location
+  for(int x : out)
+    BOOST_CHECK(x == -1);
+}
+
+BOOST_AUTO_TEST_CASE(kernel_results_are_written_back) {
+  sycl::queue q;
+  std::vector<int> out(64, -1);
+  {
+    sycl::buffer<int> buff{sycl::range{64}};
+    buff.set_final_data(out.data());
+    q.submit([&](sycl::handler &cgh) {
+      sycl::accessor acc{buff, cgh, sycl::write_only, sycl::no_init};
+      cgh.parallel_for(sycl::range{64},
+                       [=](sycl::id<1> idx) { acc[idx] = idx[0]; });
+    });
+  }
+  for(int i = 0; i < 64; ++i)
+    BOOST_CHECK(out[i] == i);
+}
+
+BOOST_AUTO_TEST_CASE(host_only_history) {
+  std::vector<int> in(64, 1);
+  std::vector<int> out(64, -1);
+  {
+    sycl::buffer<int> buff{in.data(), sycl::range{64}};
+    buff.set_final_data(out.data());
+    sycl::host_accessor acc{buff};
+    acc[3] = 42;
+  }
+  for(int i = 0; i < 64; ++i)
+    BOOST_CHECK(out[i] == (i == 3 ? 42 : 1));
+}
+
+BOOST_AUTO_TEST_CASE(mixed_history) {
+  sycl::queue q;
+  std::vector<int> in(64, 0);
+  std::vector<int> out(64, -1);
+  {
+    sycl::buffer<int> buff{in.data(), sycl::range{64}};
+    buff.set_final_data(out.data());
+    q.submit([&](sycl::handler &cgh) {
+      sycl::accessor acc{buff, cgh, sycl::read_write};
+      cgh.parallel_for(sycl::range{64},
+                       [=](sycl::id<1> idx) { acc[idx] += 1; });
+    });
+    {
+      sycl::host_accessor acc{buff};
+      acc[0] = 100;
+    }
+    // Only touch part of the buffer last
+    q.submit([&](sycl::handler &cgh) {
+      sycl::accessor acc{buff, cgh, sycl::range{32}, sycl::id{32},
+                         sycl::read_write};
+      cgh.parallel_for(sycl::range{32},
+                       [=](sycl::id<1> idx) { acc[idx[0] + 32] += 10; });
+    });
+  }
+  BOOST_CHECK(out[0] == 100);
+  for(int i = 1; i < 32; ++i)
+    BOOST_CHECK(out[i] == 1);
+  for(int i = 32; i < 64; ++i)
+    BOOST_CHECK(out[i] == 11);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <hipSYCL/runtime/application.hpp>
+#include <hipSYCL/runtime/dag_node.hpp>
+#include <hipSYCL/runtime/dag_submitted_ops.hpp>
+#include <hipSYCL/runtime/event.hpp>
+#include <hipSYCL/runtime/generic/multi_event.hpp>
+#include <hipSYCL/runtime/operations.hpp>
+#include <hipSYCL/runtime/signal_channel.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+// Event that completes when the test signals it, similar to
+// the events of the OpenMP backend
+class manual_event : public rt::dag_node_event {
+public:
+  bool is_complete() const override { return _channel.has_signalled(); }
+  void wait() override { _channel.wait(); }
+  bool notify_on_completion(std::function<void()> callback) override {
+    _channel.on_signal(std::move(callback));
+    return true;
+  }
+
+  void signal() { _channel.signal(); }
+private:
+  mutable rt::signal_channel _channel;
+};
+
+// Event that can only be polled, like events of backends that
+// do not support host callbacks
+class polling_event : public rt::dag_node_event {
+public:
+  bool is_complete() const override { return true; }
+  void wait() override {}
+};
+
+rt::dag_node_ptr make_submitted_node(rt::runtime *rt,
+                                     std::shared_ptr<rt::dag_node_event> evt) {
+  rt::requirements_list reqs{rt};
+  auto op = rt::make_operation<rt::kernel_operation>(
+      "test_kernel",
+      std::vector<std::unique_ptr<rt::backend_kernel_launcher>>{}, reqs);
+  auto node = std::make_shared<rt::dag_node>(rt::execution_hints{},
+                                             reqs.get(), std::move(op), rt);
+  node->mark_submitted(std::move(evt));
+  return node;
+}
+
+template<class Predicate>
+bool eventually(Predicate p) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  while(!p()) {
+    if(std::chrono::steady_clock::now() > deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  return true;
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(completion_tracking, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(out_of_order_completion) {
+  rt::runtime_keep_alive_token rt;
+  rt::dag_submitted_ops ops;
+
+  auto long_evt = std::make_shared<manual_event>();
+  auto short_evt = std::make_shared<manual_event>();
+  rt::dag_node_ptr long_node = make_submitted_node(rt.get(), long_evt);
+  rt::dag_node_ptr short_node = make_submitted_node(rt.get(), short_evt);
+
+  ops.update_with_submission(long_node);
+  ops.update_with_submission(short_node);
+  ops.async_wait_and_unregister({long_node, short_node});
+
+  // The node that finishes first must not wait for the long-running one
+  short_evt->signal();
+  BOOST_CHECK(short_node->is_known_complete());
+  BOOST_CHECK(eventually([&]() { return !ops.contains_node(short_node); }));
+  BOOST_CHECK(!long_node->is_known_complete());
+  BOOST_CHECK(ops.contains_node(long_node));
+
+  long_evt->signal();
+  BOOST_CHECK(long_node->is_known_complete());
+  BOOST_CHECK(eventually([&]() { return !ops.contains_node(long_node); }));
+}
+
+BOOST_AUTO_TEST_CASE(multi_event_notification) {
+  auto a = std::make_shared<manual_event>();
+  auto b = std::make_shared<manual_event>();
+  rt::dag_multi_node_event multi_evt{{a, b}};
+
+  int num_invocations = 0;
+  BOOST_CHECK(multi_evt.notify_on_completion([&]() { ++num_invocations; }));
+  a->signal();
+  BOOST_CHECK_EQUAL(num_invocations, 0);
+  b->signal();
+  BOOST_CHECK_EQUAL(num_invocations, 1);
+
+  // Already completed events invoke the callback immediately
+  BOOST_CHECK(multi_evt.notify_on_completion([&]() { ++num_invocations; }));
+  BOOST_CHECK_EQUAL(num_invocations, 2);
+
+  // Events without callback support make the whole multi event unsupported
+  rt::dag_multi_node_event unsupported{
+      {std::make_shared<manual_event>(), std::make_shared<polling_event>()}};
+  BOOST_CHECK(!unsupported.notify_on_completion([&]() { ++num_invocations; }));
+  BOOST_CHECK_EQUAL(num_invocations, 2);
+}
+
+BOOST_AUTO_TEST_CASE(polling_fallback) {
+  rt::runtime_keep_alive_token rt;
+  rt::dag_submitted_ops ops;
+
+  rt::dag_node_ptr node =
+      make_submitted_node(rt.get(), std::make_shared<polling_event>());
+  ops.update_with_submission(node);
+  ops.async_wait_and_unregister({node});
+
+  BOOST_CHECK(eventually([&]() { return !ops.contains_node(node); }));
+  BOOST_CHECK(node->is_known_complete());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -29,12 +29,57 @@
 #include "hipSYCL/runtime/application.hpp"
 #include "runtime_test_suite.hpp"
 
+#include <chrono>
+#include <thread>
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <hipSYCL/runtime/dag_builder.hpp>
+#include <hipSYCL/runtime/data.hpp>
 
 using namespace hipsycl;
 
+namespace {
+
+rt::dag_node_ptr
+add_read_write_kernel(rt::runtime *rt, rt::dag_builder &builder,
+                      const std::shared_ptr<rt::buffer_data_region> &region) {
+  auto reqs = rt::requirements_list{rt};
+  reqs.add_requirement(std::make_unique<rt::buffer_memory_requirement>(
+      region, rt::id<3>{}, region->get_num_elements(),
+      sycl::access::mode::read_write, sycl::access::target::device));
+  auto kernel_op = rt::make_operation<rt::kernel_operation>(
+      "test_kernel",
+      std::vector<std::unique_ptr<rt::backend_kernel_launcher>>{}, reqs);
+  return builder.add_kernel(std::move(kernel_op), reqs);
+}
+
+std::shared_ptr<rt::buffer_data_region> make_region() {
+  return std::make_shared<rt::buffer_data_region>(
+      rt::range<3>{1, 1, 1024}, sizeof(int), rt::range<3>{1, 1, 1024});
+}
+
+void cancel_all(const rt::dag &d) {
+  d.for_each_node([](rt::dag_node_ptr node) { node->cancel(); });
+}
+
+bool is_reachable(const rt::dag_node_ptr &from, const rt::dag_node_ptr &to,
+                  std::unordered_set<rt::dag_node *> &visited) {
+  if(from == to)
+    return true;
+  if(!visited.insert(from.get()).second)
+    return false;
+  for(const auto &weak_req : from->get_requirements()) {
+    if(auto req = weak_req.lock())
+      if(is_reachable(req, to, visited))
+        return true;
+  }
+  return false;
+}
+
+}
+
 BOOST_FIXTURE_TEST_SUITE(dag_builder, reset_device_fixture)
 BOOST_AUTO_TEST_CASE(default_hints) {
   rt::runtime_keep_alive_token rt;
@@ -65,4 +110,191 @@ BOOST_AUTO_TEST_CASE(default_hints) {
   node->cancel();
 }
 
+BOOST_AUTO_TEST_CASE(redundant_edges_are_pruned) {
+  rt::runtime_keep_alive_token rt;
+  rt::dag_builder builder{rt.get()};
+
+  constexpr std::size_t num_kernels = 32;
+  constexpr std::size_t shift = 64;
+  constexpr std::size_t access_size = 512;
+  auto region = std::make_shared<rt::buffer_data_region>(
+      rt::range<3>{1, 1, num_kernels * shift + access_size}, sizeof(int),
+      rt::range<3>{1, 1, shift});
+
+  std::vector<rt::dag_node_ptr> kernels;
+  for(std::size_t i = 0; i < num_kernels; ++i) {
+    auto reqs = rt::requirements_list{rt.get()};
+    // The smaller requirement is submitted first and is entirely covered
+    // by the larger read-write access.
+    reqs.add_requirement(std::make_unique<rt::buffer_memory_requirement>(
+        region, rt::id<1>{i * shift}, rt::range<1>{2 * shift},
+        sycl::access::mode::read, sycl::access::target::device));
+    reqs.add_requirement(std::make_unique<rt::buffer_memory_requirement>(
+        region, rt::id<1>{i * shift}, rt::range<1>{access_size},
+        sycl::access::mode::read_write, sycl::access::target::device));
+    // Explicit dependency that is already implied by the data dependencies
+    if(!kernels.empty())
+      reqs.add_node_requirement(kernels.back());
+
+    auto kernel_op = rt::make_operation<rt::kernel_operation>(
+        "test_kernel",
+        std::vector<std::unique_ptr<rt::backend_kernel_launcher>>{}, reqs);
+    kernels.push_back(builder.add_kernel(std::move(kernel_op), reqs));
+  }
+
+  std::unordered_set<rt::dag_node *> counted;
+  std::size_t num_edges = 0;
+  for(const auto &kernel : kernels) {
+    // Only the two requirements, the explicit dependency is implied
+    BOOST_CHECK(kernel->get_requirements().size() == 2);
+    num_edges += kernel->get_requirements().size();
+
+    for(const auto &weak_req : kernel->get_requirements()) {
+      auto req = weak_req.lock();
+      BOOST_REQUIRE(req);
+      if(counted.insert(req.get()).second)
+        num_edges += req->get_requirements().size();
+
+      auto *mem_req =
+          rt::cast<rt::buffer_memory_requirement>(req->get_operation());
+      // The smaller requirement only needs to wait for the larger one
+      if(mem_req->get_access_mode() == sycl::access::mode::read)
+        BOOST_CHECK(req->get_requirements().size() == 1);
+    }
+  }
+  BOOST_TEST_MESSAGE("dag_builder: " << num_edges << " edges for "
+                                     << num_kernels << " kernels");
+  // Per kernel: two requirement edges, one edge from the smaller to the
+  // larger requirement and one edge to the previous kernel, which implies
+  // the dependencies on all older kernels.
+  BOOST_CHECK_LE(num_edges, 4 * num_kernels);
+
+  // Pruning must not lose any ordering between overlapping accesses
+  for(std::size_t i = 0; i < num_kernels; ++i) {
+    for(std::size_t j = 0; j < i; ++j) {
+      if((i - j) * shift < access_size) {
+        std::unordered_set<rt::dag_node *> visited;
+        BOOST_CHECK(is_reachable(kernels[i], kernels[j], visited));
+      }
+    }
+  }
+
+  for(const auto &kernel : kernels) {
+    for(const auto &weak_req : kernel->get_requirements())
+      if(auto req = weak_req.lock())
+        req->cancel();
+    kernel->cancel();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(dag_keeps_requirements_alive) {
+  rt::runtime_keep_alive_token rt;
+  rt::dag_builder builder{rt.get()};
+
+  // The requirements list is gone once the node has been added
+  rt::dag_node_ptr kernel = add_read_write_kernel(rt.get(), builder,
+                                                  make_region());
+  BOOST_CHECK(builder.get_current_dag_size() == 2);
+
+  rt::dag d = builder.finish_and_reset();
+  BOOST_CHECK(d.num_nodes() == 2);
+  BOOST_REQUIRE(d.get_memory_requirements().size() == 1);
+  BOOST_CHECK(kernel->get_requirements().size() == 1);
+  BOOST_CHECK(kernel->get_requirements()[0].lock() ==
+              d.get_memory_requirements()[0]);
+  cancel_all(d);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_builds_preserve_order) {
+  rt::runtime_keep_alive_token rt;
+  rt::dag_builder builder{rt.get()};
+
+  constexpr int num_threads = 8;
+  constexpr int kernels_per_thread = 100;
+  auto shared_region = make_region();
+
+  std::vector<std::thread> threads;
+  for(int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      auto own_region = make_region();
+      for(int i = 0; i < kernels_per_thread; ++i) {
+        add_read_write_kernel(rt.get(), builder,
+                              (i % 2 == 0) ? shared_region : own_region);
+      }
+    });
+  }
+  for(auto &t : threads)
+    t.join();
+
+  BOOST_CHECK(builder.get_current_dag_size() ==
+              2 * num_threads * kernels_per_thread);
+  rt::dag d = builder.finish_and_reset();
+  BOOST_CHECK(builder.get_current_dag_size() == 0);
+  BOOST_CHECK(d.get_command_groups().size() ==
+              num_threads * kernels_per_thread);
+
+  // Every operation that a command group depends on must come
+  // earlier in the DAG, otherwise the scheduler would see
+  // unsubmitted dependencies.
+  std::unordered_map<rt::dag_node *, std::size_t> position;
+  const auto &command_groups = d.get_command_groups();
+  for(std::size_t i = 0; i < command_groups.size(); ++i)
+    position[command_groups[i].get()] = i;
+
+  for(std::size_t i = 0; i < command_groups.size(); ++i) {
+    for(const auto &weak_req : command_groups[i]->get_requirements()) {
+      auto req = weak_req.lock();
+      BOOST_REQUIRE(req);
+      for(const auto &weak_dep : req->get_requirements()) {
+        auto dep = weak_dep.lock();
+        BOOST_REQUIRE(dep);
+        BOOST_REQUIRE(position.count(dep.get()));
+        BOOST_CHECK_LT(position[dep.get()], i);
+      }
+    }
+  }
+  cancel_all(d);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_submission_benchmark) {
+  rt::runtime_keep_alive_token rt;
+  rt::dag_builder builder{rt.get()};
+
+  constexpr std::size_t num_nodes = 1 << 14;
+  double single_thread_rate = 0.0;
+  for(std::size_t num_threads = 1; num_threads <= 64; num_threads *= 2) {
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&]() {
+        // Disjoint buffers, so that threads never wait on each other
+        auto region = make_region();
+        for(std::size_t i = 0; i < num_nodes / num_threads; ++i)
+          add_read_write_kernel(rt.get(), builder, region);
+      });
+    }
+    for(auto &t : threads)
+      t.join();
+    auto stop = std::chrono::steady_clock::now();
+
+    rt::dag d = builder.finish_and_reset();
+    BOOST_CHECK(d.get_command_groups().size() == num_nodes);
+    cancel_all(d);
+
+    double rate =
+        num_nodes / std::chrono::duration<double>(stop - start).count();
+    if(num_threads == 1)
+      single_thread_rate = rate;
+    BOOST_TEST_MESSAGE("dag_builder: " << num_threads << " threads: " << rate
+                                       << " nodes/s ("
+                                       << rate / single_thread_rate
+                                       << "x single thread, "
+                                       << std::thread::hardware_concurrency()
+                                       << " hardware threads)");
+    // Threads on disjoint buffers must not slow each other down
+    // beyond the cost of oversubscription.
+    BOOST_CHECK_GT(rate, 0.2 * single_thread_rate);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sycl/sycl.hpp>
+#include <hipSYCL/runtime/dag_manager.hpp>
+
+namespace {
+
+void set_flush_policy(const char* policy) {
+  if(policy)
+    setenv("HIPSYCL_RT_DAG_FLUSH_POLICY", policy, 1);
+  else
+    unsetenv("HIPSYCL_RT_DAG_FLUSH_POLICY");
+  hipsycl::rt::application::get_settings() = hipsycl::rt::settings{};
+}
+
+double get_percentile(std::vector<double> v, double p) {
+  std::sort(v.begin(), v.end());
+  return v[static_cast<std::size_t>(p * (v.size() - 1))];
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(dag_flush_policy, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(default_policy_follows_scheduler) {
+  namespace rt = hipsycl::rt;
+  set_flush_policy(nullptr);
+
+  setenv("HIPSYCL_RT_SCHEDULER", "direct", 1);
+  BOOST_CHECK(rt::settings{}.get<rt::setting::dag_flush_policy>() ==
+              rt::dag_flush_policy::eager);
+  setenv("HIPSYCL_RT_SCHEDULER", "unbound", 1);
+  BOOST_CHECK(rt::settings{}.get<rt::setting::dag_flush_policy>() ==
+              rt::dag_flush_policy::batched);
+  unsetenv("HIPSYCL_RT_SCHEDULER");
+  BOOST_CHECK(rt::settings{}.get<rt::setting::dag_flush_policy>() ==
+              rt::dag_flush_policy::batched);
+}
+
+BOOST_AUTO_TEST_CASE(adaptive_flush_decisions) {
+  namespace rt = hipsycl::rt;
+  using std::chrono::microseconds;
+  const std::size_t max_cached = 100;
+  const auto adaptive = rt::dag_flush_policy::adaptive;
+  const auto eager = rt::dag_flush_policy::eager;
+  const auto batched = rt::dag_flush_policy::batched;
+
+  // Idle executors get work right away, no matter how little is cached
+  BOOST_CHECK(rt::is_flush_due(adaptive, 1, max_cached, true, microseconds{1}));
+  // Busy executors with closely spaced submissions: Hold nodes back
+  // until the batch exceeds max_cached_nodes
+  for(std::size_t num_cached = 1; num_cached <= max_cached; ++num_cached)
+    BOOST_CHECK(!rt::is_flush_due(adaptive, num_cached, max_cached, false,
+                                  microseconds{1}));
+  BOOST_CHECK(rt::is_flush_due(adaptive, max_cached + 1, max_cached, false,
+                               microseconds{1}));
+  // Sparse submissions are flushed even if executors are busy
+  BOOST_CHECK(
+      rt::is_flush_due(adaptive, 1, max_cached, false, microseconds{1000}));
+
+  // The other policies do not depend on idleness or submission timing
+  for(bool idle : {true, false}) {
+    for(auto gap : {microseconds{1}, microseconds{1000}}) {
+      BOOST_CHECK(rt::is_flush_due(eager, 1, max_cached, idle, gap));
+      BOOST_CHECK(!rt::is_flush_due(batched, max_cached, max_cached, idle, gap));
+      BOOST_CHECK(
+          rt::is_flush_due(batched, max_cached + 1, max_cached, idle, gap));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(policy_benchmark) {
+  constexpr int num_round_trips = 1000;
+  constexpr int num_tiny_kernels = 100000;
+
+  for(const char* policy : {"eager", "batched", "adaptive"}) {
+    set_flush_policy(policy);
+    sycl::queue q;
+    // Warm-up
+    q.single_task([](){}).wait();
+
+    std::vector<double> latencies;
+    for(int i = 0; i < num_round_trips; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      q.single_task([](){}).wait();
+      auto stop = std::chrono::steady_clock::now();
+      latencies.push_back(
+          std::chrono::duration<double, std::micro>(stop - start).count());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < num_tiny_kernels; ++i)
+      q.single_task([](){});
+    q.wait();
+    auto stop = std::chrono::steady_clock::now();
+    double throughput =
+        num_tiny_kernels / std::chrono::duration<double>(stop - start).count();
+
+    double p50 = get_percentile(latencies, 0.5);
+    BOOST_TEST_MESSAGE("flush policy " << policy << ": round trip p50 = "
+                       << p50 << " us, p99 = "
+                       << get_percentile(latencies, 0.99)
+                       << " us; throughput = " << throughput
+                       << " kernels/s");
+  }
+  set_flush_policy(nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
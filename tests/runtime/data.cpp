@@ -31,6 +31,7 @@
 #include <boost/test/tools/old/interface.hpp>
 #include <vector>
 #include <memory>
+#include <algorithm>
 #include <hipSYCL/runtime/data.hpp>
 #include <hipSYCL/runtime/util.hpp>
 
@@ -96,4 +97,108 @@ BOOST_AUTO_TEST_CASE(page_table) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(page_table_refinement) {
+  // 3x2x3 pages refined by 2x1x4. The last new page in x and z only
+  // partially covers its old page.
+  rt::range_store pt{rt::range<3>{3, 2, 3}};
+  pt.add(rt::range_store::rect{rt::id<3>{0, 1, 1}, rt::range<3>{1, 1, 1}});
+  pt.add(rt::range_store::rect{rt::id<3>{2, 0, 2}, rt::range<3>{1, 2, 1}});
+
+  const rt::range<3> factor{2, 1, 4};
+  const rt::range<3> new_size{5, 2, 10};
+  rt::range_store refined = pt.refine(factor, new_size);
+  BOOST_REQUIRE(refined.get_size() == new_size);
+
+  for(std::size_t x = 0; x < new_size[0]; ++x)
+    for(std::size_t y = 0; y < new_size[1]; ++y)
+      for(std::size_t z = 0; z < new_size[2]; ++z) {
+        rt::range_store::rect old_page{
+            rt::id<3>{x / factor[0], y / factor[1], z / factor[2]},
+            rt::range<3>{1, 1, 1}};
+        rt::range_store::rect new_page{rt::id<3>{x, y, z},
+                                       rt::range<3>{1, 1, 1}};
+        BOOST_CHECK(pt.entire_range_filled(old_page) ==
+                    refined.entire_range_filled(new_page));
+      }
+}
+
+BOOST_AUTO_TEST_CASE(valid_sources) {
+  rt::device_id host{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                            rt::api_platform::omp},
+                     0};
+  rt::device_id dev0{rt::backend_descriptor{rt::hardware_platform::cuda,
+                                            rt::api_platform::cuda},
+                     0};
+  rt::device_id dev1{rt::backend_descriptor{rt::hardware_platform::cuda,
+                                            rt::api_platform::cuda},
+                     1};
+  // Allocations are not owned by the data region and never accessed
+  int host_mem, dev0_mem, dev1_mem;
+
+  auto make_region = [&]() {
+    auto region = std::make_unique<rt::buffer_data_region>(
+        rt::range<3>{1, 1, 64}, sizeof(int), rt::range<3>{1, 1, 16});
+    region->add_nonempty_allocation(host, &host_mem, nullptr);
+    region->add_empty_allocation(dev0, &dev0_mem, nullptr, false);
+    region->add_empty_allocation(dev1, &dev1_mem, nullptr, false);
+    return region;
+  };
+  auto find_source = [](const auto &sources, rt::device_id dev) {
+    return std::find_if(sources.begin(), sources.end(),
+                        [&](const auto &s) { return s.first == dev; });
+  };
+
+  std::vector<std::pair<rt::device_id, rt::range_store::rect>> sources;
+  {
+    // Data valid everywhere: A single copy from the preferred device
+    auto region = make_region();
+    region->mark_range_valid(dev0, rt::id<3>{}, rt::range<3>{1, 1, 64});
+    region->get_valid_sources(host, rt::id<3>{}, rt::range<3>{1, 1, 64},
+                              sources);
+    BOOST_REQUIRE(sources.size() == 1);
+    BOOST_CHECK(sources[0].first == host);
+    BOOST_CHECK(sources[0].second.second == (rt::range<3>{1, 1, 64}));
+  }
+  {
+    // Data spread across two devices: One copy from each device, and
+    // none from the outdated host allocation.
+    auto region = make_region();
+    region->mark_range_current(dev0, rt::id<3>{}, rt::range<3>{1, 1, 32});
+    region->mark_range_current(dev1, rt::id<3>{0, 0, 32},
+                               rt::range<3>{1, 1, 32});
+    region->get_valid_sources(host, rt::id<3>{}, rt::range<3>{1, 1, 64},
+                              sources);
+    BOOST_REQUIRE(sources.size() == 2);
+    BOOST_CHECK(find_source(sources, host) == sources.end());
+
+    auto from_dev0 = find_source(sources, dev0);
+    BOOST_REQUIRE(from_dev0 != sources.end());
+    BOOST_CHECK(from_dev0->second.first == (rt::id<3>{0, 0, 0}));
+    BOOST_CHECK(from_dev0->second.second == (rt::range<3>{1, 1, 32}));
+
+    auto from_dev1 = find_source(sources, dev1);
+    BOOST_REQUIRE(from_dev1 != sources.end());
+    BOOST_CHECK(from_dev1->second.first == (rt::id<3>{0, 0, 32}));
+    BOOST_CHECK(from_dev1->second.second == (rt::range<3>{1, 1, 32}));
+  }
+  {
+    // Partially current device: The host provides the remaining pages
+    auto region = make_region();
+    region->mark_range_current(dev1, rt::id<3>{0, 0, 16},
+                               rt::range<3>{1, 1, 16});
+    region->get_valid_sources(host, rt::id<3>{}, rt::range<3>{1, 1, 64},
+                              sources);
+    std::size_t num_elements = 0;
+    for(const auto& s : sources)
+      num_elements += s.second.second.size();
+    BOOST_CHECK(num_elements == 64);
+
+    auto from_dev1 = find_source(sources, dev1);
+    BOOST_REQUIRE(from_dev1 != sources.end());
+    BOOST_CHECK(from_dev1->second.first == (rt::id<3>{0, 0, 16}));
+    BOOST_CHECK(from_dev1->second.second == (rt::range<3>{1, 1, 16}));
+    BOOST_CHECK(find_source(sources, dev0) == sources.end());
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
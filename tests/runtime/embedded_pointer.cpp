@@ -0,0 +1,271 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <hipSYCL/glue/embedded_pointer.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+template<int NumPointers, std::size_t PayloadSize>
+struct test_blob {
+  glue::embedded_pointer<int> ptrs[NumPointers];
+  std::array<char, PayloadSize> payload{};
+};
+
+// Roughly 4 KiB of captured state with 16 accessors spread across it
+struct large_kernel {
+  std::array<char, 440> padding0{};
+  glue::embedded_pointer<int> p0, p1, p2, p3;
+  std::array<char, 1000> padding1{};
+  glue::embedded_pointer<int> p4, p5, p6, p7;
+  std::array<char, 1000> padding2{};
+  glue::embedded_pointer<int> p8, p9, p10, p11;
+  std::array<char, 1000> padding3{};
+  glue::embedded_pointer<int> p12, p13, p14, p15;
+  std::array<char, 400> padding4{};
+
+  glue::embedded_pointer<int>* get(int i) {
+    glue::embedded_pointer<int> *ptrs[] = {&p0,  &p1,  &p2,  &p3, &p4,  &p5,
+                                           &p6,  &p7,  &p8,  &p9, &p10, &p11,
+                                           &p12, &p13, &p14, &p15};
+    return ptrs[i];
+  }
+};
+
+template<class Kernel>
+double patch_time_ns(int num_launches, int num_pointers) {
+  int data[16];
+  double total = 0;
+  for(int launch = 0; launch < num_launches; ++launch) {
+    // Every launch uses a freshly constructed kernel with new ids,
+    // just like new accessors are created for every submission.
+    Kernel k;
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < num_pointers; ++i)
+      glue::kernel_blob::initialize_embedded_pointer(
+          k, k.get(i)->get_uid(), &data[i]);
+    total += std::chrono::duration<double, std::nano>(
+                 std::chrono::steady_clock::now() - start)
+                 .count();
+    for(int i = 0; i < num_pointers; ++i)
+      BOOST_REQUIRE(k.get(i)->get() == &data[i]);
+  }
+  return total / num_launches;
+}
+
+// The previous id generation scheme, as reference for the benchmark below
+glue::unique_id make_legacy_unique_id() {
+  thread_local std::random_device rd;
+  thread_local std::mt19937 gen{rd()};
+  thread_local std::uniform_int_distribution<uint64_t> distribution{0};
+
+  uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::high_resolution_clock::now().time_since_epoch())
+                    .count();
+  uint64_t random_number = distribution(gen);
+
+  glue::unique_id result{0};
+  char *ns_bytes = reinterpret_cast<char *>(&ns);
+  char *rnd_bytes = reinterpret_cast<char *>(&random_number);
+  char *id_bytes = reinterpret_cast<char *>(&result.id[0]);
+  for (std::size_t i = 0; i < sizeof(uint64_t); ++i) {
+    id_bytes[2 * i] = ns_bytes[i];
+    id_bytes[2 * i + 1] = rnd_bytes[i];
+  }
+  return result;
+}
+
+template<class F>
+double ids_per_second(F&& make_id) {
+  constexpr int num_ids = 1000000;
+  uint64_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < num_ids; ++i)
+    checksum += make_id().id[1];
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  // Prevent the loop from being optimized away
+  BOOST_CHECK(checksum != 1);
+  return num_ids / seconds;
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(embedded_pointer, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(unique_ids_across_threads) {
+  constexpr int num_threads = 8;
+  constexpr int ids_per_thread = 5000;
+
+  std::vector<std::vector<glue::unique_id>> ids(num_threads);
+  std::vector<std::thread> threads;
+  for(int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&ids, t]() {
+      for(int i = 0; i < ids_per_thread; ++i)
+        ids[t].push_back(glue::unique_id{});
+    });
+  }
+  for(auto& t : threads)
+    t.join();
+
+  std::vector<std::pair<uint64_t, uint64_t>> all_ids;
+  for(const auto& thread_ids : ids)
+    for(const auto& id : thread_ids) {
+      // Ids must never look like unbound ids
+      BOOST_CHECK(id.id[0] != 0 || id.id[1] != 0);
+      all_ids.emplace_back(id.id[0], id.id[1]);
+    }
+  std::sort(all_ids.begin(), all_ids.end());
+  BOOST_CHECK(std::adjacent_find(all_ids.begin(), all_ids.end()) ==
+              all_ids.end());
+}
+
+// Benchmark: unique_id construction dominates the cost of constructing
+// accessors on the submission path.
+BOOST_AUTO_TEST_CASE(unique_id_throughput) {
+  double legacy = ids_per_second([]() { return make_legacy_unique_id(); });
+  double current = ids_per_second([]() { return glue::unique_id{}; });
+
+  BOOST_TEST_MESSAGE("unique_id construction: " << legacy / 1e6
+                     << " M/s (clock + mt19937), " << current / 1e6
+                     << " M/s (salted counter)");
+
+  // Unlike the legacy scheme, which reads the clock and draws a random
+  // number for every id, the salt is computed once and the shared
+  // counter is only incremented once per block of ids. Check this by
+  // counting the blocks that a fresh thread draws from, and by checking
+  // that this thread's block is unaffected by the other thread.
+  constexpr std::size_t block_size = glue::detail::unique_id_counter_block_size;
+  constexpr std::size_t num_ids = 16 * block_size;
+  glue::unique_id before;
+  if((before.id[1] + 1) % block_size == 0)
+    before = glue::unique_id{};
+
+  std::vector<glue::unique_id> ids;
+  std::thread{[&]() {
+    for(std::size_t i = 0; i < num_ids; ++i)
+      ids.push_back(glue::unique_id{});
+  }}.join();
+
+  glue::unique_id after;
+  BOOST_CHECK_EQUAL(after.id[1], before.id[1] + 1);
+
+  std::size_t num_shared_counter_increments = 1;
+  for(std::size_t i = 1; i < ids.size(); ++i) {
+    BOOST_CHECK(ids[i].id[0] == ids[0].id[0]);
+    if(ids[i].id[1] != ids[i - 1].id[1] + 1)
+      ++num_shared_counter_increments;
+  }
+  BOOST_CHECK_LE(num_shared_counter_increments, num_ids / block_size);
+}
+
+BOOST_AUTO_TEST_CASE(patch_copies_at_known_offsets) {
+  using blob_type = test_blob<4, 100>;
+  int a = 0;
+  int b = 0;
+
+  for(int launch = 0; launch < 3; ++launch) {
+    blob_type blob;
+    // Capture two copies of the first pointer
+    blob.ptrs[2] = blob.ptrs[0];
+
+    BOOST_CHECK(glue::kernel_blob::initialize_embedded_pointer(
+        blob, blob.ptrs[0].get_uid(), &a));
+    BOOST_CHECK(glue::kernel_blob::initialize_embedded_pointer(
+        blob, blob.ptrs[1].get_uid(), &b));
+
+    BOOST_CHECK(blob.ptrs[0].get() == &a);
+    BOOST_CHECK(blob.ptrs[1].get() == &b);
+    BOOST_CHECK(blob.ptrs[2].get() == &a);
+
+    glue::unique_id unknown_id;
+    BOOST_CHECK(!glue::kernel_blob::initialize_embedded_pointer(
+        blob, unknown_id, &a));
+  }
+
+  auto offsets =
+      glue::embedded_pointer_offset_table::get_table<blob_type>().get();
+  BOOST_REQUIRE(offsets);
+  BOOST_CHECK_EQUAL(offsets->size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(pointer_at_new_offset) {
+  using blob_type = test_blob<2, 16>;
+  int a = 0;
+  {
+    blob_type blob;
+    BOOST_CHECK(glue::kernel_blob::initialize_embedded_pointer(
+        blob, blob.ptrs[0].get_uid(), &a));
+  }
+  // The second pointer has never been patched before and must be
+  // found by falling back to scanning the blob.
+  blob_type blob;
+  BOOST_CHECK(glue::kernel_blob::initialize_embedded_pointer(
+      blob, blob.ptrs[1].get_uid(), &a));
+  BOOST_CHECK(blob.ptrs[1].get() == &a);
+}
+
+// Microbenchmark: per-launch cost of patching a 4 KiB kernel
+// capturing 16 accessors.
+BOOST_AUTO_TEST_CASE(patching_overhead) {
+  BOOST_CHECK(sizeof(large_kernel) >= 4096);
+
+  auto& table = glue::embedded_pointer_offset_table::get_table<large_kernel>();
+
+  // The first launch needs to scan the blob
+  double first_launch = patch_time_ns<large_kernel>(1, 16);
+  auto offsets_after_first_launch = table.get();
+  BOOST_REQUIRE(offsets_after_first_launch);
+  BOOST_CHECK_EQUAL(offsets_after_first_launch->size(), 16);
+
+  double subsequent_launches = patch_time_ns<large_kernel>(1000, 16);
+  // Every scan publishes a new offset list, so an unchanged list shows
+  // that none of the subsequent launches fell back to scanning.
+  BOOST_CHECK(table.get() == offsets_after_first_launch);
+
+  BOOST_TEST_MESSAGE("embedded pointer patching, "
+                     << sizeof(large_kernel) << " byte kernel, 16 accessors: "
+                     << first_launch << "ns (first launch), "
+                     << subsequent_launches << "ns (subsequent launches)");
+  // Scanning compares at every byte offset of the 4 KiB blob, while
+  // subsequent launches compare at 16 offsets, so this holds by a wide
+  // margin even on a loaded machine.
+  BOOST_CHECK_LT(subsequent_launches, first_launch);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// A backend plugin without devices that simulates slow driver
+// initialization. It is used to test lazy and concurrent backend
+// creation without requiring GPU hardware.
+
+#include <chrono>
+#include <thread>
+
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/backend_loader.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/hardware.hpp"
+
+#ifndef HIPSYCL_FAKE_BACKEND_NAME
+#define HIPSYCL_FAKE_BACKEND_NAME "fake"
+#endif
+
+#ifndef HIPSYCL_FAKE_BACKEND_LATENCY_MS
+#define HIPSYCL_FAKE_BACKEND_LATENCY_MS 0
+#endif
+
+namespace {
+
+using namespace hipsycl;
+
+class fake_hardware_manager : public rt::backend_hardware_manager {
+public:
+  std::size_t get_num_devices() const override { return 0; }
+  rt::hardware_context *get_device(std::size_t) override { return nullptr; }
+  rt::device_id get_device_id(std::size_t) const override {
+    return rt::device_id{};
+  }
+};
+
+class fake_backend : public rt::backend {
+public:
+  fake_backend() {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds{HIPSYCL_FAKE_BACKEND_LATENCY_MS});
+  }
+
+  rt::api_platform get_api_platform() const override {
+    return rt::api_platform::cuda;
+  }
+  rt::hardware_platform get_hardware_platform() const override {
+    return rt::hardware_platform::cuda;
+  }
+  rt::backend_id get_unique_backend_id() const override {
+    return rt::backend_id::cuda;
+  }
+
+  rt::backend_hardware_manager *get_hardware_manager() const override {
+    return &_hw_manager;
+  }
+  rt::backend_executor *get_executor(rt::device_id) const override {
+    return nullptr;
+  }
+  rt::backend_allocator *get_allocator(rt::device_id) const override {
+    return nullptr;
+  }
+
+  std::string get_name() const override { return HIPSYCL_FAKE_BACKEND_NAME; }
+
+  std::unique_ptr<rt::backend_executor>
+  create_inorder_executor(rt::device_id, int) override {
+    return nullptr;
+  }
+
+private:
+  mutable fake_hardware_manager _hw_manager;
+};
+
+}
+
+HIPSYCL_PLUGIN_API_EXPORT
+hipsycl::rt::backend *hipsycl_backend_plugin_create() {
+  return new fake_backend();
+}
+
+HIPSYCL_PLUGIN_API_EXPORT
+const char *hipsycl_backend_plugin_get_name() {
+  return HIPSYCL_FAKE_BACKEND_NAME;
+}
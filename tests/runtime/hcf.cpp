@@ -0,0 +1,265 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <algorithm>
+#include <string>
+#include <hipSYCL/common/hcf_container.hpp>
+#include <hipSYCL/runtime/kernel_cache.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+common::hcf_container
+make_test_container(const std::string &object_id = "1234") {
+  common::hcf_container hcf;
+  hcf.root_node()->set("object-id", object_id);
+  auto* image = hcf.root_node()->add_subnode("images")->add_subnode("img");
+  image->set("format", "llvm-ir");
+  image->set_as_list("exported-symbols", {"a", "b"});
+  hcf.attach_binary_content(image, std::string{"IR\0DATA", 7});
+  auto* kernels = hcf.root_node()->add_subnode("kernels");
+  kernels->add_subnode("k1")->set("key", "value with = sign");
+  kernels->add_subnode("k2");
+  return hcf;
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(hcf, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(binary_text_roundtrip) {
+  common::hcf_container hcf = make_test_container();
+  std::string text = hcf.serialize();
+  std::string binary = hcf.serialize_binary();
+
+  BOOST_CHECK(!common::hcf_container::is_binary_format(text.data(), text.size()));
+  BOOST_CHECK(
+      common::hcf_container::is_binary_format(binary.data(), binary.size()));
+
+  common::hcf_container from_text{text};
+  common::hcf_container from_binary{binary};
+  BOOST_CHECK(from_text.serialize_binary() == binary);
+  BOOST_CHECK(from_binary.serialize() == text);
+
+  const auto* k1 =
+      from_binary.root_node()->get_subnode("kernels")->get_subnode("k1");
+  BOOST_REQUIRE(k1);
+  BOOST_CHECK(*k1->get_value("key") == "value with = sign");
+  BOOST_CHECK(from_binary.root_node()->get_subnode("images")
+                  ->get_subnode("img")
+                  ->get_as_list("exported-symbols") ==
+              (std::vector<std::string>{"a", "b"}));
+}
+
+BOOST_AUTO_TEST_CASE(zero_copy_attachments) {
+  std::string binary = make_test_container().serialize_binary();
+  common::hcf_container hcf{binary.data(), binary.size()};
+  // Copies must keep referencing the original data
+  common::hcf_container copy = hcf;
+
+  const auto* image =
+      copy.root_node()->get_subnode("images")->get_subnode("img");
+  const char* data = nullptr;
+  std::size_t size = 0;
+  BOOST_REQUIRE(copy.get_binary_attachment(image, data, size));
+  BOOST_CHECK(size == 7);
+  BOOST_CHECK(data >= binary.data() && data + size <= binary.data() + binary.size());
+  BOOST_CHECK(
+      (data - binary.data()) % common::hcf_container::binary_appendix_alignment == 0);
+  BOOST_CHECK(std::string(data, size) == std::string("IR\0DATA", 7));
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_binary) {
+  std::string binary = make_test_container().serialize_binary();
+  // Truncated data must be rejected without out-of-bounds accesses
+  for(std::size_t size = 0; size < binary.size(); size += 5) {
+    common::hcf_container hcf{binary.data(), size};
+    std::string attachment;
+    const auto* images = hcf.root_node()->get_subnode("images");
+    if(images)
+      hcf.get_binary_attachment(images->get_subnode("img"), attachment);
+  }
+
+  // Table sizes that exceed the data must be rejected based on the header
+  std::string oversized = binary;
+  const std::size_t num_nodes_offset = 16;
+  for(int i = 0; i < 8; ++i)
+    oversized[num_nodes_offset + i] =
+        static_cast<char>((oversized.size() >> (8 * i)) & 0xff);
+  common::hcf_container hcf{oversized.data(), oversized.size()};
+  BOOST_CHECK(!hcf.root_node()->has_subnode("images"));
+}
+
+BOOST_AUTO_TEST_CASE(hashed_lookup) {
+  common::hcf_container hcf;
+  auto* kernels = hcf.root_node()->add_subnode("kernels");
+  for(int i = 0; i < 1000; ++i)
+    kernels->add_subnode("k" + std::to_string(i))
+        ->set("id", std::to_string(i));
+  kernels->set("duplicate", "first");
+  kernels->set("duplicate", "second");
+  std::string binary = hcf.serialize_binary();
+
+  common::hcf_container parsed{binary.data(), binary.size()};
+  const auto* parsed_kernels =
+      static_cast<const common::hcf_container&>(parsed).root_node()->get_subnode(
+          "kernels");
+  BOOST_REQUIRE(parsed_kernels);
+  for(int i = 0; i < 1000; i += 37) {
+    const auto* k = parsed_kernels->get_subnode("k" + std::to_string(i));
+    BOOST_REQUIRE(k);
+    BOOST_CHECK(*k->get_value("id") == std::to_string(i));
+  }
+  BOOST_CHECK(!parsed_kernels->get_subnode("k1000"));
+  BOOST_CHECK(!parsed_kernels->get_value("id"));
+  // Like in the text form, the first of several entries with the same
+  // key is returned
+  BOOST_CHECK(*parsed_kernels->get_value("duplicate") == "first");
+
+  // Modified nodes must still be found
+  auto* modified = parsed.root_node()->get_subnode("kernels");
+  BOOST_REQUIRE(modified->add_subnode("added"));
+  BOOST_CHECK(!modified->add_subnode("k5"));
+  BOOST_CHECK(modified->get_subnode("added"));
+  BOOST_CHECK(*modified->get_subnode("k999")->get_value("id") == "999");
+}
+
+BOOST_AUTO_TEST_CASE(lazy_decoding) {
+  std::string binary = make_test_container().serialize_binary();
+  // Corrupt the name of node 3 ("img") so that decoding its parent
+  // ("images") fails. Nodes are stored in breadth-first order after the
+  // 56 byte header, and each node record is 7 64-bit values starting with
+  // the name offset and size.
+  const std::size_t img_name_size_offset = 56 + 3 * 56 + 8;
+  for(int i = 0; i < 8; ++i)
+    binary[img_name_size_offset + i] = '\xff';
+
+  common::hcf_container hcf{binary.data(), binary.size()};
+  // Only the nodes that are actually accessed are decoded, so the other
+  // subtrees remain usable.
+  const auto* k1 = hcf.root_node()->get_subnode("kernels")->get_subnode("k1");
+  BOOST_REQUIRE(k1);
+  BOOST_CHECK(*k1->get_value("key") == "value with = sign");
+  BOOST_CHECK(*hcf.root_node()->get_value("object-id") == "1234");
+
+  const auto* images = hcf.root_node()->get_subnode("images");
+  BOOST_REQUIRE(images);
+  BOOST_CHECK(images->get_subnodes().empty());
+}
+
+BOOST_AUTO_TEST_CASE(deferred_registration) {
+  const rt::hcf_object_id id = 0x7e57deadbeefULL;
+  common::hcf_container hcf = make_test_container(std::to_string(id));
+  auto *k1 = hcf.root_node()->get_subnode("kernels")->get_subnode("k1");
+  k1->set_as_list("image-providers", {"img"});
+  k1->add_subnode("parameters");
+  hcf.root_node()->get_subnode("images")->get_subnode("img")->set("variant",
+                                                                    "test");
+  std::string binary = hcf.serialize_binary();
+
+  auto &cache = rt::hcf_cache::get();
+  std::size_t num_loaded =
+      cache.get_registration_statistics().num_loaded_objects;
+
+  BOOST_CHECK(cache.register_hcf_object(id, binary.data(), binary.size()) ==
+              id);
+  // Nothing may be parsed before the object is actually used
+  BOOST_CHECK(cache.get_registration_statistics().num_loaded_objects ==
+              num_loaded);
+
+  const rt::hcf_image_info *image = cache.get_image_info(id, "img");
+  BOOST_REQUIRE(image);
+  BOOST_CHECK(cache.get_registration_statistics().num_loaded_objects ==
+              num_loaded + 1);
+  BOOST_CHECK(image->get_contained_kernels() ==
+              std::vector<std::string>{"k1"});
+  BOOST_CHECK(cache.get_kernel_info(id, "k1"));
+  BOOST_CHECK(cache.get_hcf(id));
+  BOOST_CHECK(cache.get_registration_statistics().num_loaded_objects ==
+              num_loaded + 1);
+
+  cache.unregister_hcf_object(id);
+  BOOST_CHECK(!cache.get_hcf(id));
+
+  // Objects that were never used can be unregistered without parsing them
+  cache.register_hcf_object(id, binary.data(), binary.size());
+  cache.unregister_hcf_object(id);
+  BOOST_CHECK(!cache.get_hcf(id));
+  BOOST_CHECK(cache.get_registration_statistics().num_loaded_objects ==
+              num_loaded + 1);
+}
+
+BOOST_AUTO_TEST_CASE(symbol_providers) {
+  auto make_object = [](rt::hcf_object_id id, const std::string &image_name,
+                        const std::vector<std::string> &exports,
+                        const std::vector<std::string> &imports) {
+    common::hcf_container hcf;
+    hcf.root_node()->set("object-id", std::to_string(id));
+    auto *image =
+        hcf.root_node()->add_subnode("images")->add_subnode(image_name);
+    image->set_as_list("exported-symbols", exports);
+    image->set_as_list("imported-symbols", imports);
+    return hcf.serialize_binary();
+  };
+  const rt::hcf_object_id user = 0x5e7deadbeef0ULL;
+  const rt::hcf_object_id direct = 0x5e7deadbeef1ULL;
+  const rt::hcf_object_id indirect = 0x5e7deadbeef2ULL;
+  const rt::hcf_object_id unrelated = 0x5e7deadbeef3ULL;
+  const rt::hcf_object_id other_image = 0x5e7deadbeef4ULL;
+  std::vector<std::string> objects{
+      make_object(user, "llvm-ir.global", {"user_f"}, {"direct_f"}),
+      make_object(direct, "llvm-ir.global", {"direct_f"}, {"indirect_f"}),
+      make_object(indirect, "llvm-ir.global", {"indirect_f"}, {}),
+      make_object(unrelated, "llvm-ir.global", {"unrelated_f"}, {}),
+      make_object(other_image, "other", {"direct_f"}, {})};
+  const rt::hcf_object_id ids[] = {user, direct, indirect, unrelated,
+                                   other_image};
+
+  auto &cache = rt::hcf_cache::get();
+  for(std::size_t i = 0; i < objects.size(); ++i)
+    cache.register_hcf_object(ids[i], objects[i].data(), objects[i].size());
+
+  // Only objects that provide the imports, directly or through the
+  // imports of a provider, are returned
+  BOOST_CHECK(cache.get_symbol_providers({"direct_f"}, "llvm-ir.global") ==
+              (std::vector<rt::hcf_object_id>{direct, indirect}));
+  BOOST_CHECK(cache.get_symbol_providers({"missing_f"}, "llvm-ir.global")
+                  .empty());
+
+  cache.unregister_hcf_object(indirect);
+  BOOST_CHECK(cache.get_symbol_providers({"direct_f"}, "llvm-ir.global") ==
+              std::vector<rt::hcf_object_id>{direct});
+
+  for(auto id : ids)
+    cache.unregister_hcf_object(id);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
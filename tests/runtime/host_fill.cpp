@@ -0,0 +1,191 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <sycl/sycl.hpp>
+
+namespace {
+
+struct wide_pattern {
+  std::uint64_t low;
+  std::uint64_t high;
+};
+
+template <class T> T make_pattern() {
+  T pattern;
+  unsigned char *bytes = reinterpret_cast<unsigned char *>(&pattern);
+  for(std::size_t i = 0; i < sizeof(T); ++i)
+    bytes[i] = static_cast<unsigned char>(0x11 * (i + 1));
+  return pattern;
+}
+
+// Fills count elements starting at a misaligned address and checks
+// that exactly these bytes have been written.
+template <class T> void check_usm_fill(sycl::queue &q, std::size_t count) {
+  const std::size_t num_bytes = count * sizeof(T) + 2;
+  unsigned char *mem = sycl::malloc_shared<unsigned char>(num_bytes, q);
+  std::memset(mem, 0, num_bytes);
+
+  T pattern = make_pattern<T>();
+  q.fill(mem + 1, pattern, count).wait();
+
+  const unsigned char *pattern_bytes =
+      reinterpret_cast<const unsigned char *>(&pattern);
+  BOOST_CHECK(mem[0] == 0);
+  BOOST_CHECK(mem[num_bytes - 1] == 0);
+  std::size_t num_errors = 0;
+  for(std::size_t i = 0; i < count * sizeof(T); ++i) {
+    if(mem[i + 1] != pattern_bytes[i % sizeof(T)])
+      ++num_errors;
+  }
+  BOOST_CHECK_MESSAGE(num_errors == 0, "fill with pattern size "
+                                           << sizeof(T) << " and " << count
+                                           << " elements failed");
+  sycl::free(mem, q);
+}
+
+template <class T> void check_usm_fills(sycl::queue &q) {
+  for(std::size_t count : {std::size_t{1}, std::size_t{1000},
+                           (std::size_t{40} << 20) / sizeof(T) + 7})
+    check_usm_fill<T>(q, count);
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(host_fill, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(usm_fill_patterns) {
+  sycl::queue q;
+  // The largest fill is above the default streaming threshold
+  check_usm_fills<std::uint8_t>(q);
+  check_usm_fills<std::uint16_t>(q);
+  check_usm_fills<std::uint32_t>(q);
+  check_usm_fills<std::uint64_t>(q);
+  check_usm_fills<wide_pattern>(q);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_fill) {
+  sycl::queue q;
+  constexpr std::size_t n = 64;
+  sycl::buffer<int, 2> buff{sycl::range<2>{n, n}};
+  sycl::buffer<int, 2> sub_buff{buff, sycl::id<2>{40, 0},
+                                sycl::range<2>{8, n}};
+
+  q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{buff, cgh, sycl::write_only, sycl::no_init};
+    cgh.fill(acc, 0);
+  });
+  // Contiguous rows
+  q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{buff, cgh, sycl::range<2>{4, n}, sycl::id<2>{3, 0},
+                       sycl::write_only};
+    cgh.fill(acc, 1);
+  });
+  // Not contiguous
+  q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{buff, cgh, sycl::range<2>{n, 2}, sycl::id<2>{0, 5},
+                       sycl::write_only};
+    cgh.fill(acc, 2);
+  });
+  // Contiguous within a sub-buffer
+  q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{sub_buff, cgh, sycl::range<2>{2, n},
+                       sycl::id<2>{1, 0}, sycl::write_only};
+    cgh.fill(acc, 3);
+  });
+
+  sycl::host_accessor acc{buff, sycl::read_only};
+  std::size_t num_errors = 0;
+  for(std::size_t i = 0; i < n; ++i) {
+    for(std::size_t j = 0; j < n; ++j) {
+      int expected = 0;
+      if(i >= 41 && i < 43)
+        expected = 3;
+      else if(j == 5 || j == 6)
+        expected = 2;
+      else if(i >= 3 && i < 7)
+        expected = 1;
+      if(acc[i][j] != expected)
+        ++num_errors;
+    }
+  }
+  BOOST_CHECK(num_errors == 0);
+}
+
+BOOST_AUTO_TEST_CASE(memset_bandwidth_benchmark) {
+  sycl::queue q;
+  constexpr std::size_t min_size = 4096;
+  constexpr std::size_t bytes_per_size = std::size_t{1} << 30;
+  // The default fits into the memory of small CI machines. Set
+  // HIPSYCL_TEST_MEMSET_MAX_SIZE to measure larger sizes, e.g.
+  // 8589934592 for 8 GiB.
+  std::size_t max_size = std::size_t{256} << 20;
+  if(const char *env = std::getenv("HIPSYCL_TEST_MEMSET_MAX_SIZE"))
+    max_size = std::max(min_size, std::size_t{std::strtoull(env, nullptr, 10)});
+
+  unsigned char *mem = sycl::malloc_host<unsigned char>(max_size, q);
+  std::memset(mem, 1, max_size);
+
+  auto measure = [&](auto &&f, std::size_t size) {
+    const std::size_t reps =
+        std::clamp(bytes_per_size / size, std::size_t{1}, std::size_t{1000});
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < reps; ++i)
+      f();
+    auto stop = std::chrono::steady_clock::now();
+    return static_cast<double>(reps * size) /
+           std::chrono::duration<double>(stop - start).count() * 1.e-9;
+  };
+
+  double queue_bandwidth = 0.0;
+  double memset_bandwidth = 0.0;
+  for(std::size_t size = min_size;; size = std::min(4 * size, max_size)) {
+    queue_bandwidth = measure([&]() { q.memset(mem, 0, size).wait(); }, size);
+    memset_bandwidth = measure([&]() { std::memset(mem, 0, size); }, size);
+
+    BOOST_TEST_MESSAGE("memset of " << size << " bytes: queue "
+                                    << queue_bandwidth << " GB/s, std::memset "
+                                    << memset_bandwidth << " GB/s");
+    if(size == max_size)
+      break;
+  }
+  // At the largest size, submission overhead is negligible and the
+  // queue must not fall far behind std::memset
+  BOOST_CHECK_GT(queue_bandwidth, 0.3 * memset_bandwidth);
+
+  sycl::free(mem, q);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,378 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <hipSYCL/common/hcf_container.hpp>
+#include <hipSYCL/runtime/code_object_invoker.hpp>
+#include <hipSYCL/runtime/kernel_cache.hpp>
+#include <hipSYCL/runtime/jit_compilation_service.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+constexpr rt::hcf_object_id test_hcf_object = 0xc0ffee;
+
+class stub_code_object : public rt::code_object {
+public:
+  stub_code_object(const std::string &kernel_name,
+                   glue::kernel_configuration::id_type config_id = {})
+  : _kernel_name{kernel_name}, _config_id{config_id} {}
+
+  virtual rt::code_object_state state() const override {
+    return rt::code_object_state::executable;
+  }
+  virtual rt::code_format format() const override {
+    return rt::code_format::native_isa;
+  }
+  virtual rt::backend_id managing_backend() const override {
+    return rt::backend_id::omp;
+  }
+  virtual rt::hcf_object_id hcf_source() const override {
+    return test_hcf_object;
+  }
+  virtual std::string target_arch() const override { return "stub"; }
+  virtual rt::compilation_flow source_compilation_flow() const override {
+    return rt::compilation_flow::sscp;
+  }
+  virtual std::vector<std::string>
+  supported_backend_kernel_names() const override {
+    return {_kernel_name};
+  }
+  virtual bool contains(const std::string &backend_kernel_name) const override {
+    return backend_kernel_name == _kernel_name;
+  }
+  virtual glue::kernel_configuration::id_type
+  configuration_id() const override {
+    return _config_id;
+  }
+private:
+  std::string _kernel_name;
+  glue::kernel_configuration::id_type _config_id;
+};
+
+template<class KernelT>
+const rt::code_object *
+get_or_construct(const std::string &kernel_name,
+                 const std::function<rt::code_object *()> &constructor) {
+  rt::kernel_cache& cache = rt::kernel_cache::get();
+  const rt::kernel_cache::kernel_name_index_t *kidx =
+      cache.get_global_kernel_index(cache.get_global_kernel_name<KernelT>());
+  BOOST_REQUIRE(kidx != nullptr);
+
+  auto selector = [](const rt::code_object *obj) {
+    return obj->target_arch() == "stub";
+  };
+  return cache.get_or_construct_code_object(*kidx, kernel_name,
+                                            rt::backend_id::omp,
+                                            test_hcf_object, selector,
+                                            constructor);
+}
+
+const rt::code_object *
+get_or_construct(rt::kernel_cache::kernel_name_index_t kidx,
+                 const std::string &kernel_name,
+                 const glue::kernel_configuration::id_type &config_id) {
+  auto selector = [&](const rt::code_object *obj) {
+    return obj->configuration_id() == config_id;
+  };
+  return rt::kernel_cache::get().get_or_construct_code_object(
+      kidx, kernel_name, rt::backend_id::omp, test_hcf_object, config_id,
+      selector, [&]() -> rt::code_object * {
+        return new stub_code_object{kernel_name, config_id};
+      });
+}
+
+class concurrent_construction_kernel {};
+class statistics_kernel {};
+class many_configurations_kernel {};
+class blocked_kernel {};
+class unrelated_kernel {};
+class failing_kernel {};
+class resolved_kernel {};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(kernel_cache, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(concurrent_construction_is_deduplicated) {
+  rt::kernel_cache::get().register_kernel<concurrent_construction_kernel>();
+
+  std::atomic<int> num_constructions{0};
+  auto constructor = [&]() -> rt::code_object* {
+    ++num_constructions;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return new stub_code_object{"concurrent_construction"};
+  };
+
+  std::vector<std::thread> threads;
+  std::vector<const rt::code_object*> results(4, nullptr);
+  for(std::size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i](){
+      results[i] = get_or_construct<concurrent_construction_kernel>(
+          "concurrent_construction", constructor);
+    });
+  }
+  for(auto& t : threads)
+    t.join();
+
+  BOOST_CHECK(num_constructions == 1);
+  for(const rt::code_object* obj : results) {
+    BOOST_CHECK(obj != nullptr);
+    BOOST_CHECK(obj == results[0]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(construction_does_not_block_other_kernels) {
+  rt::kernel_cache::get().register_kernel<blocked_kernel>();
+  rt::kernel_cache::get().register_kernel<unrelated_kernel>();
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+
+  std::thread blocked_thread{[&](){
+    get_or_construct<blocked_kernel>("blocked", [&]() -> rt::code_object* {
+      released.wait();
+      return new stub_code_object{"blocked"};
+    });
+  }};
+
+  // Give the other thread time to enter its constructor
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  auto unrelated = std::async(std::launch::async, [](){
+    return get_or_construct<unrelated_kernel>(
+        "unrelated",
+        []() -> rt::code_object * { return new stub_code_object{"unrelated"}; });
+  });
+  BOOST_CHECK(unrelated.wait_for(std::chrono::seconds(10)) ==
+              std::future_status::ready);
+  BOOST_CHECK(unrelated.get() != nullptr);
+
+  release.set_value();
+  blocked_thread.join();
+}
+
+BOOST_AUTO_TEST_CASE(failed_construction_unblocks_waiters) {
+  rt::kernel_cache::get().register_kernel<failing_kernel>();
+
+  std::promise<void> entered;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+
+  auto failing = std::async(std::launch::async, [&]() {
+    return get_or_construct<failing_kernel>(
+        "failing", [&]() -> rt::code_object * {
+          entered.set_value();
+          released.wait();
+          throw std::runtime_error{"simulated compiler crash"};
+        });
+  });
+  entered.get_future().wait();
+
+  // Waits for the failing construction, then constructs the object itself
+  auto waiting = std::async(std::launch::async, []() {
+    return get_or_construct<failing_kernel>(
+        "failing",
+        []() -> rt::code_object * { return new stub_code_object{"failing"}; });
+  });
+  release.set_value();
+
+  BOOST_CHECK_THROW(failing.get(), std::runtime_error);
+  BOOST_REQUIRE(waiting.wait_for(std::chrono::seconds(10)) ==
+                std::future_status::ready);
+  BOOST_CHECK(waiting.get() != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(hit_miss_statistics) {
+  rt::kernel_cache& cache = rt::kernel_cache::get();
+  cache.register_kernel<statistics_kernel>();
+  const rt::kernel_cache::kernel_name_index_t *kidx =
+      cache.get_global_kernel_index(
+          cache.get_global_kernel_name<statistics_kernel>());
+  BOOST_REQUIRE(kidx != nullptr);
+
+  glue::kernel_configuration::id_type config_a{1, 2};
+  glue::kernel_configuration::id_type config_b{3, 4};
+
+  const rt::code_object *a = get_or_construct(*kidx, "statistics", config_a);
+  for(int i = 0; i < 10; ++i)
+    BOOST_CHECK(get_or_construct(*kidx, "statistics", config_a) == a);
+  const rt::code_object *b = get_or_construct(*kidx, "statistics", config_b);
+  BOOST_CHECK(a != b);
+  BOOST_CHECK(get_or_construct(*kidx, "statistics", config_b) == b);
+
+  rt::kernel_cache::kernel_statistics stats = cache.get_statistics(*kidx);
+  BOOST_CHECK(stats.hits == 11);
+  BOOST_CHECK(stats.misses == 2);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_lookups_during_growth) {
+  rt::kernel_cache& cache = rt::kernel_cache::get();
+  cache.register_kernel<many_configurations_kernel>();
+  const rt::kernel_cache::kernel_name_index_t *kidx =
+      cache.get_global_kernel_index(
+          cache.get_global_kernel_name<many_configurations_kernel>());
+  BOOST_REQUIRE(kidx != nullptr);
+
+  // Enough configurations to grow the lookup table several times
+  constexpr std::uint64_t num_configs = 1000;
+  const rt::code_object *first =
+      get_or_construct(*kidx, "many_configurations", {0, 0});
+
+  std::atomic<bool> done{false};
+  std::atomic<bool> consistent{true};
+  std::thread reader{[&]() {
+    while(!done) {
+      if(get_or_construct(*kidx, "many_configurations", {0, 0}) != first)
+        consistent = false;
+    }
+  }};
+  for(std::uint64_t i = 1; i < num_configs; ++i) {
+    const rt::code_object *obj =
+        get_or_construct(*kidx, "many_configurations", {i, 0});
+    BOOST_CHECK(obj->configuration_id() ==
+                (glue::kernel_configuration::id_type{i, 0}));
+  }
+  done = true;
+  reader.join();
+
+  BOOST_CHECK(consistent);
+  BOOST_CHECK(cache.get_statistics(*kidx).misses == num_configs);
+}
+
+BOOST_AUTO_TEST_CASE(resolve_sscp_kernel_ids) {
+  rt::kernel_cache& cache = rt::kernel_cache::get();
+  cache.register_kernel<resolved_kernel>();
+  const std::string global_name = cache.get_global_kernel_name<resolved_kernel>();
+
+  const rt::hcf_object_id id = 0x5e5a17ed;
+  common::hcf_container hcf;
+  hcf.root_node()->set("object-id", std::to_string(id));
+  hcf.root_node()->add_subnode("images")->add_subnode("img")->set("variant",
+                                                                  "test");
+  auto *kernel_node =
+      hcf.root_node()->add_subnode("kernels")->add_subnode("resolved");
+  kernel_node->set_as_list("image-providers", {"img"});
+  kernel_node->add_subnode("parameters");
+  std::string binary = hcf.serialize_binary();
+  rt::hcf_cache::get().register_hcf_object(id, binary.data(), binary.size());
+
+  rt::sscp_kernel_id kernel_id;
+  BOOST_REQUIRE(rt::resolve_sscp_kernel(id, global_name, "resolved", kernel_id)
+                    .is_success());
+  BOOST_CHECK(kernel_id.hcf_object == id);
+  BOOST_CHECK(kernel_id.kernel_index ==
+              *cache.get_global_kernel_index(global_name));
+  BOOST_CHECK(kernel_id.kernel_info ==
+              rt::hcf_cache::get().get_kernel_info(id, "resolved"));
+  BOOST_CHECK(kernel_id.kernel_name == "resolved");
+
+  BOOST_CHECK(!rt::resolve_sscp_kernel(id, global_name, "missing", kernel_id)
+                   .is_success());
+  BOOST_CHECK(
+      !rt::resolve_sscp_kernel(id, "unregistered", "resolved", kernel_id)
+           .is_success());
+
+  rt::hcf_cache::get().unregister_hcf_object(id);
+}
+
+BOOST_AUTO_TEST_CASE(warm_up_progress) {
+  rt::jit_compilation_service service{2};
+
+  constexpr std::size_t num_tasks = 8;
+  std::atomic<std::size_t> num_callbacks{0};
+  std::atomic<std::size_t> max_reported{0};
+
+  std::vector<rt::jit_compilation_service::task> tasks;
+  for(std::size_t i = 0; i < num_tasks; ++i) {
+    tasks.push_back([i]() -> rt::result {
+      if(i == 3)
+        return rt::make_error(__hipsycl_here(),
+                              rt::error_info{"simulated compilation failure"});
+      return rt::make_success();
+    });
+  }
+
+  rt::jit_warm_up_handle handle = service.warm_up(
+      tasks, [&](std::size_t num_completed, std::size_t total) {
+        ++num_callbacks;
+        BOOST_CHECK(total == num_tasks);
+        std::size_t prev = max_reported.load();
+        while(num_completed > prev &&
+              !max_reported.compare_exchange_weak(prev, num_completed))
+          ;
+      });
+  handle.wait();
+
+  BOOST_CHECK(handle.is_complete());
+  BOOST_CHECK(handle.get_num_tasks() == num_tasks);
+  BOOST_CHECK(handle.get_num_completed() == num_tasks);
+  BOOST_CHECK(handle.get_num_failed() == 1);
+  BOOST_CHECK(handle.get_errors().size() == 1);
+  BOOST_CHECK(num_callbacks == num_tasks);
+  BOOST_CHECK(max_reported == num_tasks);
+
+  auto f = service.submit([]() { return rt::make_success(); });
+  BOOST_CHECK(f.get().is_success());
+  service.wait();
+  BOOST_CHECK(service.get_num_pending_tasks() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(shutdown_finishes_pending_tasks) {
+  rt::jit_compilation_service service{1};
+
+  std::vector<std::shared_future<rt::result>> results;
+  for(int i = 0; i < 4; ++i) {
+    results.push_back(service.submit([]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      return rt::make_success();
+    }));
+  }
+  service.shutdown();
+
+  BOOST_CHECK(service.get_num_pending_tasks() == 0);
+  for(auto& r : results)
+    BOOST_CHECK(r.wait_for(std::chrono::seconds(0)) ==
+                std::future_status::ready);
+
+  // Workers are restarted on demand
+  BOOST_CHECK(service.submit([]() { return rt::make_success(); })
+                  .get()
+                  .is_success());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
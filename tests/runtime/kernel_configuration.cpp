@@ -0,0 +1,105 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <string>
+#include <hipSYCL/common/stable_fast_hash.hpp>
+#include <hipSYCL/glue/kernel_configuration.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+common::stable_fast_hash::hash_type hash_string(const std::string& s) {
+  common::stable_fast_hash h;
+  h(s.data(), s.size());
+  return h.get_current_hash();
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(kernel_configuration, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(fast_hash) {
+  std::string data(100, 'x');
+  BOOST_CHECK(hash_string(data) == hash_string(data));
+  // Every length and every flipped byte must lead to a different hash,
+  // including the tail that is shorter than a block
+  for(std::size_t i = 0; i < data.size(); ++i) {
+    std::string modified = data;
+    modified[i] ^= 1;
+    BOOST_CHECK(hash_string(modified) != hash_string(data));
+    BOOST_CHECK(hash_string(data.substr(0, i)) != hash_string(data));
+  }
+  // Message boundaries are part of the hash
+  common::stable_fast_hash a;
+  a("ab", 2);
+  a("c", 1);
+  common::stable_fast_hash b;
+  b("a", 1);
+  b("bc", 2);
+  BOOST_CHECK(a.get_current_hash() != b.get_current_hash());
+}
+
+BOOST_AUTO_TEST_CASE(incremental_id) {
+  glue::kernel_configuration config;
+  BOOST_CHECK(config.generate_id() == glue::kernel_configuration::id_type{});
+
+  config.set("a", 1);
+  config.set("b", 2.0f);
+  auto id = config.generate_id();
+  BOOST_CHECK(id != glue::kernel_configuration::id_type{});
+
+  // The id does not depend on the order of entries
+  glue::kernel_configuration reordered;
+  reordered.set("b", 2.0f);
+  reordered.set("a", 1);
+  BOOST_CHECK(reordered.generate_id() == id);
+
+  config.set("a", 1);
+  BOOST_CHECK(config.generate_id() == id);
+
+  config.set("a", 3);
+  BOOST_CHECK(config.generate_id() != id);
+  config.set("a", 1);
+  BOOST_CHECK(config.generate_id() == id);
+
+  // Same bits, but different type
+  config.set("a", 1u);
+  BOOST_CHECK(config.entries()[0].is_type<unsigned>());
+  config.set("a", 1);
+  BOOST_CHECK(config.generate_id() == id);
+
+  glue::kernel_configuration copy = config;
+  copy.set("c", 'c');
+  BOOST_CHECK(copy.generate_id() != id);
+  BOOST_CHECK(config.generate_id() == id);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
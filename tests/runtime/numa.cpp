@@ -0,0 +1,269 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <thread>
+#include <sycl/sycl.hpp>
+#include <hipSYCL/runtime/hw_model/numa.hpp>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdlib>
+#include <omp.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace hipsycl;
+
+namespace {
+
+struct fake_sysfs {
+  fake_sysfs() {
+    root = std::filesystem::temp_directory_path() /
+           ("hipsycl-numa-test-" +
+            std::to_string(
+                std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(root);
+  }
+
+  ~fake_sysfs() {
+    std::filesystem::remove_all(root);
+  }
+
+  void add_node(int id, const std::string& cpulist) {
+    auto node_dir = root / ("node" + std::to_string(id));
+    std::filesystem::create_directories(node_dir);
+    std::ofstream{node_dir / "cpulist"} << cpulist << "\n";
+  }
+
+  std::filesystem::path root;
+};
+
+#ifdef __linux__
+void set_numa_first_touch(bool enabled) {
+  if(enabled)
+    setenv("HIPSYCL_RT_OMP_NUMA_FIRST_TOUCH", "1", 1);
+  else
+    unsetenv("HIPSYCL_RT_OMP_NUMA_FIRST_TOUCH");
+  hipsycl::rt::application::get_settings() = hipsycl::rt::settings{};
+}
+
+// Returns the node of each page in [mem, mem+size), or -ENOENT for pages
+// that have not been touched yet.
+std::vector<int> query_page_nodes(void* mem, std::size_t size) {
+  const std::size_t page_size = sysconf(_SC_PAGESIZE);
+  char* base = static_cast<char*>(mem);
+  std::size_t first_page = (page_size - reinterpret_cast<std::uintptr_t>(base) %
+                            page_size) % page_size;
+
+  std::vector<void*> pages;
+  for(std::size_t offset = first_page; offset + page_size <= size;
+      offset += page_size)
+    pages.push_back(base + offset);
+
+  std::vector<int> status(pages.size(), 0);
+  // move_pages with nodes == nullptr only queries the placement
+  if(syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr,
+             status.data(), 0) != 0)
+    return {};
+  return status;
+}
+#endif
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(numa, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(cpu_list_parsing) {
+  std::vector<int> cpus;
+  BOOST_CHECK(rt::numa_topology::parse_cpu_list("0-3,8,10-11", cpus));
+  BOOST_CHECK(cpus == (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+
+  BOOST_CHECK(rt::numa_topology::parse_cpu_list("5\n", cpus));
+  BOOST_CHECK(cpus == std::vector<int>{5});
+
+  BOOST_CHECK(rt::numa_topology::parse_cpu_list("", cpus));
+  BOOST_CHECK(cpus.empty());
+
+  BOOST_CHECK(!rt::numa_topology::parse_cpu_list("3-1", cpus));
+  BOOST_CHECK(!rt::numa_topology::parse_cpu_list("0-", cpus));
+  BOOST_CHECK(!rt::numa_topology::parse_cpu_list("a,b", cpus));
+}
+
+BOOST_AUTO_TEST_CASE(fake_sysfs_topology) {
+  fake_sysfs sysfs;
+  sysfs.add_node(1, "4-7");
+  sysfs.add_node(0, "0-3");
+  // memory-only node
+  sysfs.add_node(2, "");
+
+  auto topo = rt::numa_topology::from_sysfs(sysfs.root.string());
+  BOOST_REQUIRE(topo.get_num_domains() == 2);
+  BOOST_CHECK(topo.get_num_cpus() == 8);
+  BOOST_CHECK(topo.get_node_id(0) == 0);
+  BOOST_CHECK(topo.get_node_id(1) == 1);
+  BOOST_CHECK(topo.get_cpus(0) == (std::vector<int>{0, 1, 2, 3}));
+  BOOST_CHECK(topo.get_cpus(1) == (std::vector<int>{4, 5, 6, 7}));
+}
+
+BOOST_AUTO_TEST_CASE(missing_sysfs_fallback) {
+  auto topo = rt::numa_topology::from_sysfs("/this/path/does/not/exist");
+  BOOST_CHECK(topo.get_num_domains() == 1);
+  BOOST_CHECK(topo.get_num_cpus() >= 1);
+}
+
+BOOST_AUTO_TEST_CASE(system_topology) {
+  // Whatever the machine looks like, every domain must have CPUs
+  // and each CPU must belong to exactly one domain.
+  auto topo = rt::numa_topology::from_sysfs();
+  BOOST_CHECK(topo.get_num_domains() >= 1);
+  std::set<int> seen_cpus;
+  for(std::size_t i = 0; i < topo.get_num_domains(); ++i) {
+    BOOST_CHECK(!topo.get_cpus(i).empty());
+    for(int cpu : topo.get_cpus(i))
+      BOOST_CHECK(seen_cpus.insert(cpu).second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(thread_domain_assignment) {
+  fake_sysfs sysfs;
+  sysfs.add_node(0, "0-3");
+  sysfs.add_node(1, "4-7");
+  auto topo = rt::numa_topology::from_sysfs(sysfs.root.string());
+  BOOST_REQUIRE(topo.get_num_domains() == 2);
+
+  std::vector<std::size_t> four_threads;
+  for(std::size_t t = 0; t < 4; ++t)
+    four_threads.push_back(topo.get_domain_of_thread(t, 4));
+  BOOST_CHECK(four_threads == (std::vector<std::size_t>{0, 0, 1, 1}));
+
+  std::vector<std::size_t> three_threads;
+  for(std::size_t t = 0; t < 3; ++t)
+    three_threads.push_back(topo.get_domain_of_thread(t, 3));
+  BOOST_CHECK(three_threads == (std::vector<std::size_t>{0, 0, 1}));
+
+  // More domains than threads: every thread still gets a valid domain
+  BOOST_CHECK(topo.get_domain_of_thread(0, 1) == 0);
+}
+
+#ifdef __linux__
+
+BOOST_AUTO_TEST_CASE(thread_binding) {
+  auto topo = rt::numa_topology::from_sysfs();
+  const std::size_t last_domain = topo.get_num_domains() - 1;
+
+  bool bound = false;
+  std::set<int> affinity;
+  // Bind a separate thread so that the affinity of the test process
+  // remains unchanged.
+  std::thread{[&]() {
+    bound = topo.bind_current_thread(last_domain);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) == 0)
+      for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if(CPU_ISSET(cpu, &set))
+          affinity.insert(cpu);
+  }}.join();
+
+  BOOST_REQUIRE(bound);
+  const auto& cpus = topo.get_cpus(last_domain);
+  BOOST_CHECK(affinity == std::set<int>(cpus.begin(), cpus.end()));
+}
+
+BOOST_AUTO_TEST_CASE(first_touch_placement) {
+  // Large enough that the allocation is backed by fresh, untouched pages
+  constexpr std::size_t size = 64 * 1024 * 1024;
+  auto topo = rt::numa_topology::from_sysfs();
+
+  set_numa_first_touch(false);
+  {
+    ::sycl::queue q{::sycl::cpu_selector_v};
+    char* mem = ::sycl::malloc_shared<char>(size, q);
+    BOOST_REQUIRE(mem);
+    auto nodes = query_page_nodes(mem, size);
+    BOOST_REQUIRE(!nodes.empty());
+    // Without first touch, the allocation is not initialized
+    // and pages are not yet placed anywhere.
+    std::size_t num_untouched =
+        std::count(nodes.begin(), nodes.end(), -ENOENT);
+    BOOST_CHECK_GT(num_untouched, nodes.size() / 2);
+    ::sycl::free(mem, q);
+  }
+
+  set_numa_first_touch(true);
+  {
+    ::sycl::queue q{::sycl::cpu_selector_v};
+    char* mem = ::sycl::malloc_shared<char>(size, q);
+    BOOST_REQUIRE(mem);
+    auto nodes = query_page_nodes(mem, size);
+    BOOST_REQUIRE(!nodes.empty());
+
+    // Pages are touched with a static schedule over pages, so page p
+    // must reside in the domain of the thread that the schedule assigns
+    // it to. The exact chunk boundaries depend on the OpenMP
+    // implementation and on the alignment of the allocation, so pages
+    // within num_threads pages of a thread boundary may belong to either
+    // neighbouring thread.
+    const std::size_t num_threads = omp_get_max_threads();
+    const std::size_t num_pages = nodes.size();
+    auto expected_node = [&](std::size_t page) {
+      std::size_t thread =
+          std::min(page * num_threads / num_pages, num_threads - 1);
+      return topo.get_node_id(topo.get_domain_of_thread(thread, num_threads));
+    };
+    std::size_t num_misplaced = 0;
+    for(std::size_t page = 0; page < num_pages; ++page) {
+      std::size_t begin = page > num_threads ? page - num_threads : 0;
+      std::size_t end = std::min(page + num_threads + 1, num_pages);
+      bool is_expected = false;
+      for(std::size_t p = begin; p < end && !is_expected; ++p)
+        is_expected = nodes[page] == expected_node(p);
+      if(!is_expected)
+        ++num_misplaced;
+    }
+    BOOST_CHECK_EQUAL(num_misplaced, 0);
+    ::sycl::free(mem, q);
+  }
+  set_numa_first_touch(false);
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
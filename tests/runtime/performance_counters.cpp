@@ -0,0 +1,122 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <thread>
+#include <vector>
+#include <hipSYCL/runtime/performance_counters.hpp>
+
+using namespace hipsycl;
+
+BOOST_FIXTURE_TEST_SUITE(performance_counters, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(histogram) {
+  rt::duration_histogram h;
+  BOOST_CHECK(h.get_percentile(0.99) == 0);
+
+  for(uint64_t i = 1; i <= 1000; ++i)
+    h.add(i * 1000);
+
+  BOOST_CHECK(h.get_count() == 1000);
+  BOOST_CHECK(h.get_total() == 500500 * 1000);
+  BOOST_CHECK(h.get_max() == 1000 * 1000);
+
+  uint64_t p99 = h.get_percentile(0.99);
+  BOOST_CHECK(p99 >= 990 * 1000);
+  BOOST_CHECK(p99 <= 1000 * 1000);
+  uint64_t p50 = h.get_percentile(0.5);
+  BOOST_CHECK(p50 >= 500 * 1000);
+  BOOST_CHECK(p50 <= 625 * 1000);
+}
+
+BOOST_AUTO_TEST_CASE(aggregation) {
+  rt::performance_counters disabled{false};
+  BOOST_CHECK(disabled.get_kernel_counters("k") == nullptr);
+  disabled.dag_node_built();
+  BOOST_CHECK(disabled.get_snapshot().kernels.empty());
+  BOOST_CHECK(disabled.get_snapshot().dag_nodes_built == 0);
+
+  rt::performance_counters counters{true};
+  rt::device_id host{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                            rt::api_platform::omp},
+                     0};
+  rt::device_id other{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                             rt::api_platform::omp},
+                      1};
+
+  rt::performance_counters::kernel_counters *k =
+      counters.get_kernel_counters("k");
+  BOOST_REQUIRE(k);
+  // Counters are resolved once per kernel
+  BOOST_CHECK(counters.get_kernel_counters("k") == k);
+  BOOST_CHECK(counters.get_kernel_counters("l") != k);
+
+  std::vector<std::thread> threads;
+  for(int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for(int i = 0; i < 100; ++i) {
+        k->kernel_launched();
+        k->kernel_executed(1000);
+        counters.memcpy_submitted(host, other, 10);
+        counters.dag_node_built();
+      }
+    });
+  }
+  for(auto& t : threads)
+    t.join();
+
+  counters.memcpy_submitted(other, host, 5);
+  counters.memory_allocated(other, 128);
+  counters.kernel_cache_lookup(true);
+  counters.kernel_cache_lookup(false);
+
+  rt::performance_counter_snapshot s = counters.get_snapshot();
+  BOOST_REQUIRE(s.kernels.size() == 2);
+  BOOST_CHECK(s.kernels[0].kernel_name == "k");
+  BOOST_CHECK(s.kernels[0].num_launches == 400);
+  BOOST_CHECK(s.kernels[0].num_timed_executions == 400);
+  BOOST_CHECK(s.kernels[0].mean_execution_time_ns == 1000);
+  BOOST_CHECK(s.kernels[0].max_execution_time_ns == 1000);
+
+  BOOST_REQUIRE(s.transfers.size() == 2);
+  BOOST_CHECK(s.transfers[0].source == host);
+  BOOST_CHECK(s.transfers[0].dest == other);
+  BOOST_CHECK(s.transfers[0].num_transfers == 400);
+  BOOST_CHECK(s.transfers[0].num_bytes == 4000);
+  BOOST_CHECK(s.transfers[1].num_bytes == 5);
+
+  BOOST_REQUIRE(s.allocations.size() == 1);
+  BOOST_CHECK(s.allocations[0].num_bytes == 128);
+
+  BOOST_CHECK(s.dag_nodes_built == 400);
+  BOOST_CHECK(s.kernel_cache_hits == 1);
+  BOOST_CHECK(s.kernel_cache_misses == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,191 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <filesystem>
+#include <hipSYCL/runtime/persistent_kernel_cache.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+struct temporary_cache_directory {
+  temporary_cache_directory() {
+    root = std::filesystem::temp_directory_path() /
+           ("hipsycl-jit-cache-test-" +
+            std::to_string(
+                std::chrono::steady_clock::now().time_since_epoch().count()));
+  }
+
+  ~temporary_cache_directory() {
+    std::filesystem::remove_all(root);
+  }
+
+  std::filesystem::path root;
+};
+
+// Stands in for a JIT translator: Produces a "binary" derived from
+// the key and counts how often it was invoked.
+struct stub_translator {
+  rt::result operator()(const std::string& key, std::string& out) {
+    ++num_invocations;
+    out = "binary-for-" + key;
+    return rt::make_success();
+  }
+
+  int num_invocations = 0;
+};
+
+std::string make_key(const std::string& kernel, int config) {
+  return "compiler:test\nhcf-object:42\nimage:llvm-ir.global\nbackend:0\n"
+         "kernel:" + kernel + "\nconfiguration:" + std::to_string(config);
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(persistent_kernel_cache, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(stub_translator_caching) {
+  temporary_cache_directory dir;
+  stub_translator translator;
+
+  std::string key = make_key("kernel_a", 1);
+  auto compile = [&](std::string& out){ return translator(key, out); };
+  {
+    rt::persistent_kernel_cache cache{dir.root.string(), 1024 * 1024};
+    std::string binary;
+    BOOST_CHECK(cache.get_or_compile(key, binary, compile).is_success());
+    BOOST_CHECK(binary == "binary-for-" + key);
+    BOOST_CHECK(translator.num_invocations == 1);
+  }
+  {
+    // A new cache object emulates a subsequent application run
+    rt::persistent_kernel_cache cache{dir.root.string(), 1024 * 1024};
+    std::string binary;
+    BOOST_CHECK(cache.get_or_compile(key, binary, compile).is_success());
+    BOOST_CHECK(binary == "binary-for-" + key);
+    BOOST_CHECK(translator.num_invocations == 1);
+
+    // Different kernel configuration must not hit the cache
+    std::string other_key = make_key("kernel_a", 2);
+    BOOST_CHECK(cache.get_or_compile(other_key, binary, [&](std::string &out) {
+                       return translator(other_key, out);
+                     }).is_success());
+    BOOST_CHECK(binary == "binary-for-" + other_key);
+    BOOST_CHECK(translator.num_invocations == 2);
+  }
+  // Only complete entries, no temporary files should remain
+  for(const auto& entry : std::filesystem::directory_iterator{dir.root})
+    BOOST_CHECK(entry.path().extension() == ".jit");
+}
+
+BOOST_AUTO_TEST_CASE(failed_compilation_is_not_cached) {
+  temporary_cache_directory dir;
+  rt::persistent_kernel_cache cache{dir.root.string(), 1024 * 1024};
+
+  std::string binary;
+  auto res = cache.get_or_compile(make_key("kernel_a", 1), binary,
+                                  [](std::string &out) {
+                                    return rt::make_error(
+                                        __hipsycl_here(),
+                                        rt::error_info{"stub failure"});
+                                  });
+  BOOST_CHECK(!res.is_success());
+  BOOST_CHECK(!cache.load(make_key("kernel_a", 1), binary));
+}
+
+BOOST_AUTO_TEST_CASE(lru_eviction) {
+  temporary_cache_directory dir;
+  const std::string payload(1000, 'x');
+  
+  // Room for two entries, but not for three
+  rt::persistent_kernel_cache cache{dir.root.string(), 2500};
+
+  std::string out;
+  auto wait = [](){
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  };
+  BOOST_CHECK(cache.store(make_key("a", 0), payload));
+  wait();
+  BOOST_CHECK(cache.store(make_key("b", 0), payload));
+  wait();
+  // Use a, so that b becomes least recently used
+  BOOST_CHECK(cache.load(make_key("a", 0), out));
+  BOOST_CHECK(out == payload);
+  wait();
+  BOOST_CHECK(cache.store(make_key("c", 0), payload));
+
+  BOOST_CHECK(cache.get_current_size() <= 2500);
+  BOOST_CHECK(cache.load(make_key("a", 0), out));
+  BOOST_CHECK(!cache.load(make_key("b", 0), out));
+  BOOST_CHECK(cache.load(make_key("c", 0), out));
+}
+
+BOOST_AUTO_TEST_CASE(truncated_entry) {
+  temporary_cache_directory dir;
+  rt::persistent_kernel_cache cache{dir.root.string(), 1024 * 1024};
+  const std::string key = make_key("a", 0);
+  BOOST_CHECK(cache.store(key, "payload"));
+
+  // An entry whose first string size exceeds the file must be rejected
+  // instead of allocating that size.
+  {
+    std::ofstream file{
+        dir.root / rt::persistent_kernel_cache::get_entry_filename(key),
+        std::ios::binary | std::ios::trunc};
+    const std::uint64_t size = UINT64_MAX / 2;
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  }
+  std::string out;
+  BOOST_CHECK(!cache.load(key, out));
+}
+
+BOOST_AUTO_TEST_CASE(disabled_cache) {
+  rt::persistent_kernel_cache cache{"", 1024};
+  stub_translator translator;
+  BOOST_CHECK(!cache.is_enabled());
+
+  std::string binary;
+  for(int i = 0; i < 2; ++i) {
+    BOOST_CHECK(cache
+                    .get_or_compile("key", binary,
+                                    [&](std::string &out) {
+                                      return translator("key", out);
+                                    })
+                    .is_success());
+  }
+  BOOST_CHECK(translator.num_invocations == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,189 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sycl/sycl.hpp>
+#include <hipSYCL/runtime/generic/async_worker.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(queue_priority, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(arbiter_ordering) {
+  hipsycl::rt::priority_arbiter arbiter{std::chrono::hours{1}};
+  arbiter.register_prioritized_queue();
+
+  std::mutex order_lock;
+  std::vector<int> order;
+  auto run = [&](int priority) {
+    auto guard = arbiter.acquire(priority);
+    std::lock_guard<std::mutex> lock{order_lock};
+    order.push_back(priority);
+  };
+
+  std::thread low, high;
+  {
+    auto running = arbiter.acquire(0);
+    low = std::thread{run, 2};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    high = std::thread{run, 1};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    // Both have to wait for the running work of higher priority
+    std::lock_guard<std::mutex> lock{order_lock};
+    BOOST_CHECK(order.empty());
+  }
+  low.join();
+  high.join();
+
+  BOOST_REQUIRE(order.size() == 2);
+  // Despite being submitted later, the higher priority work runs first
+  BOOST_CHECK(order[0] == 1);
+  BOOST_CHECK(order[1] == 2);
+}
+
+BOOST_AUTO_TEST_CASE(arbiter_aging) {
+  hipsycl::rt::priority_arbiter arbiter{std::chrono::milliseconds{5}};
+  arbiter.register_prioritized_queue();
+
+  auto running = arbiter.acquire(0);
+  std::atomic<bool> has_started = false;
+  std::thread low{[&]() {
+    auto guard = arbiter.acquire(3);
+    has_started = true;
+  }};
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+  while(!has_started && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  // Low-priority work must not starve while high-priority work is running
+  BOOST_CHECK(has_started);
+  low.join();
+}
+
+BOOST_AUTO_TEST_CASE(arbiter_bypass_without_prioritized_queues) {
+  hipsycl::rt::priority_arbiter arbiter{std::chrono::hours{1}};
+
+  std::atomic<bool> has_started = false;
+  {
+    auto running = arbiter.acquire(0);
+    // Without prioritized queues, nothing is arbitrated, so this
+    // would block for an hour otherwise.
+    std::thread low{[&]() {
+      auto guard = arbiter.acquire(1);
+      has_started = true;
+    }};
+    low.join();
+  }
+  BOOST_CHECK(has_started);
+
+  arbiter.register_prioritized_queue();
+  has_started = false;
+  std::thread low;
+  {
+    auto running = arbiter.acquire(0);
+    low = std::thread{[&]() {
+      auto guard = arbiter.acquire(1);
+      has_started = true;
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    BOOST_CHECK(!has_started);
+  }
+  low.join();
+  BOOST_CHECK(has_started);
+  arbiter.unregister_prioritized_queue();
+}
+
+BOOST_AUTO_TEST_CASE(high_priority_kernel_latency) {
+  constexpr int num_low_priority_kernels = 1000;
+  constexpr std::size_t problem_size = 4096;
+
+  sycl::queue low_priority_queue{sycl::property_list{
+      sycl::property::queue::in_order{},
+      sycl::property::queue::hipSYCL_priority{0}}};
+  sycl::queue high_priority_queue{sycl::property_list{
+      sycl::property::queue::in_order{},
+      sycl::property::queue::hipSYCL_priority{-1}}};
+
+  float* low_data = sycl::malloc_device<float>(problem_size, low_priority_queue);
+  float* high_data =
+      sycl::malloc_device<float>(problem_size, high_priority_queue);
+
+  auto work = [](float* data) {
+    return [=](sycl::id<1> idx) {
+      float x = static_cast<float>(idx[0]);
+      for(int i = 0; i < 50; ++i)
+        x = x * 1.0001f + 1.0f;
+      data[idx[0]] = x;
+    };
+  };
+  // Warm-up
+  low_priority_queue.parallel_for(sycl::range{problem_size}, work(low_data));
+  high_priority_queue.parallel_for(sycl::range{problem_size}, work(high_data));
+  low_priority_queue.wait();
+  high_priority_queue.wait();
+
+  auto bulk_start = std::chrono::steady_clock::now();
+  sycl::event last_low_priority_kernel;
+  for(int i = 0; i < num_low_priority_kernels; ++i)
+    last_low_priority_kernel = low_priority_queue.parallel_for(
+        sycl::range{problem_size}, work(low_data));
+
+  auto start = std::chrono::steady_clock::now();
+  high_priority_queue.parallel_for(sycl::range{problem_size}, work(high_data))
+      .wait();
+  auto stop = std::chrono::steady_clock::now();
+  // The high-priority kernel must not wait for the bulk work to drain.
+  // Checking completion order instead of latency keeps this independent
+  // of machine speed and load.
+  bool bulk_work_pending =
+      last_low_priority_kernel
+          .get_info<sycl::info::event::command_execution_status>() !=
+      sycl::info::event_command_status::complete;
+
+  low_priority_queue.wait();
+  auto bulk_stop = std::chrono::steady_clock::now();
+
+  double latency_us =
+      std::chrono::duration<double, std::micro>(stop - start).count();
+  double bulk_us =
+      std::chrono::duration<double, std::micro>(bulk_stop - bulk_start).count();
+  BOOST_TEST_MESSAGE("high-priority kernel latency behind "
+                     << num_low_priority_kernels
+                     << " low-priority kernels: " << latency_us
+                     << " us; low-priority bulk work: " << bulk_us << " us");
+  BOOST_CHECK(bulk_work_pending);
+
+  sycl::free(low_data, low_priority_queue);
+  sycl::free(high_data, high_priority_queue);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
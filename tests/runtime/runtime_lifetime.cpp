@@ -0,0 +1,88 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <chrono>
+#include <thread>
+#include <hipSYCL/runtime/application.hpp>
+#include <hipSYCL/runtime/runtime.hpp>
+
+using namespace hipsycl;
+
+BOOST_FIXTURE_TEST_SUITE(runtime_lifetime, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(idle_timeout) {
+  rt::runtime_lifetime_manager manager{std::chrono::milliseconds{200}};
+  BOOST_CHECK(!manager.is_runtime_alive());
+
+  rt::runtime* first = nullptr;
+  {
+    std::shared_ptr<rt::runtime> a = manager.get_runtime_pointer();
+    std::shared_ptr<rt::runtime> b = manager.get_runtime_pointer();
+    BOOST_CHECK(a.get() == b.get());
+    first = a.get();
+  }
+  // The runtime survives its last user...
+  BOOST_CHECK(manager.is_runtime_alive());
+  BOOST_CHECK_EQUAL(manager.get_num_runtime_launches(), 1);
+
+  // ... and is reused if it is requested again within the timeout.
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+  {
+    std::shared_ptr<rt::runtime> c = manager.get_runtime_pointer();
+    BOOST_CHECK(c.get() == first);
+    // The timeout does not apply while the runtime is in use
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+    BOOST_CHECK(manager.is_runtime_alive());
+  }
+  BOOST_CHECK_EQUAL(manager.get_num_runtime_launches(), 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{600});
+  BOOST_CHECK(!manager.is_runtime_alive());
+
+  {
+    std::shared_ptr<rt::runtime> d = manager.get_runtime_pointer();
+    BOOST_CHECK(manager.is_runtime_alive());
+  }
+  BOOST_CHECK_EQUAL(manager.get_num_runtime_launches(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(shutdown_releases_idle_runtime) {
+  rt::runtime_lifetime_manager manager{std::chrono::seconds{60}};
+  std::shared_ptr<rt::runtime> rt_ptr = manager.get_runtime_pointer();
+
+  manager.shutdown();
+  // Still in use, so the runtime must stay alive
+  BOOST_CHECK(manager.is_runtime_alive());
+
+  rt_ptr.reset();
+  BOOST_CHECK(!manager.is_runtime_alive());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,262 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <sycl/sycl.hpp>
+
+namespace {
+
+bool depends_on(const hipsycl::rt::dag_node_ptr &node,
+                const hipsycl::rt::dag_node_ptr &other) {
+  for(const auto &weak_req : node->get_requirements()) {
+    if(auto req = weak_req.lock()) {
+      if(req == other || depends_on(req, other))
+        return true;
+    }
+  }
+  return false;
+}
+
+hipsycl::rt::dag_node_ptr find_user(hipsycl::rt::buffer_data_region &region,
+                                    std::size_t offset) {
+  hipsycl::rt::dag_node_ptr result;
+  region.get_users().for_each_user([&](const hipsycl::rt::data_user &user) {
+    if(user.offset[2] == offset)
+      if(auto node = user.user.lock())
+        result = node;
+  });
+  return result;
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(sub_buffer, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(sub_buffer_aliases_parent) {
+  sycl::queue q;
+  std::vector<int> data(8 * 16, 0);
+  {
+    sycl::buffer<int, 2> parent{data.data(), sycl::range{8, 16}};
+    sycl::buffer<int, 2> rows{parent, sycl::id{2, 0}, sycl::range{3, 16}};
+    BOOST_CHECK(rows.is_sub_buffer());
+    BOOST_CHECK(!parent.is_sub_buffer());
+    BOOST_CHECK(rows.get_range() == sycl::range(3, 16));
+    BOOST_CHECK(hipsycl::sycl::detail::extract_buffer_data_region(rows) ==
+                hipsycl::sycl::detail::extract_buffer_data_region(parent));
+
+    BOOST_CHECK_THROW((sycl::buffer<int, 2>{parent, sycl::id{0, 0},
+                                            sycl::range{2, 4}}),
+                      sycl::invalid_object_error);
+    BOOST_CHECK_THROW((sycl::buffer<int, 2>{parent, sycl::id{6, 0},
+                                            sycl::range{3, 16}}),
+                      sycl::invalid_object_error);
+
+    q.submit([&](sycl::handler &cgh) {
+      sycl::accessor acc{rows, cgh, sycl::write_only};
+      cgh.parallel_for(sycl::range{3, 16}, [=](sycl::id<2> idx) {
+        acc[idx] = 100 + static_cast<int>(idx[0] * 16 + idx[1]);
+      });
+    });
+    {
+      sycl::host_accessor acc{parent, sycl::read_only};
+      for(std::size_t i = 0; i < 8; ++i)
+        for(std::size_t j = 0; j < 16; ++j) {
+          int expected = (i >= 2 && i < 5) ? 100 + (i - 2) * 16 + j : 0;
+          BOOST_CHECK(acc[i][j] == expected);
+        }
+    }
+    // A single element within a row is contiguous as well and may be
+    // nested into an existing sub-buffer.
+    sycl::buffer<int, 2> element{rows, sycl::id{1, 3}, sycl::range{1, 1}};
+    {
+      sycl::host_accessor acc{element};
+      BOOST_CHECK(acc[0][0] == 100 + 16 + 3);
+      acc[0][0] = -1;
+    }
+  }
+  BOOST_CHECK(data[3 * 16 + 3] == -1);
+  BOOST_CHECK(data[3 * 16 + 4] == 100 + 16 + 4);
+}
+
+BOOST_AUTO_TEST_CASE(disjoint_sub_buffers_are_independent) {
+  constexpr std::size_t size = 1024;
+  sycl::queue q;
+  // Uses the default page size, i.e. a single page for the whole buffer
+  sycl::buffer<int> parent{sycl::range{size}};
+  sycl::buffer<int> lower{parent, sycl::id{0}, sycl::range{size / 2}};
+  sycl::buffer<int> upper{parent, sycl::id{size / 2}, sycl::range{size / 2}};
+  auto region = hipsycl::sycl::detail::extract_buffer_data_region(parent);
+
+  std::atomic<bool> release{false};
+  q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{lower, cgh, sycl::write_only, sycl::no_init};
+    std::atomic<bool> *release_flag = &release;
+    cgh.single_task([=]() {
+      while(!release_flag->load())
+        std::this_thread::yield();
+      for(std::size_t i = 0; i < size / 2; ++i)
+        acc[i] = 1;
+    });
+  });
+  q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{upper, cgh, sycl::write_only, sycl::no_init};
+    cgh.parallel_for(sycl::range{size / 2},
+                     [=](sycl::id<1> idx) { acc[idx] = 2; });
+  });
+
+  auto lower_user = find_user(*region, 0);
+  auto upper_user = find_user(*region, size / 2);
+  BOOST_CHECK(lower_user && upper_user);
+  if(lower_user && upper_user)
+    BOOST_CHECK(!depends_on(upper_user, lower_user));
+
+  // Writing to the parent overlaps with both sub-buffers
+  q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{parent, cgh, sycl::read_write};
+    cgh.parallel_for(sycl::range{size}, [=](sycl::id<1> idx) { acc[idx] += 10; });
+  });
+  auto parent_user = find_user(*region, 0);
+  release = true;
+
+  BOOST_CHECK(parent_user && parent_user != lower_user);
+  if(parent_user && lower_user && upper_user) {
+    BOOST_CHECK(depends_on(parent_user, lower_user));
+    BOOST_CHECK(depends_on(parent_user, upper_user));
+  }
+  lower_user = nullptr;
+  upper_user = nullptr;
+  parent_user = nullptr;
+
+  sycl::host_accessor acc{parent, sycl::read_only};
+  for(std::size_t i = 0; i < size; ++i)
+    BOOST_CHECK(acc[i] == (i < size / 2 ? 11 : 12));
+}
+
+BOOST_AUTO_TEST_CASE(halo_exchange_benchmark) {
+  constexpr std::size_t size = 1 << 20;
+  constexpr std::size_t num_chunks = 4;
+  constexpr std::size_t chunk_size = size / num_chunks;
+  // Even, so that the final result ends up in the first buffer
+  constexpr int num_iterations = 20;
+
+  std::vector<int> initial(size);
+  for(std::size_t i = 0; i < size; ++i)
+    initial[i] = static_cast<int>(i % 17);
+
+  std::vector<int> reference = initial;
+  {
+    std::vector<int> tmp(size);
+    for(int it = 0; it < num_iterations; ++it) {
+      for(std::size_t i = 0; i < size; ++i) {
+        int l = reference[i > 0 ? i - 1 : i];
+        int r = reference[i + 1 < size ? i + 1 : i];
+        tmp[i] = (l + reference[i] + r) % 1000;
+      }
+      std::swap(tmp, reference);
+    }
+  }
+
+  // Each chunk reads its own part of the domain plus one halo element
+  // on each side, and writes only its own part.
+  auto run = [&](bool use_sub_buffers) -> double {
+    sycl::queue q;
+    sycl::property_list props;
+    if(use_sub_buffers)
+      props = sycl::property_list{sycl::property::buffer::hipSYCL_page_size<1>{
+          sycl::range{chunk_size}}};
+    std::vector<int> result(size);
+    double ms = 0.0;
+    {
+      // Use a const pointer so that the buffer does not operate
+      // directly on the initial data, which is reused by the next run.
+      const int *initial_data = initial.data();
+      sycl::buffer<int> a{initial_data, sycl::range{size}, props};
+      sycl::buffer<int> b{sycl::range{size}, props};
+      b.set_write_back(false);
+      a.set_final_data(result.data());
+
+      auto start = std::chrono::steady_clock::now();
+      for(int it = 0; it < num_iterations; ++it) {
+        sycl::buffer<int> &in = (it % 2 == 0) ? a : b;
+        sycl::buffer<int> &out = (it % 2 == 0) ? b : a;
+        for(std::size_t c = 0; c < num_chunks; ++c) {
+          std::size_t begin = c * chunk_size;
+          std::size_t halo_begin = begin > 0 ? begin - 1 : begin;
+          std::size_t halo_end = std::min(size, begin + chunk_size + 1);
+
+          q.submit([&](sycl::handler &cgh) {
+            if(use_sub_buffers) {
+              sycl::buffer<int> in_view{in, sycl::id{halo_begin},
+                                        sycl::range{halo_end - halo_begin}};
+              sycl::buffer<int> out_view{out, sycl::id{begin},
+                                         sycl::range{chunk_size}};
+              sycl::accessor src{in_view, cgh, sycl::read_only};
+              sycl::accessor dst{out_view, cgh, sycl::write_only, sycl::no_init};
+              std::size_t last = halo_end - halo_begin - 1;
+              std::size_t shift = begin - halo_begin;
+              cgh.parallel_for(sycl::range{chunk_size}, [=](sycl::id<1> idx) {
+                std::size_t i = idx[0] + shift;
+                int l = src[i > 0 ? i - 1 : i];
+                int r = src[i < last ? i + 1 : i];
+                dst[idx] = (l + src[i] + r) % 1000;
+              });
+            } else {
+              sycl::accessor src{in, cgh, sycl::read_only};
+              sycl::accessor dst{out, cgh, sycl::read_write};
+              cgh.parallel_for(sycl::range{chunk_size}, [=](sycl::id<1> idx) {
+                std::size_t i = idx[0] + begin;
+                int l = src[i > 0 ? i - 1 : i];
+                int r = src[i + 1 < size ? i + 1 : i];
+                dst[i] = (l + src[i] + r) % 1000;
+              });
+            }
+          });
+        }
+      }
+      q.wait();
+      auto stop = std::chrono::steady_clock::now();
+      ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+    BOOST_CHECK(result == reference);
+    return ms;
+  };
+
+  double whole_buffer_ms = run(false);
+  double sub_buffer_ms = run(true);
+  BOOST_TEST_MESSAGE("halo exchange, " << num_chunks << " chunks x "
+                     << num_iterations << " iterations: whole-buffer accessors "
+                     << whole_buffer_ms << " ms, sub-buffers " << sub_buffer_ms
+                     << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2023 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <hipSYCL/runtime/tracer.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+std::size_t count_occurrences(const std::string& str, const std::string& s) {
+  std::size_t count = 0;
+  for(std::size_t pos = str.find(s); pos != std::string::npos;
+      pos = str.find(s, pos + s.size()))
+    ++count;
+  return count;
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(tracer, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(chrome_trace_output) {
+  rt::tracer disabled{""};
+  BOOST_CHECK(!disabled.is_enabled());
+
+  rt::tracer t{"unused.json"};
+  BOOST_CHECK(t.is_enabled());
+
+  uint64_t begin = t.now();
+  t.record("test", "main_event", begin, begin + 1500, 42);
+  std::thread worker{[&]() { t.record_instant("test", "worker_event"); }};
+  worker.join();
+
+  std::stringstream sstr;
+  t.write(sstr);
+  std::string trace = sstr.str();
+
+  BOOST_CHECK(!t.is_enabled());
+  BOOST_CHECK(trace.find("\"traceEvents\":[") != std::string::npos);
+  BOOST_CHECK(trace.find("\"name\":\"main_event\",\"cat\":\"test\","
+                         "\"ph\":\"X\",\"dur\":1.500") != std::string::npos);
+  BOOST_CHECK(trace.find("\"arg\":42") != std::string::npos);
+  BOOST_CHECK(trace.find("\"name\":\"worker_event\",\"cat\":\"test\","
+                         "\"ph\":\"i\"") != std::string::npos);
+  BOOST_CHECK(count_occurrences(trace, "\"thread_name\"") == 2);
+
+  // Recording is disabled after writing the trace
+  t.record_instant("test", "late_event");
+  std::stringstream second;
+  t.write(second);
+  BOOST_CHECK(second.str().find("late_event") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(ring_buffer_overflow) {
+  rt::tracer t{"unused.json"};
+  t.record_instant("test", "first_event");
+  for(std::size_t i = 0; i < rt::trace_buffer::capacity; ++i)
+    t.record_instant("test", "event");
+
+  std::stringstream sstr;
+  t.write(sstr);
+  std::string trace = sstr.str();
+
+  BOOST_CHECK(trace.find("first_event") == std::string::npos);
+  BOOST_CHECK(count_occurrences(trace, "\"name\":\"event\"") ==
+              rt::trace_buffer::capacity);
+}
+
+BOOST_AUTO_TEST_SUITE_END()